@@ -0,0 +1,24 @@
+#include "Benchmark.h"
+
+std::vector<BenchmarkCase>& benchmarkRegistry() {
+    static std::vector<BenchmarkCase> registry;
+    return registry;
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char* name, std::function<void(std::size_t)> body) {
+    benchmarkRegistry().push_back({name, body});
+}
+
+static std::size_t processedItems = 0;
+
+void setItemsProcessed(std::size_t items) {
+    processedItems = items;
+}
+
+std::size_t itemsProcessed() {
+    return processedItems;
+}
+
+void resetItemsProcessed() {
+    processedItems = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal benchmark registry
+ * 
+ * Each benchmark body receives an iteration count and must run the measured
+ * operation exactly that many times. The runner grows the count until a run
+ * takes long enough to time reliably, then reports nanoseconds per iteration.
+ * A body whose iteration covers many units of work (e.g. a tournament of
+ * thousands of battles) reports their total with setItemsProcessed(), and
+ * the runner adds a per-second rate of those items.
+ * 
+ * Usage:
+ *   POKEMON_BENCHMARK(BM_Something) {
+ *       for (std::size_t i = 0; i < iterations; ++i) { ... }
+ *   }
+ */
+struct BenchmarkCase {
+    std::string name;                               // Reported benchmark name
+    std::function<void(std::size_t)> body;          // Runs N iterations
+};
+
+/**
+ * Access the global list of registered benchmarks
+ */
+std::vector<BenchmarkCase>& benchmarkRegistry();
+
+/**
+ * Registers a benchmark during static initialization
+ */
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const char* name, std::function<void(std::size_t)> body);
+};
+
+/**
+ * Items processed by the current run of a benchmark body (all iterations),
+ * like Google Benchmark's State::SetItemsProcessed()
+ */
+void setItemsProcessed(std::size_t items);
+
+/**
+ * Items reported by the last run (0 if the body reported none)
+ */
+std::size_t itemsProcessed();
+
+/**
+ * Forget the items of the previous run
+ */
+void resetItemsProcessed();
+
+/**
+ * Prevent the compiler from optimizing away a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#define POKEMON_BENCHMARK(name)                                             \
+    static void name(std::size_t iterations);                               \
+    static BenchmarkRegistrar name##_registrar(#name, name);                \
+    static void name(std::size_t iterations)
+
+#endif // BENCHMARK_H
@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "Battle.h"
+#include "BattleArena.h"
+#include "ExpectimaxPolicy.h"
+#include "Move.h"
+
+namespace {
+
+// Pikachu vs Squirtle with built-in moves, as in bench_battle.cpp
+void makeContestants(BattleArena& arena) {
+    Pokemon pikachu("Pikachu", "Electric", 100, 55, 40, 50, 90);
+    pikachu.addMove(Move("Thunder Shock", "", 40, 100, "Electric", MoveCategory::SPECIAL));
+    pikachu.addMove(Move("Quick Attack", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+    pikachu.addMove(Move("Thunder Wave", "", 0, 90, "Electric", MoveCategory::STATUS, "Paralyzed", 4));
+    arena.add(pikachu);
+
+    Pokemon squirtle("Squirtle", "Water", 120, 48, 65, 64, 43);
+    squirtle.addMove(Move("Bubble", "", 40, 100, "Water", MoveCategory::SPECIAL));
+    squirtle.addMove(Move("Tackle", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+    arena.add(squirtle);
+}
+
+} // namespace
+
+// First decision of a battle with an empty transposition table (4 plies)
+POKEMON_BENCHMARK(BM_ExpectimaxDecisionCold) {
+    BattleArena arena(2);
+    makeContestants(arena);
+    ExpectimaxPolicy ai;
+    BattleRng rng(1);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        ai.clear();
+        doNotOptimize(ai.chooseMove(arena.get(0), arena.get(1), true, rng));
+    }
+}
+
+// The same decision answered from the table filled by the previous one
+POKEMON_BENCHMARK(BM_ExpectimaxDecisionWarm) {
+    BattleArena arena(2);
+    makeContestants(arena);
+    ExpectimaxPolicy ai;
+    BattleRng rng(1);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        doNotOptimize(ai.chooseMove(arena.get(0), arena.get(1), true, rng));
+    }
+}
+
+// Whole battles, Pikachu searching against a random Squirtle, with the
+// table kept from battle to battle as BattleSimulator does
+POKEMON_BENCHMARK(BM_BattleExpectimax) {
+    BattleArena arena(2);
+    makeContestants(arena);
+    ExpectimaxPolicy ai;
+    NullEventSink events;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        arena.restore();
+        Battle battle(arena.get(0), arena.get(1), i, events);
+        battle.setPolicies(&ai, nullptr);
+        doNotOptimize(battle.start());
+    }
+}
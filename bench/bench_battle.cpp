@@ -0,0 +1,153 @@
+#include "Benchmark.h"
+#include "Battle.h"
+#include "BattleArena.h"
+#include "BattleBatch.h"
+#include "Move.h"
+#include "TeamBattle.h"
+#include "TextEventSink.h"
+#include <algorithm>
+#include <memory>
+#include <ostream>
+
+namespace {
+
+// Pikachu vs Squirtle with native moves only, so the battle loop is measured
+void makeContestants(std::shared_ptr<Pokemon>& pikachu, std::shared_ptr<Pokemon>& squirtle) {
+    pikachu = std::make_shared<Pokemon>("Pikachu", "Electric", 100, 55, 40, 50, 90);
+    pikachu->addMove(Move("Thunder Shock", "", 40, 100, "Electric", MoveCategory::SPECIAL));
+    pikachu->addMove(Move("Quick Attack", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+    pikachu->addMove(Move("Thunder Wave", "", 0, 90, "Electric", MoveCategory::STATUS, "Paralyzed", 4));
+    
+    squirtle = std::make_shared<Pokemon>("Squirtle", "Water", 120, 48, 65, 64, 43);
+    squirtle->addMove(Move("Bubble", "", 40, 100, "Water", MoveCategory::SPECIAL));
+    squirtle->addMove(Move("Tackle", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+}
+
+} // namespace
+
+// Whole battle with events discarded, as in simulations
+POKEMON_BENCHMARK(BM_BattleNullSink) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    NullEventSink events;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto p1 = std::make_shared<Pokemon>(*pikachu);
+        auto p2 = std::make_shared<Pokemon>(*squirtle);
+        Battle battle(p1, p2, i, events);
+        doNotOptimize(battle.start());
+    }
+}
+
+// The same battles on a BattleArena: both Pokemon are reset in place
+// instead of copied, so nothing is allocated per battle
+POKEMON_BENCHMARK(BM_BattleArena) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    BattleArena arena(2);
+    Pokemon& p1 = arena.add(*pikachu);
+    Pokemon& p2 = arena.add(*squirtle);
+    NullEventSink events;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        arena.restore();
+        Battle battle(p1, p2, i, events);
+        doNotOptimize(battle.start());
+    }
+}
+
+// BM_BattleArena counted in turns, the unit BM_TeamBattle reports
+POKEMON_BENCHMARK(BM_BattleArenaTurns) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    BattleArena arena(2);
+    Pokemon& p1 = arena.add(*pikachu);
+    Pokemon& p2 = arena.add(*squirtle);
+    NullEventSink events;
+    std::size_t turns = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        arena.restore();
+        Battle battle(p1, p2, i, events);
+        doNotOptimize(battle.start());
+        turns += battle.getTurnCount();
+    }
+    setItemsProcessed(turns);
+}
+
+// 2v2 team battles of the same Pokemon on a BattleArena, switching 10% of
+// the time; items are turns, so Items/s compares directly with 1v1
+POKEMON_BENCHMARK(BM_TeamBattle) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    BattleArena arena(4);
+    Team red, blue;
+    red.add(arena.add(*pikachu));
+    red.add(arena.add(*squirtle));
+    blue.add(arena.add(*squirtle));
+    blue.add(arena.add(*pikachu));
+    NullEventSink events;
+    std::size_t turns = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        arena.restore();
+        TeamBattle battle(red, blue, i, events);
+        battle.setSwitchChance(10);
+        doNotOptimize(battle.start());
+        turns += battle.getTurnCount();
+    }
+    setItemsProcessed(turns);
+}
+
+// One action through Battle::executeTurn(): move dispatch, damage and
+// status, with events discarded. The defender is healed whenever it faints.
+POKEMON_BENCHMARK(BM_ExecuteTurn) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    NullEventSink events;
+    Battle battle(pikachu, squirtle, 42, events);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        battle.executeTurn(*squirtle, *pikachu, static_cast<int>(i & 1));
+        if (pikachu->isFainted()) pikachu->heal(pikachu->getMaxHP());
+    }
+    doNotOptimize(pikachu->getCurrentHP());
+}
+
+// One end-of-turn Pokemon::updateStatus(): poison damage and the duration
+// countdown. Poison is reapplied when it wears off and HP restored when it
+// runs out, so every call ticks.
+POKEMON_BENCHMARK(BM_UpdateStatus) {
+    Pokemon bulbasaur("Bulbasaur", "Grass", 115, 49, 49, 65, 45);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        if (!bulbasaur.hasStatusEffect()) bulbasaur.applyStatusEffect(StatusEffect::POISONED, 5);
+        if (bulbasaur.isFainted()) bulbasaur.heal(bulbasaur.getMaxHP());
+        doNotOptimize(bulbasaur.updateStatus().damage);
+    }
+}
+
+// Whole battle rendered as text into a stream without a buffer
+POKEMON_BENCHMARK(BM_BattleTextSink) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    std::ostream discard(nullptr);
+    TextEventSink events(discard);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto p1 = std::make_shared<Pokemon>(*pikachu);
+        auto p2 = std::make_shared<Pokemon>(*squirtle);
+        Battle battle(p1, p2, i, events);
+        doNotOptimize(battle.start());
+    }
+}
+
+// The same battles played in lockstep by a BattleBatch, 4096 at a time
+POKEMON_BENCHMARK(BM_BattleBatch) {
+    std::shared_ptr<Pokemon> pikachu, squirtle;
+    makeContestants(pikachu, squirtle);
+    BattleBatch batch;
+    batch.reserve(4096);
+    for (std::size_t first = 0; first < iterations; first += 4096) {
+        std::size_t count = std::min<std::size_t>(4096, iterations - first);
+        batch.clear();
+        for (std::size_t i = first; i < first + count; ++i) {
+            batch.add(*pikachu, *squirtle, i);
+        }
+        batch.run();
+        doNotOptimize(batch.getWinner(count - 1));
+    }
+}
@@ -0,0 +1,92 @@
+#include "Benchmark.h"
+#include "BattleEvent.h"
+#include "BattleRng.h"
+#include "DamageKernel.h"
+#include "Move.h"
+#include "Pokemon.h"
+#include "TypeEffectiveness.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+const std::size_t kHits = 4096;
+
+// Random but fixed hits: stats, moves, accuracy rolls and type matchups
+struct Hits {
+    std::vector<int32_t> attack, defense, power, accuracy, rolls, damage;
+    std::vector<uint8_t> attackTypes, defenseTypes;
+    std::vector<double> effectiveness;
+
+    Hits() {
+        const int32_t powers[] = {0, 40, 60, 90, 120};
+        BattleRng rng(2024);
+        for (std::size_t i = 0; i < kHits; ++i) {
+            attack.push_back(20 + rng.nextInt(131));
+            defense.push_back(20 + rng.nextInt(131));
+            power.push_back(powers[rng.nextInt(5)]);
+            accuracy.push_back(70 + rng.nextInt(31));
+            rolls.push_back(rng.nextInt(100));
+            attackTypes.push_back(static_cast<uint8_t>(rng.nextInt(TypeEffectiveness::kTypeCount)));
+            defenseTypes.push_back(static_cast<uint8_t>(rng.nextInt(TypeEffectiveness::kTypeCount)));
+        }
+        effectiveness.resize(kHits);
+        damage.resize(kHits);
+        DamageKernel::lookupEffectiveness(kHits, attackTypes.data(), defenseTypes.data(), effectiveness.data());
+    }
+};
+
+const Hits& hits() {
+    static const Hits instance;
+    return instance;
+}
+
+// One iteration = one hit (hits/s = 1e9 / ns per op)
+void runDamageKernel(std::size_t iterations, DamageKernel::Isa isa) {
+    if (!DamageKernel::isSupported(isa)) return;
+    Hits h = hits();
+    DamageKernel::setIsa(isa);
+    for (std::size_t done = 0; done < iterations; done += kHits) {
+        std::size_t count = std::min(kHits, iterations - done);
+        DamageKernel::computeDamage(count, h.attack.data(), h.defense.data(), h.power.data(), h.accuracy.data(),
+                                    h.rolls.data(), h.effectiveness.data(), h.damage.data());
+        doNotOptimize(h.damage[count - 1]);
+    }
+    DamageKernel::setIsa(DamageKernel::getBestIsa());
+}
+
+void runEffectivenessLookup(std::size_t iterations, DamageKernel::Isa isa) {
+    if (!DamageKernel::isSupported(isa)) return;
+    Hits h = hits();
+    DamageKernel::setIsa(isa);
+    for (std::size_t done = 0; done < iterations; done += kHits) {
+        std::size_t count = std::min(kHits, iterations - done);
+        DamageKernel::lookupEffectiveness(count, h.attackTypes.data(), h.defenseTypes.data(), h.effectiveness.data());
+        doNotOptimize(h.effectiveness[count - 1]);
+    }
+    DamageKernel::setIsa(DamageKernel::getBestIsa());
+}
+
+} // namespace
+
+// Baseline: the same hit through Move::execute(), one at a time
+POKEMON_BENCHMARK(BM_DamageMoveExecute) {
+    Pokemon attacker("Pikachu", "Electric", 100, 55, 40, 50, 90);
+    Move move("Thunder Shock", "", 40, 100, "Electric", MoveCategory::SPECIAL);
+    Pokemon defender("Squirtle", "Water", 120, 48, 65, 64, 43);
+    BattleRng rng(1);
+    NullEventSink events;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        doNotOptimize(move.execute(attacker, defender, rng, events));
+    }
+}
+
+// Hits per second of each damage kernel implementation (skipped, at ~0 ns,
+// when the CPU lacks the instruction set)
+POKEMON_BENCHMARK(BM_DamageKernel_Scalar) { runDamageKernel(iterations, DamageKernel::Isa::SCALAR); }
+POKEMON_BENCHMARK(BM_DamageKernel_SSE2) { runDamageKernel(iterations, DamageKernel::Isa::SSE2); }
+POKEMON_BENCHMARK(BM_DamageKernel_AVX2) { runDamageKernel(iterations, DamageKernel::Isa::AVX2); }
+
+POKEMON_BENCHMARK(BM_EffectivenessLookup_Scalar) { runEffectivenessLookup(iterations, DamageKernel::Isa::SCALAR); }
+POKEMON_BENCHMARK(BM_EffectivenessLookup_AVX2) { runEffectivenessLookup(iterations, DamageKernel::Isa::AVX2); }
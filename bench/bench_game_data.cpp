@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "GameData.h"
+#include "TypeEffectiveness.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+const char* kSpeciesPath = "/tmp/pokemon_bench_species.csv";
+const char* kMovesPath = "/tmp/pokemon_bench_moves.csv";
+const char* kCachePath = "/tmp/pokemon_bench_gamedata.cache";
+
+// A 500-species, 300-move database, written once
+void writeDataFiles() {
+    static bool written = false;
+    if (written) return;
+    
+    std::ofstream moves(kMovesPath);
+    moves << "name,type,category,power,accuracy,script,status,status_duration\n";
+    for (int i = 0; i < 300; ++i) {
+        const char* type = TypeEffectiveness::typeName(static_cast<PokemonType>(i % TypeEffectiveness::kTypeCount));
+        moves << "Move " << i << "," << type << "," << (i % 3 == 0 ? "Physical" : "Special") << ","
+              << 40 + i % 80 << "," << 70 + i % 31 << "," << (i % 10 == 0 ? "thunderbolt.py" : "") << ",,0\n";
+    }
+    
+    std::ofstream species(kSpeciesPath);
+    species << "name,type,hp,attack,defense,special_defense,speed,moves\n";
+    for (int i = 0; i < 500; ++i) {
+        const char* type = TypeEffectiveness::typeName(static_cast<PokemonType>(i % TypeEffectiveness::kTypeCount));
+        species << "Species " << i << "," << type << "," << 80 + i % 60 << "," << 40 + i % 50 << ","
+                << 40 + i % 45 << "," << 40 + i % 55 << "," << 30 + i % 90 << ","
+                << "Move " << i % 300 << ";Move " << (i * 7) % 300 << ";Move " << (i * 13) % 300
+                << ";Move " << (i * 31) % 300 << "\n";
+    }
+    
+    std::remove(kCachePath);
+    written = true;
+}
+
+} // namespace
+
+// Startup without a cache: read, hash, parse and compile both CSV files
+POKEMON_BENCHMARK(BM_GameDataParse) {
+    writeDataFiles();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        GameData data(kSpeciesPath, kMovesPath, "");
+        doNotOptimize(data.getSpeciesCount());
+    }
+}
+
+// Startup with an up-to-date cache: read and hash the CSV files, map and
+// check the cache
+POKEMON_BENCHMARK(BM_GameDataCached) {
+    writeDataFiles();
+    { GameData warm(kSpeciesPath, kMovesPath, kCachePath); }
+    for (std::size_t i = 0; i < iterations; ++i) {
+        GameData data(kSpeciesPath, kMovesPath, kCachePath);
+        doNotOptimize(data.isCacheHit());
+    }
+}
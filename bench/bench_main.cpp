@@ -0,0 +1,209 @@
+#include "Benchmark.h"
+#include "PythonSkillLoader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Default minimum wall time for a measured run (--benchmark_min_time)
+static const double kMinRunSeconds = 0.5;
+
+/**
+ * Timing of the final (measured) run of a benchmark
+ */
+struct Measurement {
+    std::string name;
+    std::size_t iterations = 0;
+    double realNs = 0.0;            // Wall time per iteration
+    double cpuNs = 0.0;             // Process CPU time per iteration (all threads)
+    double itemsPerSecond = 0.0;    // setItemsProcessed() rate (0 = not reported)
+};
+
+/**
+ * Run a benchmark with a growing iteration count until a single run takes
+ * at least minSeconds, and time that run. A first single-iteration run is
+ * a discarded warm-up (lazy initialization such as starting Python).
+ */
+static Measurement measure(const BenchmarkCase& bench, double minSeconds) {
+    Measurement result;
+    result.name = bench.name;
+    bench.body(1);
+    
+    std::size_t iterations = 1;
+    while (true) {
+        resetItemsProcessed();
+        std::clock_t cpuStart = std::clock();
+        auto start = std::chrono::steady_clock::now();
+        bench.body(iterations);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        
+        if (seconds >= minSeconds || iterations >= (1u << 30)) {
+            result.iterations = iterations;
+            result.realNs = seconds * 1e9 / static_cast<double>(iterations);
+            result.cpuNs = cpuSeconds * 1e9 / static_cast<double>(iterations);
+            result.itemsPerSecond = seconds > 0.0 ? itemsProcessed() / seconds : 0.0;
+            return result;
+        }
+        
+        // Aim slightly past the target so the next run is usually the last
+        double scale = seconds > 0.0 ? (minSeconds * 1.4) / seconds : 100.0;
+        if (scale > 100.0) scale = 100.0;
+        if (scale < 2.0) scale = 2.0;
+        iterations = static_cast<std::size_t>(iterations * scale);
+    }
+}
+
+// Benchmark names are identifiers, but keep the JSON valid whatever they hold
+static std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            quoted += escaped;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+/**
+ * Write results in Google Benchmark's JSON layout (context + benchmarks),
+ * so its tools (e.g. compare.py) can diff two runs
+ */
+static void writeJson(std::FILE* out, const char* executable, const std::vector<Measurement>& results) {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    
+    std::fprintf(out, "{\n  \"context\": {\n");
+    std::fprintf(out, "    \"date\": %s,\n", jsonString(date).c_str());
+    std::fprintf(out, "    \"executable\": %s,\n", jsonString(executable).c_str());
+    std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+    std::fprintf(out, "    \"library_build_type\": \"release\",\n");
+#else
+    std::fprintf(out, "    \"library_build_type\": \"debug\",\n");
+#endif
+    std::fprintf(out, "    \"python_version\": %s\n  },\n", jsonString(PY_VERSION).c_str());
+    
+    std::fprintf(out, "  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Measurement& result = results[i];
+        std::fprintf(out, "%s\n    {\n", i > 0 ? "," : "");
+        std::fprintf(out, "      \"name\": %s,\n", jsonString(result.name).c_str());
+        std::fprintf(out, "      \"run_name\": %s,\n", jsonString(result.name).c_str());
+        std::fprintf(out, "      \"run_type\": \"iteration\",\n");
+        std::fprintf(out, "      \"iterations\": %zu,\n", result.iterations);
+        std::fprintf(out, "      \"real_time\": %.10g,\n", result.realNs);
+        std::fprintf(out, "      \"cpu_time\": %.10g,\n", result.cpuNs);
+        if (result.itemsPerSecond > 0.0) {
+            std::fprintf(out, "      \"items_per_second\": %.10g,\n", result.itemsPerSecond);
+        }
+        std::fprintf(out, "      \"time_unit\": \"ns\"\n    }");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+static void printUsage(const char* program) {
+    std::fprintf(stderr, "Usage: %s [FILTER] [--benchmark_filter=FILTER] [--benchmark_format=console|json]\n"
+                         "       [--benchmark_out=FILE] [--benchmark_min_time=SECONDS]\n"
+                         "  FILTER                     Run benchmarks whose name contains FILTER\n"
+                         "  --benchmark_format=json    Print JSON instead of the table\n"
+                         "  --benchmark_out=FILE       Also write JSON results to FILE\n"
+                         "  --benchmark_min_time=S     Minimum duration of a measured run (default 0.5)\n",
+                 program);
+}
+
+int main(int argc, char* argv[]) {
+    // Optional substring filter on benchmark names, Google Benchmark style flags
+    std::string filter;
+    bool json = false;
+    std::string outPath;
+    double minSeconds = kMinRunSeconds;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&arg](const char* flag) -> const char* {
+            std::string prefix = std::string(flag) + "=";
+            return arg.compare(0, prefix.size(), prefix) == 0 ? arg.c_str() + prefix.size() : nullptr;
+        };
+        if (const char* text = value("--benchmark_filter")) {
+            filter = text;
+        } else if (const char* text = value("--benchmark_format")) {
+            json = std::string(text) == "json";
+            if (!json && std::string(text) != "console") {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (const char* text = value("--benchmark_out")) {
+            outPath = text;
+        } else if (const char* text = value("--benchmark_min_time")) {
+            minSeconds = std::atof(text);
+            if (minSeconds <= 0.0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg.compare(0, 2, "--") != 0 && filter.empty()) {
+            filter = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    std::FILE* out = nullptr;
+    if (!outPath.empty()) {
+        out = std::fopen(outPath.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "Cannot write %s\n", outPath.c_str());
+            return 1;
+        }
+    }
+    
+    // Started by the first benchmark that needs it, in its warm-up run
+    // (silently, so JSON on stdout stays valid)
+    PythonSkillLoader::initializeOnDemand();
+    
+    // Scripts print their own battle commentary; keep it out of the timings
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    
+    std::vector<Measurement> results;
+    if (!json) {
+        std::printf("%-40s %15s %15s %15s %15s\n", "Benchmark", "Time (ns/op)", "Rate (op/s)", "Iterations", "Items/s");
+    }
+    for (const auto& bench : benchmarkRegistry()) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) continue;
+        
+        Measurement result = measure(bench, minSeconds);
+        results.push_back(result);
+        if (!json) {
+            double opsPerSecond = result.realNs > 0.0 ? 1e9 / result.realNs : 0.0;
+            std::printf("%-40s %15.1f %15.3g %15zu", result.name.c_str(), result.realNs, opsPerSecond, result.iterations);
+            if (result.itemsPerSecond > 0.0) {
+                std::printf(" %15.3g\n", result.itemsPerSecond);
+            } else {
+                std::printf(" %15s\n", "-");
+            }
+            std::fflush(stdout);
+        }
+    }
+    
+    if (json) {
+        writeJson(stdout, argv[0], results);
+    }
+    if (out != nullptr) {
+        writeJson(out, argv[0], results);
+        std::fclose(out);
+    }
+    
+    PythonSkillLoader::finalize();
+    return 0;
+}
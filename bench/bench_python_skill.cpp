@@ -0,0 +1,153 @@
+#include "Benchmark.h"
+#include "BattleRng.h"
+#include "Pokemon.h"
+#include "PythonSkillLoader.h"
+#include "SkillArgumentPool.h"
+#include "SkillBatch.h"
+#include <string>
+#include <vector>
+
+// Pikachu vs Squirtle, as in the demo roster
+static Pokemon makeAttacker() { return Pokemon("Pikachu", "Electric", 100, 55, 40, 50, 90); }
+static Pokemon makeDefender() { return Pokemon("Squirtle", "Water", 120, 48, 65, 64, 43); }
+
+// Per-call lookup that executeSkill() used to pay before skills were cached:
+// import the module and fetch the function on every execution
+POKEMON_BENCHMARK(BM_ThunderboltImportLookup) {
+    PythonSkillLoader::ScopedGil gil;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        PyObject* pName = PyUnicode_DecodeFSDefault("thunderbolt");
+        PyObject* pModule = PyImport_Import(pName);
+        Py_DECREF(pName);
+        PyObject* pFunc = PyObject_GetAttrString(pModule, "calculate_damage");
+        doNotOptimize(pFunc);
+        Py_DECREF(pFunc);
+        Py_DECREF(pModule);
+    }
+}
+
+// Full round-trip through executeSkill() (cache lookup by name + call)
+POKEMON_BENCHMARK(BM_ThunderboltExecuteSkill) {
+    Pokemon attacker = makeAttacker();
+    Pokemon defender = makeDefender();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        int damage = PythonSkillLoader::executeSkill("thunderbolt", "calculate_damage", attacker, defender);
+        doNotOptimize(damage);
+    }
+}
+
+// Round-trip through a Python function returned by loadSkill() (no lookup, seeded random)
+POKEMON_BENCHMARK(BM_ThunderboltLoadedSkill) {
+    Pokemon attacker = makeAttacker();
+    Pokemon defender = makeDefender();
+    BattleRng rng(1);
+    PythonSkillLoader::setNativeSkillsEnabled(false);
+    auto skill = PythonSkillLoader::loadSkill("thunderbolt", "calculate_damage");
+    PythonSkillLoader::setNativeSkillsEnabled(true);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        int damage = skill(attacker, defender, rng);
+        doNotOptimize(damage);
+    }
+}
+
+// Same skill through its NATIVE_SKILL description (no interpreter)
+POKEMON_BENCHMARK(BM_ThunderboltNativeSkill) {
+    Pokemon attacker = makeAttacker();
+    Pokemon defender = makeDefender();
+    BattleRng rng(1);
+    auto skill = PythonSkillLoader::loadSkill("thunderbolt", "calculate_damage");
+    for (std::size_t i = 0; i < iterations; ++i) {
+        int damage = skill(attacker, defender, rng);
+        doNotOptimize(damage);
+    }
+}
+
+// Argument marshalling as executeSkill() used to do it: two fresh dicts per call
+POKEMON_BENCHMARK(BM_FreshStatDicts) {
+    PythonSkillLoader::ScopedGil gil;
+    Pokemon attacker = makeAttacker();
+    Pokemon defender = makeDefender();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        PyObject* dicts[2];
+        const Pokemon* pokemon[2] = {&attacker, &defender};
+        for (int side = 0; side < 2; ++side) {
+            const Pokemon& p = *pokemon[side];
+            PyObject* dict = PyDict_New();
+            const char* keys[] = {"current_hp", "max_hp", "attack", "defense", "special_defense", "speed"};
+            long values[] = {p.getCurrentHP(), p.getMaxHP(), p.getAttack(), p.getDefense(), p.getSpecialDefense(), p.getSpeed()};
+            PyObject* name = PyUnicode_FromString(p.getName().c_str());
+            PyDict_SetItemString(dict, "name", name);
+            Py_DECREF(name);
+            for (int k = 0; k < 6; ++k) {
+                PyObject* value = PyLong_FromLong(values[k]);
+                PyDict_SetItemString(dict, keys[k], value);
+                Py_DECREF(value);
+            }
+            dicts[side] = dict;
+        }
+        PyObject* args = PyTuple_Pack(2, dicts[0], dicts[1]);
+        doNotOptimize(args);
+        Py_DECREF(args);
+        Py_DECREF(dicts[0]);
+        Py_DECREF(dicts[1]);
+    }
+}
+
+// Pooled marshalling with the defender losing HP every call
+POKEMON_BENCHMARK(BM_PooledStatDicts) {
+    PythonSkillLoader::ScopedGil gil;
+    Pokemon attacker = makeAttacker();
+    Pokemon defender = makeDefender();
+    SkillArgumentPool pool;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        if (defender.isFainted()) defender.heal(defender.getMaxHP());
+        defender.takeDamage(1);
+        doNotOptimize(pool.pack(attacker, defender));
+    }
+}
+
+// 10k Thunderbolt hits over a spread of attacker/defender stats
+static const std::size_t kBatchHits = 10000;
+
+static std::vector<Pokemon> makeBatchRoster() {
+    std::vector<Pokemon> roster;
+    for (int i = 0; i < 64; ++i) {
+        roster.emplace_back("Mon" + std::to_string(i), "Normal", 80 + i, 40 + i, 35 + (i * 7) % 50, 40 + (i * 5) % 45, 30 + i);
+    }
+    return roster;
+}
+
+// 10k hits, one Python call each (pooled dicts, no native path)
+POKEMON_BENCHMARK(BM_Thunderbolt10kPerCall) {
+    std::vector<Pokemon> roster = makeBatchRoster();
+    BattleRng rng(1);
+    PythonSkillLoader::setNativeSkillsEnabled(false);
+    auto skill = PythonSkillLoader::loadSkill("thunderbolt", "calculate_damage");
+    PythonSkillLoader::setNativeSkillsEnabled(true);
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t hit = 0; hit < kBatchHits; ++hit) {
+            int damage = skill(roster[hit % 64], roster[(hit * 7 + 3) % 64], rng);
+            doNotOptimize(damage);
+        }
+    }
+    PythonSkillLoader::setScriptOutputEnabled(true);
+}
+
+// The same 10k hits through one calculate_damage_batch() call
+POKEMON_BENCHMARK(BM_Thunderbolt10kBatch) {
+    std::vector<Pokemon> roster = makeBatchRoster();
+    BattleRng rng(1);
+    SkillBatch batch;
+    batch.reserve(kBatchHits);
+    PythonSkillLoader::setNativeSkillsEnabled(false);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        batch.clear();
+        for (std::size_t hit = 0; hit < kBatchHits; ++hit) {
+            batch.add(roster[hit % 64], roster[(hit * 7 + 3) % 64]);
+        }
+        PythonSkillLoader::executeSkillBatch("thunderbolt", batch, rng);
+        doNotOptimize(batch.getDamage(kBatchHits - 1));
+    }
+    PythonSkillLoader::setNativeSkillsEnabled(true);
+}
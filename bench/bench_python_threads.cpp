@@ -0,0 +1,51 @@
+#include "Benchmark.h"
+#include "Move.h"
+#include "PythonSkillLoader.h"
+#include "Tournament.h"
+#include <vector>
+
+namespace {
+
+// Four entrants whose damaging moves all run in Python (native path off)
+const std::vector<Pokemon>& pythonEntrants() {
+    static std::vector<Pokemon> entrants;
+    if (entrants.empty()) {
+        PythonSkillLoader::setNativeSkillsEnabled(false);
+        struct Entry { const char* name; const char* type; int stats[5]; const char* move; const char* script; const char* moveType; };
+        const Entry roster[] = {
+            {"Pikachu", "Electric", {100, 55, 40, 50, 90}, "Thunderbolt", "thunderbolt", "Electric"},
+            {"Squirtle", "Water", {120, 48, 65, 64, 43}, "Water Gun", "water_gun", "Water"},
+            {"Charmander", "Fire", {110, 52, 43, 50, 65}, "Flamethrower", "flamethrower", "Fire"},
+            {"Bulbasaur", "Grass", {115, 49, 49, 65, 45}, "Slash", "slash", "Normal"},
+        };
+        for (const auto& entry : roster) {
+            Pokemon pokemon(entry.name, entry.type, entry.stats[0], entry.stats[1], entry.stats[2], entry.stats[3], entry.stats[4]);
+            Move move(entry.move, "", 0, 100, entry.moveType, MoveCategory::SPECIAL);
+            PythonSkillLoader::bindSkill(move, entry.script);
+            pokemon.addMove(move);
+            entrants.push_back(pokemon);
+        }
+        PythonSkillLoader::setNativeSkillsEnabled(true);
+    }
+    return entrants;
+}
+
+// One 3072-battle round-robin of Python-backed moves per iteration (large
+// enough that creating the per-worker sub-interpreters is a small share)
+void runPythonTournament(std::size_t iterations, unsigned threads) {
+    const std::vector<Pokemon>& entrants = pythonEntrants();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Tournament tournament(entrants, 256, i);
+        doNotOptimize(tournament.run(threads).wins[1]);
+    }
+    setItemsProcessed(iterations * entrants.size() * (entrants.size() - 1) * 256);
+}
+
+} // namespace
+
+// Scaling of Python skill calls with worker threads: per-thread
+// sub-interpreters on Python 3.12+, one shared GIL before that
+POKEMON_BENCHMARK(BM_PythonTournament_1Thread) { runPythonTournament(iterations, 1); }
+POKEMON_BENCHMARK(BM_PythonTournament_2Threads) { runPythonTournament(iterations, 2); }
+POKEMON_BENCHMARK(BM_PythonTournament_4Threads) { runPythonTournament(iterations, 4); }
+POKEMON_BENCHMARK(BM_PythonTournament_8Threads) { runPythonTournament(iterations, 8); }
@@ -0,0 +1,23 @@
+#include "Benchmark.h"
+#include "BattleRng.h"
+#include <random>
+
+// Accuracy-style roll from the battle generator
+POKEMON_BENCHMARK(BM_BattleRngNextInt) {
+    BattleRng rng(1);
+    int sum = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sum += rng.nextInt(100);
+    }
+    doNotOptimize(sum);
+}
+
+// Same roll from the standard 64-bit Mersenne Twister, for comparison
+POKEMON_BENCHMARK(BM_Mt19937NextInt) {
+    std::mt19937_64 engine(1);
+    int sum = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sum += static_cast<int>(((engine() >> 32) * 100) >> 32);
+    }
+    doNotOptimize(sum);
+}
@@ -0,0 +1,39 @@
+#include "Benchmark.h"
+#include "BattleSimulator.h"
+#include "MatchupSolver.h"
+#include "Move.h"
+
+namespace {
+
+// Pikachu vs Squirtle with built-in moves, as in bench_ai.cpp
+void makeContestants(Pokemon& pikachu, Pokemon& squirtle) {
+    pikachu.addMove(Move("Thunder Shock", "", 40, 100, "Electric", MoveCategory::SPECIAL));
+    pikachu.addMove(Move("Quick Attack", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+    pikachu.addMove(Move("Thunder Wave", "", 0, 90, "Electric", MoveCategory::STATUS, "Paralyzed", 4));
+    squirtle.addMove(Move("Bubble", "", 40, 100, "Water", MoveCategory::SPECIAL));
+    squirtle.addMove(Move("Tackle", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+}
+
+} // namespace
+
+// Exact win probability of the matchup, from scratch each time
+POKEMON_BENCHMARK(BM_SolveMatchup) {
+    Pokemon pikachu("Pikachu", "Electric", 100, 55, 40, 50, 90);
+    Pokemon squirtle("Squirtle", "Water", 120, 48, 65, 64, 43);
+    makeContestants(pikachu, squirtle);
+    MatchupSolver solver(pikachu, squirtle);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        doNotOptimize(solver.solve().winProbability[0]);
+    }
+}
+
+// The sampling alternative: 10000 simulated battles of the same matchup
+POKEMON_BENCHMARK(BM_SimulateMatchup10k) {
+    Pokemon pikachu("Pikachu", "Electric", 100, 55, 40, 50, 90);
+    Pokemon squirtle("Squirtle", "Water", 120, 48, 65, 64, 43);
+    makeContestants(pikachu, squirtle);
+    BattleSimulator simulator(pikachu, squirtle);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        doNotOptimize(simulator.run(10000, i, nullptr).wins[0]);
+    }
+}
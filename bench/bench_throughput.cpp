@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+#include "Move.h"
+#include "Tournament.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The demo roster with built-in and native moves only, so no Python is
+// involved and the numbers are the engine's own
+const std::vector<Pokemon>& nativeEntrants() {
+    static std::vector<Pokemon> entrants;
+    if (entrants.empty()) {
+        NativeSkillSpec special;
+        special.power = 90;
+        special.defense = NativeSkillSpec::DefenseStat::SPECIAL_DEFENSE;
+        
+        Pokemon pikachu("Pikachu", "Electric", 100, 55, 40, 50, 90);
+        Move thunderbolt("Thunderbolt", "", 90, 100, "Electric", MoveCategory::SPECIAL);
+        thunderbolt.setNativeEffect(special);
+        pikachu.addMove(thunderbolt);
+        pikachu.addMove(Move("Quick Attack", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+        pikachu.addMove(Move("Thunder Wave", "", 0, 100, "Electric", MoveCategory::STATUS, "Paralyzed", 4));
+        entrants.push_back(pikachu);
+        
+        Pokemon squirtle("Squirtle", "Water", 120, 48, 65, 64, 43);
+        squirtle.addMove(Move("Bubble", "", 40, 100, "Water", MoveCategory::SPECIAL));
+        squirtle.addMove(Move("Withdraw", "", 0, 100, "Water", MoveCategory::STATUS));
+        entrants.push_back(squirtle);
+        
+        Pokemon bulbasaur("Bulbasaur", "Grass", 115, 49, 49, 65, 45);
+        bulbasaur.addMove(Move("Vine Whip", "", 45, 100, "Grass", MoveCategory::PHYSICAL));
+        bulbasaur.addMove(Move("Razor Leaf", "", 55, 95, "Grass", MoveCategory::PHYSICAL));
+        bulbasaur.addMove(Move("Toxic", "", 0, 90, "Poison", MoveCategory::STATUS, "Poisoned", 5));
+        entrants.push_back(bulbasaur);
+        
+        Pokemon charmander("Charmander", "Fire", 110, 52, 43, 50, 65);
+        Move flamethrower("Flamethrower", "", 90, 100, "Fire", MoveCategory::SPECIAL);
+        flamethrower.setNativeEffect(special);
+        charmander.addMove(flamethrower);
+        charmander.addMove(Move("Ember", "", 40, 100, "Fire", MoveCategory::SPECIAL));
+        charmander.addMove(Move("Scratch", "", 40, 100, "Normal", MoveCategory::PHYSICAL));
+        entrants.push_back(charmander);
+    }
+    return entrants;
+}
+
+// One 3072-battle round-robin per iteration; items are battles
+void runHeadlessBattles(std::size_t iterations, unsigned threads) {
+    const std::vector<Pokemon>& entrants = nativeEntrants();
+    const int repetitions = 256;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Tournament tournament(entrants, repetitions, i);
+        doNotOptimize(tournament.run(threads).wins[1]);
+    }
+    setItemsProcessed(iterations * entrants.size() * (entrants.size() - 1) * repetitions);
+}
+
+} // namespace
+
+// Macro benchmarks: headless battles per second (Items/s), on one worker
+// and on every core
+POKEMON_BENCHMARK(BM_HeadlessBattles_1Thread) { runHeadlessBattles(iterations, 1); }
+POKEMON_BENCHMARK(BM_HeadlessBattles_AllThreads) {
+    runHeadlessBattles(iterations, std::max(1u, std::thread::hardware_concurrency()));
+}
@@ -0,0 +1,25 @@
+#include "Benchmark.h"
+#include "TypeEffectiveness.h"
+#include <string>
+
+// Lookup by type name, as callers did before types were parsed up front
+POKEMON_BENCHMARK(BM_TypeEffectivenessByName) {
+    const std::string attackTypes[] = {"Electric", "Water", "Fire", "Grass"};
+    const std::string defenseTypes[] = {"Water", "Fire", "Grass", "Ground"};
+    double total = 0.0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        total += TypeEffectiveness::getEffectiveness(attackTypes[i & 3], defenseTypes[(i >> 2) & 3]);
+    }
+    doNotOptimize(total);
+}
+
+// Lookup by PokemonType: one load from the dense chart
+POKEMON_BENCHMARK(BM_TypeEffectivenessByEnum) {
+    const PokemonType attackTypes[] = {PokemonType::ELECTRIC, PokemonType::WATER, PokemonType::FIRE, PokemonType::GRASS};
+    const PokemonType defenseTypes[] = {PokemonType::WATER, PokemonType::FIRE, PokemonType::GRASS, PokemonType::GROUND};
+    double total = 0.0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        total += TypeEffectiveness::getEffectiveness(attackTypes[i & 3], defenseTypes[(i >> 2) & 3]);
+    }
+    doNotOptimize(total);
+}
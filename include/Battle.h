@@ -2,7 +2,12 @@
 #define BATTLE_H
 
 #include "Pokemon.h"
+#include "BattleEvent.h"
+#include "BattleRng.h"
+#include "DecisionPolicy.h"
+#include <cstdint>
 #include <memory>
+#include <iostream>
 
 /**
  * Battle Class
@@ -14,16 +19,11 @@ class Battle {
 private:
     std::shared_ptr<Pokemon> pokemon1;  // First Pokemon in battle
     std::shared_ptr<Pokemon> pokemon2;  // Second Pokemon in battle
-    
-    /**
-     * Execute a single Pokemon's turn
-     * Handles paralysis check, move execution, and status updates
-     * 
-     * @param attacker Pokemon executing their turn
-     * @param defender Pokemon being targeted
-     * @param moveIndex Index of move to use (0-based)
-     */
-    void executeTurn(Pokemon& attacker, Pokemon& defender, int moveIndex);
+    std::unique_ptr<BattleEventSink> ownedEvents;  // Text renderer created for stream constructors
+    BattleEventSink* events;            // Receives everything that happens in the battle
+    BattleRng rng;                      // Random source for this battle only
+    int turnCount;                      // Turns started so far
+    DecisionPolicy* policies[2];        // Move choice of each Pokemon (nullptr = random)
     
     /**
      * Determine which Pokemon attacks first based on Speed stat
@@ -32,16 +32,78 @@ private:
      * @return Reference to Pokemon that attacks first
      */
     Pokemon& determineFirstAttacker();
+    
+    /**
+     * Move the attacker uses this action, from its policy (or at random)
+     */
+    int chooseMove(Pokemon& attacker, Pokemon& defender, bool movesFirst);
 
 public:
     /**
      * Constructor
-     * Creates a new Battle between two Pokemon
+     * Creates a new Battle between two Pokemon that prints its transcript
+     * 
+     * @param p1 First Pokemon
+     * @param p2 Second Pokemon
+     * @param out Stream the battle transcript is rendered to
+     */
+    Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, std::ostream& out = std::cout);
+    
+    /**
+     * Constructor with an explicit seed
+     * Two battles with the same Pokemon and seed play out identically
+     * 
+     * @param p1 First Pokemon
+     * @param p2 Second Pokemon
+     * @param seed Seed for this battle's random stream
+     * @param out Stream the battle transcript is rendered to
+     */
+    Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, uint64_t seed, std::ostream& out = std::cout);
+    
+    /**
+     * Constructor reporting to an event sink
+     * 
+     * @param p1 First Pokemon
+     * @param p2 Second Pokemon
+     * @param events Sink for battle events (e.g. NullEventSink to run silently);
+     *               must outlive the battle
+     */
+    Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, BattleEventSink& events);
+    
+    /**
+     * Constructor with an explicit seed, reporting to an event sink
      * 
      * @param p1 First Pokemon
      * @param p2 Second Pokemon
+     * @param seed Seed for this battle's random stream
+     * @param events Sink for battle events; must outlive the battle
+     */
+    Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, uint64_t seed, BattleEventSink& events);
+    
+    /**
+     * Constructor for Pokemon owned elsewhere (e.g. in a BattleArena)
+     * Nothing is allocated or reference counted; start() returns a
+     * non-owning pointer to the winner
+     * 
+     * @param p1 First Pokemon; must outlive the battle
+     * @param p2 Second Pokemon; must outlive the battle
+     * @param seed Seed for this battle's random stream
+     * @param events Sink for battle events; must outlive the battle
+     */
+    Battle(Pokemon& p1, Pokemon& p2, uint64_t seed, BattleEventSink& events);
+    
+    /**
+     * Choose how each Pokemon picks its moves
+     * Without a policy (the default) a move is drawn uniformly at random
+     * from the battle's generator, like RandomPolicy.
+     * 
+     * @param policy1 Policy of the first Pokemon (nullptr = random); must outlive the battle
+     * @param policy2 Policy of the second Pokemon (nullptr = random); must outlive the battle
      */
-    Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2);
+    void setPolicies(DecisionPolicy* policy1, DecisionPolicy* policy2) {
+        policies[0] = policy1;
+        policies[1] = policy2;
+    }
     
     /**
      * Start and run the battle until one Pokemon faints
@@ -50,6 +112,7 @@ public:
      * 1. Display initial state
      * 2. Each turn:
      *    - Determine turn order by Speed
+     *    - Each Pokemon's move comes from its policy (random by default)
      *    - Fast Pokemon attacks
      *    - Check if slow Pokemon fainted
      *    - Slow Pokemon attacks (if alive)
@@ -63,8 +126,39 @@ public:
     std::shared_ptr<Pokemon> start();
     
     /**
-     * Display current state of both Pokemon in battle
-     * Shows HP, status effects, stats, and available moves
+     * Execute a single Pokemon's turn
+     * Handles status turn loss, move execution, and status updates
+     * (start() calls this twice per turn; it is public for callers that
+     * drive turns themselves, e.g. benchmarks)
+     * 
+     * @param attacker Pokemon executing their turn
+     * @param defender Pokemon being targeted
+     * @param moveIndex Index of move to use (0-based)
+     */
+    void executeTurn(Pokemon& attacker, Pokemon& defender, int moveIndex);
+    
+    /**
+     * Execute one Pokemon's action against any generator and sink
+     * (the rules behind executeTurn(), shared with TeamBattle)
+     * 
+     * @param attacker Pokemon executing their turn
+     * @param defender Pokemon being targeted
+     * @param moveIndex Index of move to use (0-based; out of range uses move 0)
+     * @param rng Generator of the battle
+     * @param events Sink of the battle
+     */
+    static void executeAction(Pokemon& attacker, Pokemon& defender, int moveIndex,
+                              BattleRng& rng, BattleEventSink& events);
+    
+    /**
+     * Number of turns started in this battle (including the final turn)
+     */
+    int getTurnCount() const { return turnCount; }
+    
+    /**
+     * Report the current state of both Pokemon in battle
+     * (a STATE_SNAPSHOT event; the text renderer shows HP, status effects,
+     * stats, and available moves)
      */
     void displayBattleState() const;
 };
@@ -0,0 +1,79 @@
+#ifndef BATTLE_ARENA_H
+#define BATTLE_ARENA_H
+
+#include "Pokemon.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * BattleArena Class
+ * 
+ * Fixed-size roster of Pokemon that battles are played on repeatedly.
+ * The Pokemon are copied in once, into storage reserved up front, so their
+ * addresses never change and Battle can borrow them by reference. Their
+ * moves stay in the MoveRegistry, shared by every battle.
+ * 
+ * A battle only changes each Pokemon's PokemonState. snapshot() saves the
+ * states of the whole roster and restore() writes them back with flat
+ * copies, so re-running a matchup allocates nothing per battle. A
+ * Pokemon's state when it is added is its initial snapshot.
+ * 
+ * Usage:
+ *   BattleArena arena(2);
+ *   Pokemon& pikachu = arena.add(pikachuTemplate);
+ *   Pokemon& squirtle = arena.add(squirtleTemplate);
+ *   for (uint64_t seed = 0; seed < 1000; ++seed) {
+ *       arena.restore();
+ *       Battle(pikachu, squirtle, seed, events).start();
+ *   }
+ * 
+ * An arena is not thread-safe; give each thread its own.
+ */
+class BattleArena {
+private:
+    std::vector<Pokemon> pokemon;       // Roster; capacity reserved by the constructor
+    std::vector<PokemonState> saved;    // States written back by restore()
+    
+public:
+    /**
+     * Constructor
+     * 
+     * @param capacity Maximum number of Pokemon in the arena
+     */
+    explicit BattleArena(size_t capacity);
+    
+    /**
+     * Copy a Pokemon into the arena
+     * 
+     * @param prototype Pokemon to copy (stats, moveset and current state)
+     * @return The arena's copy, valid for the arena's lifetime
+     * @throws std::runtime_error if the arena is full
+     */
+    Pokemon& add(const Pokemon& prototype);
+    
+    /**
+     * Pokemon by slot (slots are numbered in the order Pokemon were added)
+     */
+    Pokemon& get(size_t slot) { return pokemon[slot]; }
+    const Pokemon& get(size_t slot) const { return pokemon[slot]; }
+    
+    /**
+     * The whole roster, in slot order
+     */
+    const std::vector<Pokemon>& getPokemon() const { return pokemon; }
+    
+    size_t size() const { return pokemon.size(); }
+    size_t capacity() const { return pokemon.capacity(); }
+    
+    /**
+     * Save the current HP and status of every Pokemon
+     */
+    void snapshot();
+    
+    /**
+     * Reset every Pokemon to the last snapshot
+     */
+    void restore();
+};
+
+#endif // BATTLE_ARENA_H
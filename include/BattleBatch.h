@@ -0,0 +1,162 @@
+#ifndef BATTLE_BATCH_H
+#define BATTLE_BATCH_H
+
+#include "BattleRng.h"
+#include "StatusEffect.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Forward declaration
+class Pokemon;
+
+/**
+ * BattleBatch Class
+ *
+ * Lockstep engine for many independent one-on-one battles.
+ * Instead of a Pokemon object per side, the batch keeps every battle's HP,
+ * stats, status and status duration in parallel arrays (one array per field
+ * and side) and advances all unfinished battles one turn per step(). Each
+ * half-turn runs in three passes over the battles still in play: draw move
+ * choices and rolls, resolve accuracy and damage of all actions at once
+ * with the SIMD DamageKernel, then apply damage and status.
+ *
+ * Battles follow the Battle rules exactly and draw from their own
+ * BattleRng in the same order, so battle k ends with the same winner, turn
+ * count, HP and status as Battle(p1, p2, seed) would. Only moves with the
+ * built-in damage formula are supported (see supports()); moves with a
+ * Python or native skill need Battle. No events are reported.
+ *
+ * Usage:
+ *   BattleBatch batch;
+ *   for (int i = 0; i < 10000; ++i) batch.add(p1, p2, BattleRng::deriveSeed(seed, i));
+ *   batch.run();
+ *   int winner = batch.getWinner(0);
+ */
+class BattleBatch {
+private:
+    /**
+     * Per-side state of every battle, one entry per battle
+     */
+    struct Side {
+        std::vector<int32_t> hp;
+        std::vector<int32_t> maxHP;
+        std::vector<int32_t> attack;
+        std::vector<int32_t> defense;
+        std::vector<int32_t> specialDefense;
+        std::vector<uint8_t> status;            // StatusEffect
+        std::vector<int32_t> statusDuration;
+        std::vector<uint32_t> moveBase;         // First entry in the move table
+        std::vector<uint8_t> moveCount;         // Number of moves
+    };
+
+    /**
+     * Moves of every battle side, flattened; resolved against the opposing
+     * Pokemon when the battle is added
+     */
+    struct MoveTable {
+        std::vector<int32_t> power;
+        std::vector<int32_t> accuracy;
+        std::vector<double> effectiveness;      // Type multiplier against the opponent
+        std::vector<uint8_t> special;           // Uses the defender's special defense
+        std::vector<uint8_t> status;            // StatusEffect applied (status moves only)
+        std::vector<int32_t> statusDuration;
+    };
+
+    Side sides[2];
+    MoveTable moves;
+    std::vector<BattleRng> rngs;            // Random stream per battle
+    std::vector<uint8_t> firstSide;         // Side that moves first (speed, ties to side 0)
+    std::vector<int32_t> turns;             // Turns started
+    std::vector<uint8_t> winners;           // Winning side, or kRunning
+    std::vector<uint32_t> running;          // Unfinished battles, in battle order
+
+    // Scratch arrays of one half-turn, indexed by position in the acting list
+    std::vector<uint32_t> acting;
+    std::vector<uint8_t> acted;             // Status ticks (had a move; lost turns only if ticksOnLostTurn)
+    std::vector<int32_t> selfDamage;        // Confusion self-hit on a lost turn
+    std::vector<uint8_t> inflictedStatus;   // Status move that hit, or NONE
+    std::vector<int32_t> inflictedDuration;
+    std::vector<int32_t> hitAttack;
+    std::vector<int32_t> hitDefense;
+    std::vector<int32_t> hitPower;
+    std::vector<int32_t> hitAccuracy;       // 0 when the turn was lost
+    std::vector<int32_t> hitRoll;
+    std::vector<double> hitEffectiveness;
+    std::vector<int32_t> hitDamage;
+
+    static const uint8_t kRunning = 0xFF;
+
+    /**
+     * Add a side's moveset to the move table, resolved against the opponent
+     */
+    void addMoves(Side& side, const Pokemon& pokemon, const Pokemon& opponent);
+
+    /**
+     * One Pokemon's action in every battle of the acting list
+     *
+     * @param secondMover false for the faster Pokemon's half-turn, true for the other
+     */
+    void halfTurn(bool secondMover);
+
+public:
+    /**
+     * Whether a Pokemon can battle in a BattleBatch: all of its moves use
+     * the built-in damage formula
+     */
+    static bool supports(const Pokemon& pokemon);
+
+    /**
+     * Add a battle between two Pokemon in their current state
+     *
+     * @param p1 First Pokemon (side 0)
+     * @param p2 Second Pokemon (side 1)
+     * @param seed Battle seed, as for Battle
+     * @return Index of the battle
+     * @throws std::invalid_argument if a move is not supported (see supports())
+     */
+    size_t add(const Pokemon& p1, const Pokemon& p2, uint64_t seed);
+
+    /**
+     * Reserve room for a number of battles
+     */
+    void reserve(size_t battles);
+
+    /**
+     * Remove all battles (keeps the allocated capacity)
+     */
+    void clear();
+
+    /**
+     * Play one turn of every unfinished battle
+     *
+     * @return true if some battles are still unfinished afterwards
+     */
+    bool step();
+
+    /**
+     * Play every battle to the end
+     */
+    void run();
+
+    size_t size() const { return turns.size(); }
+
+    /**
+     * Number of battles not finished yet
+     */
+    size_t getRunningCount() const { return running.size(); }
+
+    bool isFinished(size_t battle) const { return winners[battle] != kRunning; }
+
+    /**
+     * Winning side (0 or 1) of a finished battle
+     */
+    int getWinner(size_t battle) const { return winners[battle]; }
+
+    int getTurnCount(size_t battle) const { return turns[battle]; }
+    int getHP(size_t battle, int side) const { return sides[side].hp[battle]; }
+    StatusEffect getStatusEffect(size_t battle, int side) const { return static_cast<StatusEffect>(sides[side].status[battle]); }
+    int getStatusDuration(size_t battle, int side) const { return sides[side].statusDuration[battle]; }
+};
+
+#endif // BATTLE_BATCH_H
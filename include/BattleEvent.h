@@ -0,0 +1,89 @@
+#ifndef BATTLE_EVENT_H
+#define BATTLE_EVENT_H
+
+#include "StatusEffect.h"
+#include <cstdint>
+
+// Forward declarations
+class Pokemon;
+class Move;
+
+/**
+ * BattleEventType Enumeration
+ *
+ * Everything observable that happens in a battle. The comment on each
+ * value lists the BattleEvent fields it uses.
+ */
+enum class BattleEventType : uint8_t {
+    BATTLE_START,       // actor = first Pokemon, target = second Pokemon
+    STATE_SNAPSHOT,     // actor = first Pokemon, target = second Pokemon (battle state display)
+    TURN_START,         // value = turn number (1-based)
+    ACTION_START,       // actor = Pokemon whose turn it is
+    NO_MOVES,           // actor has no moves to use
+    TURN_LOST,          // actor lost its turn to status; value = self-inflicted damage
+    MISSED,             // actor's move missed target
+    MOVE_USED,          // actor used move on target
+    DAMAGE,             // actor's move dealt value damage to target
+    EFFECTIVENESS,      // actor's move hit target with multiplier != 1.0
+    HEALED,             // actor restored value HP with move
+    STATUS_APPLIED,     // actor is now affected by status
+    STATUS_TICK,        // actor's status acted at end of turn; value = damage taken
+    ABSORBED,           // actor absorbed value HP from target's status (Seeded)
+    STATUS_RECOVERED,   // actor recovered from status
+    FAINTED,            // actor fainted
+    BATTLE_END,         // actor = winner, target = loser
+    SWITCHED,           // actor was sent in for target (withdrawn or fainted); value = actor's party slot (TeamBattle)
+    COUNT               // Number of event types (not an event)
+};
+
+/**
+ * BattleEvent Struct
+ *
+ * One battle event. Small, trivially copyable and built on the stack; the
+ * Pokemon and Move pointers are only valid during BattleEventSink::onEvent.
+ */
+struct BattleEvent {
+    BattleEventType type;                   // What happened
+    const Pokemon* actor;                   // Pokemon the event is about
+    const Pokemon* target;                  // Opposing Pokemon, if any
+    const Move* move;                       // Move involved, if any
+    int value;                              // Damage, HP or turn number, depending on type
+    StatusEffect status = StatusEffect::NONE;   // Status involved, if any
+    double multiplier = 1.0;                // Type effectiveness (EFFECTIVENESS only)
+
+    BattleEvent(BattleEventType type, const Pokemon* actor = nullptr, const Pokemon* target = nullptr,
+                const Move* move = nullptr, int value = 0)
+        : type(type), actor(actor), target(target), move(move), value(value) {}
+};
+
+/**
+ * BattleEventSink Interface
+ *
+ * Receives the event stream of a battle. Battle, Move and the status rules
+ * report what happens through a sink instead of printing, so the same
+ * battle can be rendered as text, recorded, or not observed at all.
+ */
+class BattleEventSink {
+public:
+    virtual ~BattleEventSink() = default;
+
+    /**
+     * Called once per event, in battle order
+     *
+     * @param event The event; pointers inside are valid only during the call
+     */
+    virtual void onEvent(const BattleEvent& event) = 0;
+};
+
+/**
+ * NullEventSink Class
+ *
+ * Discards every event. Used by headless simulations, where no event is
+ * ever formatted.
+ */
+class NullEventSink : public BattleEventSink {
+public:
+    void onEvent(const BattleEvent&) override {}
+};
+
+#endif // BATTLE_EVENT_H
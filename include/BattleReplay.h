@@ -0,0 +1,161 @@
+#ifndef BATTLE_REPLAY_H
+#define BATTLE_REPLAY_H
+
+#include "BattleEvent.h"
+#include "TypeEffectiveness.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * ReplayPokemon Struct
+ *
+ * Roster snapshot of one side of a recorded battle: the Pokemon's name,
+ * type, stats and move names at the start of the battle. Move behaviour
+ * (e.g. Python skills) is not stored; re-executing a replay looks the
+ * Pokemon up by name and checks that the stats still match.
+ */
+struct ReplayPokemon {
+    std::string name;
+    PokemonType type = PokemonType::NORMAL;
+    int maxHP = 0;
+    int attack = 0;
+    int defense = 0;
+    int specialDefense = 0;
+    int speed = 0;
+    std::vector<std::string> moves;     // Move names, in moveset order
+
+    /**
+     * Snapshot a Pokemon
+     */
+    static ReplayPokemon fromPokemon(const Pokemon& pokemon);
+
+    /**
+     * Whether a Pokemon has this snapshot's name, type, stats and moves
+     */
+    bool matches(const Pokemon& pokemon) const;
+};
+
+/**
+ * ReplayAction Struct
+ *
+ * One Pokemon's action within a turn and its outcome. Stored in 12 bytes.
+ */
+struct ReplayAction {
+    static const uint8_t kNone = 0xFF;
+
+    enum Outcome : uint8_t {
+        USED,           // Move was used (hit, or a status/healing move)
+        MISSED,         // Move missed
+        TURN_LOST,      // Turn lost to a status; damage = self-inflicted damage
+        NO_MOVES        // Pokemon had no moves
+    };
+
+    uint8_t actor = kNone;          // Side of the acting Pokemon (0 or 1)
+    uint8_t move = kNone;           // Index in the actor's moveset, or kNone
+    uint8_t outcome = USED;         // Outcome
+    uint8_t effectiveness = 4;      // Type effectiveness x4 (0 = no effect, 2 = 0.5x, 4 = 1x, 8 = 2x)
+    int32_t damage = 0;             // Damage dealt (negative = HP restored); the log holds -32768..32767
+    uint16_t hp[2] = {0, 0};        // HP of both sides after the action, including end-of-turn status
+    uint8_t status[2] = {0, 0};     // StatusEffect of both sides after the action
+
+    double getEffectiveness() const { return effectiveness / 4.0; }
+};
+
+inline bool operator==(const ReplayAction& a, const ReplayAction& b) {
+    return a.actor == b.actor && a.move == b.move && a.outcome == b.outcome &&
+           a.effectiveness == b.effectiveness && a.damage == b.damage &&
+           a.hp[0] == b.hp[0] && a.hp[1] == b.hp[1] &&
+           a.status[0] == b.status[0] && a.status[1] == b.status[1];
+}
+
+inline bool operator!=(const ReplayAction& a, const ReplayAction& b) { return !(a == b); }
+
+/**
+ * BattleReplay Struct
+ *
+ * A complete recorded battle: seed, roster snapshot and per-turn actions,
+ * with an index from turn number to the turn's first action.
+ */
+struct BattleReplay {
+    uint64_t seed = 0;                      // Seed the battle was played with
+    ReplayPokemon pokemon[2];               // Side 0 and side 1
+    uint8_t winner = ReplayAction::kNone;   // Winning side
+    std::vector<uint32_t> turnStarts;       // turnStarts[k - 1] = index of turn k's first action
+    std::vector<ReplayAction> actions;      // All actions, in order
+
+    int getTurnCount() const { return static_cast<int>(turnStarts.size()); }
+
+    /**
+     * Index of the first action of a turn
+     *
+     * @param turn Turn number (1-based)
+     * @return Index into actions
+     * @throws std::out_of_range if the battle has no such turn
+     */
+    size_t seekTurn(int turn) const;
+
+    /**
+     * HP of a side at the start of a turn (before any action of that turn)
+     *
+     * @param turn Turn number (1-based)
+     * @param side 0 or 1
+     * @throws std::out_of_range if the battle has no such turn
+     */
+    int getHPAtTurn(int turn, int side) const;
+};
+
+/**
+ * ReplayRecorder Class
+ *
+ * Event sink that records a battle into a BattleReplay. It can pass every
+ * event on to another sink, e.g. to print a battle while recording it.
+ * Replays are of two-Pokemon Battles; TeamBattle switches are not recorded.
+ *
+ * Usage:
+ *   ReplayRecorder recorder;
+ *   recorder.setSeed(seed);
+ *   Battle(p1, p2, seed, recorder).start();
+ *   log.append(recorder.getReplay());
+ */
+class ReplayRecorder : public BattleEventSink {
+private:
+    BattleEventSink* forward;       // Sink receiving every event as well (may be null)
+    const Pokemon* participants[2]; // Sides of the battle being recorded
+    BattleReplay replay;            // Battle recorded so far
+    ReplayAction pending;           // Action in progress
+    bool hasPending;                // Whether pending holds an unfinished action
+    uint64_t nextSeed;              // Seed stored for the next battle
+
+    /**
+     * Side of a Pokemon in the current battle, or kNone
+     */
+    uint8_t sideOf(const Pokemon* pokemon) const;
+
+    /**
+     * Store the action in progress with both sides' current HP and status
+     */
+    void finishAction();
+
+public:
+    /**
+     * Constructor
+     *
+     * @param forward Optional sink that receives every event as well
+     */
+    explicit ReplayRecorder(BattleEventSink* forward = nullptr);
+
+    /**
+     * Seed to store with the next battle (Battle does not report its seed)
+     */
+    void setSeed(uint64_t seed) { nextSeed = seed; }
+
+    void onEvent(const BattleEvent& event) override;
+
+    /**
+     * The battle recorded most recently (complete once BATTLE_END was seen)
+     */
+    const BattleReplay& getReplay() const { return replay; }
+};
+
+#endif // BATTLE_REPLAY_H
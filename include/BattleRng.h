@@ -0,0 +1,115 @@
+#ifndef BATTLE_RNG_H
+#define BATTLE_RNG_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * BattleRng Class
+ * 
+ * Random number source owned by a single Battle.
+ * Every random decision in a battle (move choice, accuracy roll, paralysis
+ * roll, and the randomness inside Python skills) draws from the battle's
+ * own generator, so battles never share state across threads and a battle
+ * replays exactly from its seed.
+ * 
+ * Implements xoshiro256** (Blackman & Vigna): 32 bytes of state, a handful
+ * of shifts and multiplies per draw and good statistical quality. It models
+ * the standard UniformRandomBitGenerator concept, so it also plugs into
+ * <random> distributions and algorithms such as std::shuffle. The full
+ * state can be read and restored to rewind or fork a battle's stream.
+ */
+class BattleRng {
+public:
+    using result_type = uint64_t;
+    
+    /**
+     * Complete generator state
+     */
+    struct State {
+        uint64_t s[4];
+    };
+    
+private:
+    State state;
+    
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+    
+public:
+    /**
+     * Constructor
+     * Expands the seed into the full state with SplitMix64, so nearby
+     * seeds (0, 1, 2, ...) still give unrelated streams
+     * 
+     * @param seed Seed for this battle's random stream
+     */
+    explicit BattleRng(uint64_t seed) {
+        for (int i = 0; i < 4; ++i) {
+            state.s[i] = deriveSeed(seed, static_cast<uint64_t>(i));
+        }
+    }
+    
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    
+    /**
+     * Draw the next 64 random bits
+     */
+    result_type operator()() {
+        uint64_t* s = state.s;
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        
+        return result;
+    }
+    
+    /**
+     * Draw a uniformly distributed integer in [0, bound)
+     * Uses the same result on every platform for a given seed
+     * 
+     * @param bound Exclusive upper bound (must be > 0)
+     * @return Value in [0, bound)
+     */
+    int nextInt(int bound) {
+        // Multiply-shift range reduction on the top 32 bits
+        uint64_t bits = (*this)() >> 32;
+        return static_cast<int>((bits * static_cast<uint64_t>(bound)) >> 32);
+    }
+    
+    /**
+     * Snapshot of the generator state (e.g., to replay from a given turn)
+     */
+    State getState() const { return state; }
+    
+    /**
+     * Restore a state previously returned by getState()
+     */
+    void setState(const State& saved) { state = saved; }
+    
+    /**
+     * Derive an independent seed for sub-stream `index` of a base seed
+     * Used to give every battle in a batch its own reproducible seed
+     * 
+     * @param seed Base seed
+     * @param index Stream index (e.g., battle number)
+     * @return Well-mixed 64-bit seed
+     */
+    static uint64_t deriveSeed(uint64_t seed, uint64_t index) {
+        // SplitMix64 finalizer over the combined value
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (index + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif // BATTLE_RNG_H
@@ -0,0 +1,106 @@
+#ifndef BATTLE_SIMULATOR_H
+#define BATTLE_SIMULATOR_H
+
+#include "BattleArena.h"
+#include "Pokemon.h"
+#include "BattleEvent.h"
+#include "DecisionPolicy.h"
+#include <cstdint>
+#include <vector>
+
+class ReplayLogWriter;
+
+/**
+ * SimulationResult Struct
+ * 
+ * Aggregate statistics over a batch of simulated battles of one matchup.
+ * Side 0 is the first Pokemon passed to the simulator, side 1 the second.
+ */
+struct SimulationResult {
+    int battles = 0;                        // Number of battles simulated
+    int wins[2] = {0, 0};                   // Battles won by each side
+    std::vector<int> turnHistogram;         // turnHistogram[t] = battles that ended on turn t
+    double averageRemainingHP[2] = {0, 0};  // Mean HP left at the end of a battle, per side
+    
+    /**
+     * Fraction of battles won by a side (0.0 - 1.0)
+     */
+    double winRate(int side) const { return battles > 0 ? static_cast<double>(wins[side]) / battles : 0.0; }
+    
+    /**
+     * Mean battle length in turns
+     */
+    double averageTurns() const;
+};
+
+/**
+ * BattleSimulator Class
+ * 
+ * Headless Monte-Carlo runner for a single matchup.
+ * Runs N independent battles with all battle events discarded and collects
+ * win rates, turn counts and remaining HP. The simulator plays on its own
+ * copies of the Pokemon passed to the constructor, kept in a BattleArena
+ * and reset before every battle, so the originals are never modified,
+ * nothing is allocated per battle, and separate simulators can run on
+ * separate threads.
+ * 
+ * When both Pokemon only have moves with the built-in damage formula and
+ * no replay log is written or policy set, battles are played in lockstep
+ * by a BattleBatch, which gives the same results much faster.
+ * 
+ * Python skill output is not affected; silence it with
+ * PythonSkillLoader::setScriptOutputEnabled(false) when simulating.
+ */
+class BattleSimulator {
+private:
+    BattleArena arena;      // Both Pokemon (slots 0 and 1), reset before every battle
+    NullEventSink events;   // Discards battle events; nothing is formatted
+    DecisionPolicy* policies[2];    // Move choice of each side (nullptr = random)
+    
+    // Battles per BattleBatch when the moves allow batching
+    static const int kBatchSize = 4096;
+    
+public:
+    /**
+     * Constructor
+     * 
+     * @param p1 First Pokemon (side 0); copied, including its moveset
+     * @param p2 Second Pokemon (side 1); copied, including its moveset
+     */
+    BattleSimulator(const Pokemon& p1, const Pokemon& p2);
+    
+    /**
+     * Choose how each side picks its moves (see Battle::setPolicies())
+     * Policies are used for every battle of the following runs, in order,
+     * so a policy with a cache carries it from battle to battle.
+     * 
+     * @param policy1 Policy of side 0 (nullptr = random); must outlive the runs
+     * @param policy2 Policy of side 1 (nullptr = random); must outlive the runs
+     */
+    void setPolicies(DecisionPolicy* policy1, DecisionPolicy* policy2) {
+        policies[0] = policy1;
+        policies[1] = policy2;
+    }
+    
+    /**
+     * Run a batch of independent battles with a nondeterministic seed
+     * 
+     * @param battles Number of battles to simulate
+     * @return Aggregate statistics for the batch
+     */
+    SimulationResult run(int battles);
+    
+    /**
+     * Run a reproducible batch of independent battles
+     * Battle i is seeded with BattleRng::deriveSeed(seed, i), so the same
+     * seed always yields the same result
+     * 
+     * @param battles Number of battles to simulate
+     * @param seed Base seed for the batch
+     * @param log Optional replay log every battle is appended to
+     * @return Aggregate statistics for the batch
+     */
+    SimulationResult run(int battles, uint64_t seed, ReplayLogWriter* log = nullptr);
+};
+
+#endif // BATTLE_SIMULATOR_H
@@ -0,0 +1,63 @@
+#ifndef BINARY_EVENT_SINK_H
+#define BINARY_EVENT_SINK_H
+
+#include "BattleEvent.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * BinaryEventRecord Struct
+ *
+ * Fixed-size (16-byte) encoding of a BattleEvent. Pokemon are stored as
+ * their side in the battle (0 = first, 1 = second) and moves as their
+ * index in the acting Pokemon's moveset; kNone marks an unused field.
+ */
+struct BinaryEventRecord {
+    static const uint8_t kNone = 0xFF;
+
+    uint8_t type;           // BattleEventType
+    uint8_t actor;          // Side of the actor, or kNone
+    uint8_t target;         // Side of the target, or kNone
+    uint8_t move;           // Index in the actor's moveset, or kNone
+    uint8_t status;         // StatusEffect
+    uint8_t reserved[3];    // Padding, always zero
+    int32_t value;          // BattleEvent::value
+    float multiplier;       // BattleEvent::multiplier
+};
+
+/**
+ * BinaryEventSink Class
+ *
+ * Records battle events as compact BinaryEventRecords for storage or later
+ * analysis. The two participants are registered from the BATTLE_START
+ * event; a sink can record several battles one after another. In a
+ * TeamBattle only the leads are registered, so Pokemon sent in later are
+ * recorded with kNone sides.
+ */
+class BinaryEventSink : public BattleEventSink {
+private:
+    const Pokemon* participants[2];         // Sides of the battle being recorded
+    std::vector<BinaryEventRecord> records; // Recorded events, in order
+
+    /**
+     * Side of a Pokemon in the current battle, or kNone
+     */
+    uint8_t sideOf(const Pokemon* pokemon) const;
+
+public:
+    BinaryEventSink();
+
+    void onEvent(const BattleEvent& event) override;
+
+    /**
+     * All events recorded so far
+     */
+    const std::vector<BinaryEventRecord>& getRecords() const { return records; }
+
+    /**
+     * Discard recorded events
+     */
+    void clear() { records.clear(); }
+};
+
+#endif // BINARY_EVENT_SINK_H
@@ -0,0 +1,96 @@
+#ifndef DAMAGE_KERNEL_H
+#define DAMAGE_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * DamageKernel Class
+ *
+ * Vectorized version of Move's built-in damage path for arrays of hits:
+ * the accuracy roll, the default effect function and the type multiplier
+ * applied by Move::execute().
+ *
+ *   damage = roll < accuracy && power != 0
+ *          ? int(max(1, attack * power / (defense * 2)) * effectiveness)
+ *          : 0
+ *
+ * The instruction set is picked at runtime (AVX2, then SSE2, then plain
+ * C++). Every implementation gives bit-identical results: the integer
+ * division is done in double precision, which is exact for quotients of
+ * 32-bit integers once truncated, and the multiplier is applied to the
+ * same double value as in Move::execute().
+ *
+ * Usage:
+ *   DamageKernel::computeDamage(count, attack, defense, power, accuracy, rolls, effectiveness, damage);
+ */
+class DamageKernel {
+public:
+    /**
+     * Implementations, from slowest to fastest
+     */
+    enum class Isa : uint8_t {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * Whether the CPU (and the build) can run an implementation
+     */
+    static bool isSupported(Isa isa);
+
+    /**
+     * Fastest supported implementation, detected once
+     */
+    static Isa getBestIsa();
+
+    /**
+     * Implementation currently used (getBestIsa() unless overridden)
+     */
+    static Isa getIsa();
+
+    /**
+     * Force an implementation (e.g. to compare them in benchmarks)
+     *
+     * @throws std::invalid_argument if the implementation is not supported
+     */
+    static void setIsa(Isa isa);
+
+    /**
+     * Display name of an implementation ("AVX2", ...)
+     */
+    static const char* isaName(Isa isa);
+
+    /**
+     * Damage of a batch of hits
+     *
+     * Every defense must be positive, as for Move (a missed hit may still
+     * use any positive placeholder).
+     *
+     * @param count Number of hits
+     * @param attack Attacker's attack per hit
+     * @param defense Defender's defense or special defense per hit
+     * @param power Move power per hit (0 = status move, no damage)
+     * @param accuracy Move accuracy per hit
+     * @param rolls Accuracy roll per hit, as drawn by Move::execute() (rng.nextInt(100))
+     * @param effectiveness Type multiplier per hit
+     * @param damage Receives the damage per hit (0 on a miss)
+     */
+    static void computeDamage(size_t count, const int32_t* attack, const int32_t* defense,
+                              const int32_t* power, const int32_t* accuracy, const int32_t* rolls,
+                              const double* effectiveness, int32_t* damage);
+
+    /**
+     * Type multipliers of a batch of hits, from the TypeEffectiveness chart
+     *
+     * @param count Number of hits
+     * @param attackTypes Move type per hit (PokemonType values)
+     * @param defenseTypes Defender type per hit (PokemonType values)
+     * @param effectiveness Receives the multiplier per hit
+     */
+    static void lookupEffectiveness(size_t count, const uint8_t* attackTypes, const uint8_t* defenseTypes,
+                                    double* effectiveness);
+};
+
+#endif // DAMAGE_KERNEL_H
@@ -0,0 +1,110 @@
+#ifndef DAMAGE_TABLE_H
+#define DAMAGE_TABLE_H
+
+#include "NativeSkill.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class Pokemon;
+class Move;
+class BattleRng;
+
+/**
+ * DamageTable Class
+ *
+ * Precomputed damage distributions of one Python skill over the stat
+ * profiles of a roster, so Move::execute() draws damage from a table
+ * instead of calling the interpreter.
+ *
+ * A profile is the static stats a script sees: max_hp, attack, defense,
+ * special_defense and speed. Only scripts that set PRECOMPILE = True are
+ * tabulated; they declare that nothing else (current_hp, name) affects
+ * the result. For every ordered pair of profiles the table stores the
+ * distribution the script declares with damage_distribution(), or, if it
+ * declares none, the frequencies of `samples` live calls (one SkillBatch,
+ * so a calculate_damage_batch() function evaluates them in one call).
+ *
+ * Draws: a single-outcome entry returns its value without touching the
+ * generator, so deterministic scripts give the same battles as live
+ * calls. Otherwise one 32-bit draw picks the outcome: damage follows the
+ * script's distribution, but the random stream differs from the script's
+ * own random.randint() calls. Nothing is printed.
+ *
+ * Tables are immutable once built and may be shared between threads.
+ *
+ * Usage:
+ *   DamageTable::precompile(arena.getPokemon());  // every eligible move
+ *   // --verify-tables N compares tables against live script calls
+ */
+class DamageTable {
+private:
+    std::unordered_map<uint64_t, uint32_t> profiles;   // Packed stats -> profile index
+    size_t profileCount;
+    std::vector<uint32_t> offsets;      // Per (attacker, defender) profile pair: first outcome (+1 sentinel)
+    std::vector<int32_t> damage;        // Outcomes of all pairs, ascending per pair
+    std::vector<uint32_t> thresholds;   // Cumulative probability * 2^32 (last outcome of a pair: unused)
+    std::vector<double> probabilities;  // Probability of each outcome
+    size_t sampledPairs;                // Pairs built from live calls (no damage_distribution)
+
+    /**
+     * Pack a Pokemon's static stats (false if one is outside 0..4095)
+     */
+    static bool pack(const Pokemon& pokemon, uint64_t& key);
+
+    /**
+     * First outcome of the pair of two Pokemon's profiles (false if either is not in the table)
+     */
+    bool find(const Pokemon& attacker, const Pokemon& defender, size_t& first, size_t& last) const;
+
+public:
+    DamageTable() : profileCount(0), sampledPairs(0) {}
+
+    /**
+     * Tabulate a move's script skill over the profiles of a roster
+     *
+     * @param move Move with a SCRIPT effect whose script is eligible
+     *        (PythonSkillLoader::isPrecompilable())
+     * @param roster Pokemon whose profiles make up the table
+     * @param samples Live calls per pair for scripts without damage_distribution()
+     * @param seed Random stream of those calls
+     * @throws std::invalid_argument if the move has no eligible script skill
+     */
+    static DamageTable build(const Move& move, const std::vector<Pokemon>& roster, int samples = 4096, uint64_t seed = 0);
+
+    /**
+     * Build tables for every registered move used by the roster whose
+     * script is eligible, and switch those moves to them
+     * (MoveRegistry::setDamageTable()). Call while setting up.
+     *
+     * @return Number of moves now using a table
+     */
+    static size_t precompile(const std::vector<Pokemon>& roster, int samples = 4096, uint64_t seed = 0);
+
+    /**
+     * Draw damage for a hit
+     *
+     * @return false (and no draw) if either Pokemon's profile is not in the table
+     */
+    bool draw(const Pokemon& attacker, const Pokemon& defender, BattleRng& rng, int& result) const;
+
+    /**
+     * Stored distribution of a pair
+     *
+     * @return false if either Pokemon's profile is not in the table
+     */
+    bool distribution(const Pokemon& attacker, const Pokemon& defender, DamageDistribution& outcomes) const;
+
+    size_t getProfileCount() const { return profileCount; }
+    size_t getOutcomeCount() const { return damage.size(); }
+    size_t getSampledPairs() const { return sampledPairs; }
+
+    /**
+     * Approximate heap size of the table, in bytes
+     */
+    size_t memoryBytes() const;
+};
+
+#endif // DAMAGE_TABLE_H
@@ -0,0 +1,80 @@
+#ifndef DECISION_POLICY_H
+#define DECISION_POLICY_H
+
+#include "BattleRng.h"
+#include "Pokemon.h"
+#include "Team.h"
+
+/**
+ * DecisionPolicy Class
+ *
+ * Chooses the move a Pokemon uses on its action. A Battle asks the policy
+ * of each side (see Battle::setPolicies()); without one it picks a move
+ * uniformly at random from the battle's generator. A TeamBattle also asks
+ * it about switching; the defaults never switch voluntarily and replace a
+ * fainted Pokemon with the first healthy one in party order.
+ *
+ * A policy may keep state between decisions (e.g. a search cache), so
+ * give each running battle, or each thread, its own instance.
+ */
+class DecisionPolicy {
+public:
+    virtual ~DecisionPolicy() = default;
+
+    /**
+     * Choose a move for the Pokemon about to act
+     *
+     * @param self Pokemon choosing (its state is the current one)
+     * @param opponent The other Pokemon
+     * @param movesFirst Whether self acts first in each turn (the opponent
+     *                   has already acted this turn if not)
+     * @param rng The battle's generator, for policies that draw from it;
+     *            draws change the rest of the battle
+     * @return Move slot (0-based; out of range falls back to slot 0)
+     */
+    virtual int chooseMove(const Pokemon& self, const Pokemon& opponent, bool movesFirst, BattleRng& rng) = 0;
+
+    /**
+     * Choose whether to switch instead of moving this turn (TeamBattle
+     * only; asked at the start of each turn while the bench has a healthy
+     * Pokemon)
+     *
+     * @param team Own party; team.active() is the Pokemon in battle
+     * @param opponent The opposing Pokemon in battle
+     * @param rng The battle's generator
+     * @return Party slot to send in, or -1 to use a move (slots that
+     *         cannot be sent in also mean a move)
+     */
+    virtual int chooseSwitch(const Team& /*team*/, const Pokemon& /*opponent*/, BattleRng& /*rng*/) {
+        return -1;
+    }
+
+    /**
+     * Choose the Pokemon sent in after the active one fainted (TeamBattle
+     * only; asked only while the bench has a healthy Pokemon)
+     *
+     * @param team Own party; team.active() is the fainted Pokemon
+     * @param opponent The opposing Pokemon in battle
+     * @param rng The battle's generator
+     * @return Party slot to send in (slots that cannot be sent in fall back
+     *         to the first healthy Pokemon in party order)
+     */
+    virtual int chooseReplacement(const Team& team, const Pokemon& /*opponent*/, BattleRng& /*rng*/) {
+        return static_cast<int>(team.firstBenchSlot());
+    }
+};
+
+/**
+ * RandomPolicy Class
+ *
+ * Uniformly random move from the battle's generator: the same choice, and
+ * the same draw, as a Battle without a policy.
+ */
+class RandomPolicy : public DecisionPolicy {
+public:
+    int chooseMove(const Pokemon& self, const Pokemon&, bool, BattleRng& rng) override {
+        return rng.nextInt(static_cast<int>(self.getMoveCount()));
+    }
+};
+
+#endif // DECISION_POLICY_H
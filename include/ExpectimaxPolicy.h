@@ -0,0 +1,113 @@
+#ifndef EXPECTIMAX_POLICY_H
+#define EXPECTIMAX_POLICY_H
+
+#include "BattleEvent.h"
+#include "DecisionPolicy.h"
+#include "Pokemon.h"
+#include "TranspositionTable.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * ExpectimaxPolicy Class
+ *
+ * Move choice by expectimax search over the battle engine. The search
+ * plays actions on its own copies of both Pokemon with
+ * Battle::executeTurn(), so it follows exactly the rules (and skills) of
+ * real battles, and restores them between branches with flat
+ * PokemonState copies.
+ *
+ * Each ply is one action:
+ * - the searching Pokemon takes the move with the best expected value;
+ * - the opponent is assumed to pick uniformly at random, as a Battle
+ *   without a policy does, so its moves are averaged;
+ * - the randomness of an action (accuracy, damage rolls, status) is
+ *   averaged over a few sampled outcomes, each from a generator seeded
+ *   by the state, move and sample number.
+ * A won battle is worth 1, a lost one -1, and a position at the depth
+ * limit its HP fraction difference.
+ *
+ * Values are cached in a TranspositionTable keyed on the HP and status of
+ * both Pokemon, kept across decisions and battles of the same matchup.
+ * The search deepens one ply at a time up to the maximum depth; with a
+ * time budget it stops when the budget runs out and uses the deepest
+ * completed search. Without a budget the choice only depends on the
+ * state (and on what the table already holds), so battles replay from
+ * their seed; with one it also depends on machine speed.
+ *
+ * Python skills run inside the search like in battles; their output is
+ * silenced while searching.
+ *
+ * Usage:
+ *   ExpectimaxPolicy ai;
+ *   battle.setPolicies(&ai, nullptr);   // Pokemon 1 searches, Pokemon 2 plays randomly
+ */
+class ExpectimaxPolicy : public DecisionPolicy {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    int maxDepth;                   // Plies searched (each Pokemon's action is one ply)
+    int samples;                    // Outcomes sampled per action
+    double timeBudget;              // Seconds per decision (0 = always search maxDepth)
+    TranspositionTable table;       // Values of searched states
+    NullEventSink events;           // Search actions are not observed
+
+    uint64_t matchup;               // Fingerprint of the Pokemon the table is for
+    std::vector<Pokemon> sides;     // Search copies: [0] acts first in each turn
+    int self;                       // Index of the searching Pokemon in sides
+
+    Clock::time_point deadline;     // End of the current decision's budget
+    bool timed;                     // Whether the deadline applies (not at depth 1)
+    bool aborted;                   // The deadline passed during this iteration
+    size_t nodes;                   // States expanded in the current decision
+    int lastDepth;                  // Depth of the last decision's result
+
+    /**
+     * Expected value of playing move on the state (sampled outcomes)
+     */
+    double expectedValue(int actor, int move, int depth, uint64_t key);
+
+    /**
+     * Value of the current search state for the searching Pokemon
+     *
+     * @param actor Pokemon acting next (index in sides)
+     * @param depth Plies left
+     */
+    double value(int actor, int depth);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param maxDepth Plies to search (default 4: two full turns)
+     * @param samples Outcomes sampled per action
+     * @param timeBudget Seconds per decision, 0 for no limit
+     * @param tableSize Transposition table slots
+     */
+    explicit ExpectimaxPolicy(int maxDepth = 4, int samples = 4, double timeBudget = 0.0,
+                              size_t tableSize = 1 << 16);
+
+    int chooseMove(const Pokemon& self, const Pokemon& opponent, bool movesFirst, BattleRng& rng) override;
+
+    /**
+     * Forget cached values (e.g. after changing skills)
+     */
+    void clear();
+
+    /**
+     * Depth of the search behind the last decision (below maxDepth if the
+     * time budget ran out; 0 if there was nothing to choose)
+     */
+    int getLastDepth() const { return lastDepth; }
+
+    /**
+     * States expanded for the last decision
+     */
+    size_t getLastNodeCount() const { return nodes; }
+
+    const TranspositionTable& getTable() const { return table; }
+};
+
+#endif // EXPECTIMAX_POLICY_H
@@ -0,0 +1,150 @@
+#ifndef GAME_DATA_H
+#define GAME_DATA_H
+
+#include "Move.h"
+#include "Pokemon.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Game Data Files
+ *
+ * Species and moves are defined in two CSV files (one header row; blank
+ * lines and lines starting with '#' are ignored; fields cannot contain
+ * commas):
+ *
+ *   species.csv  name,type,hp,attack,defense,special_defense,speed,moves
+ *                moves: move names separated by ';'
+ *   moves.csv    name,type,category,power,accuracy,script,status,status_duration
+ *                category: Physical, Special or Status
+ *                script: Python script file (empty for the built-in formula)
+ *                status: status effect name (empty for none)
+ *
+ * Parsed data is compiled into a binary cache next to them. The cache is
+ * a fixed header, the species and move record arrays, the learnset
+ * array and a string table, in the host's layout, so it is used in place
+ * through a read-only memory mapping. The header stores a hash of both
+ * CSV files; a cache whose hash, version or size does not match is
+ * rebuilt.
+ */
+
+/**
+ * GameData Class
+ *
+ * Species and move database loaded from the data files, through the
+ * binary cache. Starting with a valid cache only hashes the CSV files and
+ * maps the cache: nothing is parsed, and no Move or Pokemon is built until
+ * it is asked for.
+ *
+ * Moves are added to the MoveRegistry the first time a species that
+ * knows them is created, and their scripts are bound with
+ * PythonSkillLoader::deferSkill(), so a script is only imported when its
+ * move is first used in battle.
+ *
+ * Usage:
+ *   GameData data("data/species.csv", "data/moves.csv", "data/gamedata.cache");
+ *   Pokemon pikachu = data.createPokemon("Pikachu");
+ *
+ * Create species during setup, before battles start (see MoveRegistry).
+ */
+class GameData {
+private:
+    const unsigned char* data;      // Cache contents (mapping or built)
+    size_t size;                    // Cache size in bytes
+    void* mapping;                  // Memory mapping of the cache file (nullptr if built in memory)
+    std::string built;              // Cache built in memory when it could not be mapped
+    bool cacheHit;                  // Loaded from a valid cache file
+    std::vector<MoveId> moveIds;    // Registry id per move record (kUnregistered until first use)
+
+    /**
+     * Parse the CSV files into a cache image
+     */
+    static std::string compile(const std::string& speciesPath, const std::string& speciesText,
+                               const std::string& movesPath, const std::string& movesText, uint64_t sourceHash);
+
+    /**
+     * Whether a cache image is complete and matches the sources
+     */
+    static bool isValid(const unsigned char* bytes, size_t length, uint64_t sourceHash);
+
+    /**
+     * Map a cache file read-only; false if missing or invalid
+     */
+    bool mapCache(const std::string& cachePath, uint64_t sourceHash);
+
+    /**
+     * String table entry
+     */
+    const char* stringAt(uint32_t offset) const;
+
+public:
+    /**
+     * Load the data files, through the cache
+     *
+     * @param speciesPath Species CSV file
+     * @param movesPath Moves CSV file
+     * @param cachePath Binary cache, written if missing or stale (empty = no cache file)
+     * @throws std::runtime_error if a data file is missing or malformed
+     * @throws std::invalid_argument if a type, category or status name is unknown
+     */
+    GameData(const std::string& speciesPath, const std::string& movesPath, const std::string& cachePath);
+
+    ~GameData();
+
+    GameData(const GameData&) = delete;
+    GameData& operator=(const GameData&) = delete;
+
+    /**
+     * Whether the data came from an up-to-date cache file (no parsing)
+     */
+    bool isCacheHit() const { return cacheHit; }
+
+    size_t getSpeciesCount() const;
+    size_t getMoveCount() const;
+
+    /**
+     * Species or move name by index (file order)
+     */
+    const char* getSpeciesName(size_t index) const;
+    const char* getMoveName(size_t index) const;
+
+    /**
+     * Index of a species or move by name, or -1 if there is none
+     */
+    int findSpecies(const std::string& name) const;
+    int findMove(const std::string& name) const;
+
+    /**
+     * Build a move (not registered; its script, if any, is deferred)
+     * With Python disabled (PythonSkillLoader::setPythonEnabled()) a
+     * scripted move gets its native skill (registered or declared by the
+     * script), or else keeps the built-in damage formula.
+     *
+     * @param index Move index
+     */
+    Move createMove(size_t index) const;
+
+    /**
+     * Registry id of a move, registering it on first use
+     *
+     * @param index Move index
+     */
+    MoveId getMoveId(size_t index);
+
+    /**
+     * Build a Pokemon of a species at full HP with its learnset
+     *
+     * @param species Species name
+     * @throws std::invalid_argument if there is no such species
+     */
+    Pokemon createPokemon(const std::string& species);
+
+    /**
+     * FNV-1a hash used to validate the cache against its sources
+     */
+    static uint64_t hash(const std::string& bytes, uint64_t seed = 14695981039346656037ULL);
+};
+
+#endif // GAME_DATA_H
@@ -0,0 +1,218 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#if defined(POKEMON_INSTRUMENT) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INSTRUMENTATION_RDTSC 1
+#include <x86intrin.h>
+#endif
+
+/**
+ * Probe Enumeration
+ *
+ * Timed phases of an action. Nested probes are timed separately, so
+ * ACTION includes all the others and EFFECT includes PYTHON_CALL.
+ * SKILL_SETUP is the exception: its time is taken out of every probe it
+ * runs inside, so a move's first use does not carry the interpreter start.
+ */
+enum class Probe : uint8_t {
+    ACTION,         // Battle::executeTurn(): one Pokemon's whole action
+    ACCURACY_ROLL,  // Move::execute(): the hit/miss roll
+    EFFECT,         // Move::calculateDamage(): built-in, native, Python or C++ effect
+    EFFECTIVENESS,  // Move::execute(): type effectiveness lookup
+    STATUS_TICK,    // Battle::executeTurn(): end-of-turn status update and drain
+    PYTHON_CALL,    // PythonSkillLoader: one call into the interpreter (GIL already held)
+    SKILL_SETUP,    // PythonSkillLoader: one-time skill resolution, script import or interpreter start
+    COUNT           // Number of probes (not a probe)
+};
+
+/**
+ * Instrumentation Class
+ *
+ * Optional counters and timers on the battle hot path, for finding out
+ * where action time goes and whether a move's cost is Python or C++.
+ *
+ * Built only with the POKEMON_INSTRUMENT CMake option. Without it the
+ * POKEMON_PROBE macros expand to nothing, so the engine is unchanged, and
+ * report() says the build has no probes.
+ *
+ * Each thread counts into its own block, with no locking or atomics on the
+ * hot path. Blocks of finished threads are merged into a global total, so
+ * a Tournament's workers are included once their pool has stopped. Read
+ * results when no instrumented code is running.
+ *
+ * Times come from the time-stamp counter on x86 (converted to nanoseconds
+ * against steady_clock) and from steady_clock elsewhere. A probe costs a
+ * few tens of cycles, so short phases (the accuracy roll) are dominated by
+ * it; compare them between runs rather than trusting their absolute values.
+ * BattleBatch does not go through the probed functions.
+ *
+ * Usage (with -DPOKEMON_INSTRUMENT=ON):
+ *   runSimulations(...);
+ *   Instrumentation::report(std::cerr);     // or writeJson()
+ */
+class Instrumentation {
+public:
+    /**
+     * Calls and total time of one probe
+     */
+    struct Counter {
+        uint64_t calls = 0;
+        uint64_t ticks = 0;
+    };
+
+    /**
+     * Counters of one thread, or summed over threads
+     */
+    struct Counters {
+        Counter probes[static_cast<int>(Probe::COUNT)];
+        std::vector<Counter> moveEffects;   // EFFECT per MoveId
+        std::vector<Counter> movePython;    // PYTHON_CALL per MoveId (inside that move's effect)
+
+        void add(const Counters& other);
+    };
+
+    /**
+     * A thread's counters; registered while the thread lives, merged into
+     * the total when it ends
+     */
+    struct Block : Counters {
+        int currentMove = -1;               // MoveId whose effect is running (-1 = none)
+        uint64_t setupTicks = 0;            // SKILL_SETUP time so far, taken out of enclosing probes
+
+        Block();
+        ~Block();
+    };
+
+    /**
+     * Whether probes are compiled in
+     */
+    static constexpr bool enabled() {
+#ifdef POKEMON_INSTRUMENT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Current timer value (TSC ticks or steady_clock nanoseconds)
+     */
+    static uint64_t now() {
+#ifdef INSTRUMENTATION_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * The calling thread's block
+     */
+    static Block& local() {
+        static thread_local Block block;
+        return block;
+    }
+
+    /**
+     * Sum of every thread's counters so far
+     */
+    static Counters total();
+
+    /**
+     * Nanoseconds per timer tick
+     */
+    static double nanosecondsPerTick();
+
+    /**
+     * Zero every counter (of all threads)
+     */
+    static void reset();
+
+    /**
+     * Summary table: time per probe, then per move with the Python share
+     */
+    static void report(std::ostream& out);
+
+    /**
+     * The same results as a JSON object
+     */
+    static void writeJson(std::ostream& out);
+
+    /**
+     * Times one probe for the lifetime of the scope, less any SKILL_SETUP
+     * time inside it; with a move, also charges the time to that move's
+     * effect and marks it as running so Python calls inside it are
+     * attributed to it
+     */
+    class Scope {
+    private:
+        Probe probe;
+        int move;
+        int outerMove;
+        uint64_t setupMark;
+        uint64_t start;
+
+    public:
+        explicit Scope(Probe probe, int move = -1)
+            : probe(probe), move(move), outerMove(-1), setupMark(local().setupTicks), start(now()) {
+            if (move >= 0) {
+                Block& block = local();
+                outerMove = block.currentMove;
+                block.currentMove = move;
+            }
+        }
+
+        ~Scope() {
+            uint64_t elapsed = now() - start;
+            Block& block = local();
+            elapsed -= std::min(elapsed, block.setupTicks - setupMark);
+            if (probe == Probe::SKILL_SETUP) {
+                block.setupTicks += elapsed;
+            }
+            Counter& counter = block.probes[static_cast<int>(probe)];
+            counter.calls++;
+            counter.ticks += elapsed;
+
+            int attributed = move >= 0 ? move : (probe == Probe::PYTHON_CALL ? block.currentMove : -1);
+            if (attributed >= 0) {
+                std::vector<Counter>& perMove = (move >= 0) ? block.moveEffects : block.movePython;
+                if (perMove.size() <= static_cast<size_t>(attributed)) {
+                    perMove.resize(attributed + 1);
+                }
+                perMove[attributed].calls++;
+                perMove[attributed].ticks += elapsed;
+            }
+            if (move >= 0) {
+                block.currentMove = outerMove;
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+#define POKEMON_PROBE_JOIN2(a, b) a##b
+#define POKEMON_PROBE_JOIN(a, b) POKEMON_PROBE_JOIN2(a, b)
+
+#ifdef POKEMON_INSTRUMENT
+// Time the rest of the enclosing scope as probe (a Probe value)
+#define POKEMON_PROBE(probe) \
+    Instrumentation::Scope POKEMON_PROBE_JOIN(instrumentationScope, __LINE__)(Probe::probe)
+// Same, charged to a move (its MoveId)
+#define POKEMON_PROBE_MOVE(probe, moveId) \
+    Instrumentation::Scope POKEMON_PROBE_JOIN(instrumentationScope, __LINE__)(Probe::probe, static_cast<int>(moveId))
+#else
+#define POKEMON_PROBE(probe) ((void)0)
+#define POKEMON_PROBE_MOVE(probe, moveId) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,164 @@
+#ifndef MATCHUP_SOLVER_H
+#define MATCHUP_SOLVER_H
+
+#include "Pokemon.h"
+#include "NativeSkill.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * SolverResult Struct
+ *
+ * Exact outcome of a 1v1 matchup under random move choice.
+ * Side 0 is the first Pokemon passed to the solver, side 1 the second.
+ */
+struct SolverResult {
+    double winProbability[2] = {0, 0};  // Probability that each side wins
+    double expectedTurns = 0;           // Mean battle length in turns
+    size_t states = 0;                  // Battle states reachable from the start
+    size_t largestCycle = 0;            // States in the largest set solved as one linear system
+
+    double winRate(int side) const { return winProbability[side]; }
+};
+
+/**
+ * MatchupSolver Class
+ *
+ * Exact win probabilities and expected length of a battle between two
+ * Pokemon that both pick their moves uniformly at random, as a Battle
+ * without policies does. An alternative to sampling battles with a
+ * BattleSimulator: the result has no sampling error.
+ *
+ * A battle is a finite Markov chain. Its state is the HP, status and
+ * status duration of both Pokemon and which one acts next; each action
+ * moves to a new state with probabilities given by the battle rules:
+ * - move choice (uniform over the moveset);
+ * - the status skip chance and self-hit (Battle::executeTurn());
+ * - accuracy, damage, type effectiveness, healing and status application
+ *   (Move::execute()), with every possible damage value from
+ *   Move::damageDistribution();
+ * - end-of-turn status damage and Leech Seed drain (Pokemon::updateStatus()).
+ * The solver explores the states reachable from the Pokemon's current
+ * states and memoizes the win probability and expected turns of each.
+ *
+ * States can repeat (misses, moves without damage, statuses wearing off,
+ * healing). Each set of states that can reach each other is solved as one
+ * linear system, in the order Tarjan's algorithm completes them, so the
+ * result is exact for any battle; sets larger than maxCycleStates are
+ * rejected instead of solved.
+ *
+ * Moves must declare their damage distribution: the built-in formula and
+ * native skills always do; Python skills through NATIVE_SKILL or a
+ * damage_distribution() function (see docs/PYTHON_SKILLS.md). Probabilities
+ * are those of the rules; the generator's range reduction adds a bias below
+ * 2^-32 that is ignored.
+ *
+ * Usage:
+ *   MatchupSolver solver(pikachu, squirtle);
+ *   SolverResult result = solver.solve();
+ *   // result.winRate(0), result.expectedTurns
+ */
+class MatchupSolver {
+private:
+    // Successor of a state with the probability of reaching it
+    struct Transition {
+        uint32_t target;
+        double probability;
+    };
+
+    // One reachable state
+    struct Node {
+        uint64_t key;                       // Packed state (see pack())
+        std::vector<Transition> transitions; // Non-final successors (kept until the node is solved)
+        double winConstant = 0;             // Probability of ending in one action with side 0 winning
+        int index = -1;                     // Tarjan visit order (-1 = not visited)
+        int lowlink = 0;                    // Lowest index reachable on the Tarjan stack
+        bool onStack = false;
+        double win = 0;                     // Solved: probability that side 0 wins
+        double turns = 0;                   // Solved: expected turns to the end
+    };
+
+    std::vector<Pokemon> sides;     // Solver copies: [0] acts first in each turn
+    PokemonState initial[2];        // States of sides[] to solve from
+    int firstSide;                  // Side (0 or 1) of sides[0]
+    size_t maxCycleStates;          // Largest set of states solved as one system
+
+    std::vector<Node> nodes;
+    std::unordered_map<uint64_t, uint32_t> ids;     // Packed state -> node
+
+    // Damage distributions per (actor, move, attacker HP, defender HP):
+    // skills only see stats and HP, so they depend on nothing else
+    std::unordered_map<uint64_t, DamageDistribution> distributions;
+
+    size_t largestCycle;
+
+    /**
+     * Pack both Pokemon states and the acting one into a key
+     * (inverse: unpack())
+     */
+    static uint64_t pack(const PokemonState& first, const PokemonState& second, int actor);
+    static void unpack(uint64_t key, PokemonState& first, PokemonState& second, int& actor);
+
+    /**
+     * Node of a state, created unvisited if new
+     */
+    uint32_t intern(uint64_t key);
+
+    /**
+     * Damage distribution of a move, cached
+     * @throws std::invalid_argument if the move declares none
+     */
+    const DamageDistribution& distribution(int actor, int move);
+
+    /**
+     * Add the outcomes of one action (Battle::executeTurn() with a random
+     * move) to a node; sides[] hold the state before it
+     */
+    void addAction(uint32_t node, int actor);
+
+    /**
+     * Record the state in sides[] after an action by actor as a successor
+     * of node (or as the end of the battle)
+     */
+    void addOutcome(uint32_t node, int actor, double probability);
+
+    /**
+     * Finish the end-of-action status tick of the actor, then record the outcome
+     */
+    void addStatusTick(uint32_t node, int actor, double probability);
+
+    /**
+     * Compute the transitions of a node
+     */
+    void expand(uint32_t node);
+
+    /**
+     * Solve a set of states that can reach each other (all their other
+     * successors are solved)
+     */
+    void solveComponent(const std::vector<uint32_t>& component);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param p1 First Pokemon (side 0); copied, in its current state
+     * @param p2 Second Pokemon (side 1); copied, in its current state
+     * @param maxCycleStates Largest set of mutually reachable states to solve
+     *        (dense elimination: time grows with its cube)
+     */
+    MatchupSolver(const Pokemon& p1, const Pokemon& p2, size_t maxCycleStates = 2048);
+
+    /**
+     * Solve the battle from the Pokemon's states
+     *
+     * @throws std::invalid_argument if a move declares no damage distribution
+     * @throws std::runtime_error if a set of repeating states exceeds
+     *         maxCycleStates, or the battle can go on forever
+     */
+    SolverResult solve();
+};
+
+#endif // MATCHUP_SOLVER_H
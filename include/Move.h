@@ -1,11 +1,19 @@
 #ifndef MOVE_H
 #define MOVE_H
 
+#include "NativeSkill.h"
+#include "StatusEffect.h"
+#include "TypeEffectiveness.h"
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <memory>
 
-// Forward declaration
+// Forward declarations
 class Pokemon;
+class BattleRng;
+class BattleEventSink;
+class DamageTable;
 
 /**
  * MoveCategory Enumeration
@@ -20,11 +28,39 @@ enum class MoveCategory {
     STATUS      // No direct damage, applies status effects or other effects
 };
 
+/**
+ * MoveEffect Enumeration
+ * 
+ * How a move computes its damage. Move::calculateDamage() switches on the
+ * tag, so the built-in formula and native skills are plain function calls.
+ */
+enum class MoveEffect : uint8_t {
+    DEFAULT,    // Built-in formula: max(1, attack * power / (defense * 2))
+    NATIVE,     // NativeSkillSpec formula (formula-only Python skills)
+    SCRIPT,     // Python function, by ScriptSkillId
+    FUNCTION,   // Any C++ callable set with setEffectFunction()
+    TABLE       // Precompiled DamageTable of a SCRIPT skill (the script outside the table)
+};
+
+/**
+ * Handle of a Python skill function registered with
+ * PythonSkillLoader::registerScriptSkill()
+ */
+typedef uint32_t ScriptSkillId;
+
+/**
+ * Index of a move in the MoveRegistry
+ */
+typedef uint16_t MoveId;
+
 /**
  * Move Class
  * 
  * Represents a battle move with damage calculation, accuracy, type, and effects.
  * Supports custom Python scripts for flexible damage calculation.
+ * 
+ * Moves are plain values: copying one copies its effect. Pokemon refer to
+ * moves by MoveId once they are stored in the MoveRegistry.
  */
 class Move {
 private:
@@ -32,19 +68,27 @@ private:
     std::string scriptPath;        // Path to Python script for custom effects
     int basePower;                 // Base power (0 for status moves)
     int accuracy;                  // Accuracy percentage (0-100)
-    std::string type;              // Move type (must match Pokemon types)
+    PokemonType type;              // Move type, parsed once from its name
     MoveCategory category;         // PHYSICAL, SPECIAL, or STATUS
-    std::string statusEffect;      // Status effect to apply (empty if none)
+    StatusEffect statusEffect;     // Status effect to apply (NONE if none)
     int statusDuration;            // Duration of status effect in turns
     
+    MoveId id;                     // Index in the MoveRegistry (kUnregistered until added)
+    
+    // Damage computation, selected by the effect tag; only the member of
+    // the active effect is used
+    MoveEffect effect;
+    NativeSkillSpec nativeSkill;   // NATIVE
+    ScriptSkillId scriptSkill;     // SCRIPT (and TABLE, outside the table)
+    std::shared_ptr<const DamageTable> damageTable;  // TABLE
+    std::function<int(Pokemon&, Pokemon&, BattleRng&)> effectFunction;  // FUNCTION
+    
     /**
-     * Function to execute Python skill script or default calculation
-     * Takes attacker and defender, returns damage amount
-     * - Positive: damage to defender
-     * - Negative: healing to attacker
-     * - Zero: status effect only
+     * Built-in damage formula (status moves deal no damage)
      */
-    std::function<int(Pokemon&, Pokemon&)> effectFunction;
+    int defaultDamage(const Pokemon& attacker, const Pokemon& defender) const;
+    
+    friend class MoveRegistry;
 
 public:
     /**
@@ -59,6 +103,7 @@ public:
      * @param cat Move category (PHYSICAL, SPECIAL, or STATUS)
      * @param status Status effect to apply (e.g., "Paralyzed", empty if none)
      * @param duration Duration of status effect in turns
+     * @throws std::invalid_argument if the type or status name is unknown
      */
     Move(const std::string& name, const std::string& scriptPath, 
          int power, int accuracy, const std::string& type, MoveCategory cat = MoveCategory::PHYSICAL,
@@ -69,36 +114,95 @@ public:
     std::string getName() const { return name; }
     int getBasePower() const { return basePower; }
     int getAccuracy() const { return accuracy; }
-    std::string getType() const { return type; }
+    std::string getType() const { return TypeEffectiveness::typeName(type); }
+    PokemonType getTypeId() const { return type; }
     MoveCategory getCategory() const { return category; }
     std::string getScriptPath() const { return scriptPath; }
-    std::string getStatusEffect() const { return statusEffect; }
+    StatusEffect getStatusEffect() const { return statusEffect; }
     int getStatusDuration() const { return statusDuration; }
+    MoveEffect getEffect() const { return effect; }
+    bool hasCustomEffect() const { return effect != MoveEffect::DEFAULT; }
+    MoveId getId() const { return id; }
+    ScriptSkillId getScriptSkill() const { return scriptSkill; }
+    const DamageTable* getDamageTable() const { return damageTable.get(); }
     
     // ===== Execution =====
     
+    /**
+     * Damage before type effectiveness, from the move's effect
+     * - Positive: damage to defender
+     * - Negative: healing to attacker
+     * - Zero: status effect only
+     * 
+     * @param attacker Pokemon using the move
+     * @param defender Pokemon being targeted
+     * @param rng Random source of the battle (for effects with randomness)
+     */
+    int calculateDamage(Pokemon& attacker, Pokemon& defender, BattleRng& rng) const;
+    
+    /**
+     * Every possible result of calculateDamage() with its probability, for
+     * exact analysis (see MatchupSolver)
+     * - DEFAULT: the single value of the formula
+     * - NATIVE: NativeSkill::damageDistribution()
+     * - SCRIPT: the native spec, or the script's damage_distribution()
+     *   (see PythonSkillLoader::damageDistribution())
+     * - FUNCTION: unknown
+     * - TABLE: the table's entry, else as SCRIPT
+     * 
+     * @param outcomes Receives the distribution
+     * @return false if the effect does not declare its distribution
+     */
+    bool damageDistribution(const Pokemon& attacker, const Pokemon& defender, DamageDistribution& outcomes) const;
+    
     /**
      * Execute the move in battle
      * 
      * Process:
      * 1. Check accuracy (may miss)
-     * 2. Calculate damage using effect function
+     * 2. Calculate damage using the move's effect
      * 3. Apply type effectiveness
      * 4. Deal damage or heal
      * 5. Apply status effect if applicable
      * 
      * @param attacker Pokemon using the move
      * @param defender Pokemon being targeted
+     * @param rng Random source of the battle (used for the accuracy roll)
+     * @param events Sink receiving the move's battle events
      * @return Damage dealt (0 if missed or status move, negative for healing)
      */
-    int execute(Pokemon& attacker, Pokemon& defender);
+    int execute(Pokemon& attacker, Pokemon& defender, BattleRng& rng, BattleEventSink& events) const;
+    
+    /**
+     * Compute damage with a native skill formula
+     * (see PythonSkillLoader::bindSkill())
+     */
+    void setNativeEffect(const NativeSkillSpec& spec);
+    
+    /**
+     * Compute damage with a registered Python function
+     * (see PythonSkillLoader::bindSkill())
+     */
+    void setScriptEffect(ScriptSkillId skill);
+    
+    /**
+     * Draw damage from a precompiled table of the move's script skill,
+     * calling the script for Pokemon outside the table
+     * (see DamageTable::precompile())
+     * 
+     * @throws std::logic_error if the move's effect is not SCRIPT or TABLE
+     */
+    void setTableEffect(std::shared_ptr<const DamageTable> table);
     
     /**
-     * Set custom effect function (typically loaded from Python script)
+     * Set custom effect function
+     * Prefer PythonSkillLoader::bindSkill() for Python skills; a callable
+     * is invoked through std::function on every hit
      * 
-     * @param func Function that calculates damage based on attacker/defender
+     * @param func Function that calculates damage based on attacker/defender;
+     *             any randomness must come from the BattleRng argument
      */
-    void setEffectFunction(std::function<int(Pokemon&, Pokemon&)> func);
+    void setEffectFunction(std::function<int(Pokemon&, Pokemon&, BattleRng&)> func);
 };
 
 #endif // MOVE_H
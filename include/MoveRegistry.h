@@ -0,0 +1,65 @@
+#ifndef MOVE_REGISTRY_H
+#define MOVE_REGISTRY_H
+
+#include "Move.h"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * MoveRegistry Class
+ *
+ * Owns every move used in battles, stored contiguously and addressed by a
+ * small MoveId. Pokemon keep MoveIds instead of pointers, so copying a
+ * Pokemon copies a few integers and using a move is an indexed load, with
+ * no reference counting.
+ *
+ * Register moves while setting up, before battles start: adding a move
+ * may reallocate the storage, so references from get() (and Move pointers
+ * in battle events) are only valid until the next add(). Lookups need no
+ * locking.
+ *
+ * Usage:
+ *   Move thunderbolt("Thunderbolt", "thunderbolt.py", 90, 100, "Electric", MoveCategory::SPECIAL);
+ *   PythonSkillLoader::bindSkill(thunderbolt, "thunderbolt");
+ *   MoveId id = MoveRegistry::add(thunderbolt);
+ *   pikachu->addMove(id);
+ */
+class MoveRegistry {
+private:
+    static std::vector<Move> moves;
+    static std::mutex mutex;       // Serializes add()
+
+public:
+    // MoveId of a Move that has not been added
+    static const MoveId kUnregistered = 0xFFFF;
+
+    /**
+     * Store a copy of a move
+     *
+     * @param move Move to store (its effect is copied with it)
+     * @return Id of the stored move
+     * @throws std::runtime_error if the registry is full (65535 moves)
+     */
+    static MoveId add(const Move& move);
+
+    /**
+     * Move by id
+     */
+    static const Move& get(MoveId id) { return moves[id]; }
+
+    /**
+     * Number of registered moves (ids are 0 .. size() - 1)
+     */
+    static size_t size() { return moves.size(); }
+
+    /**
+     * Switch a stored move to a precompiled damage table (setup only, like
+     * add(): not while battles run)
+     *
+     * @throws std::logic_error if the move has no script skill
+     */
+    static void setDamageTable(MoveId id, std::shared_ptr<const DamageTable> table);
+};
+
+#endif // MOVE_REGISTRY_H
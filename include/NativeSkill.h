@@ -0,0 +1,126 @@
+#ifndef NATIVE_SKILL_H
+#define NATIVE_SKILL_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class Pokemon;
+class BattleRng;
+class SkillBatch;
+
+/**
+ * Every possible damage value of a skill with its probability
+ * (probabilities sum to 1)
+ */
+typedef std::vector<std::pair<int, double>> DamageDistribution;
+
+/**
+ * NativeSkillSpec Struct
+ * 
+ * Declarative description of a skill built on the standard level-based
+ * damage formula:
+ * 
+ *   damage = int(((2 * level / 5 + 2) * power * attack / defense) / 50 + 2)
+ *   damage = int(damage * randint(randomMin, randomMax) / 100.0)
+ *   damage = int(damage * bonusMultiplier)   with bonusChance% probability
+ *   damage = max(1, damage)
+ * 
+ * The bonus roll happens before or after the random factor, as the original
+ * script does. Scripts describe themselves with a NATIVE_SKILL dictionary
+ * (see docs/PYTHON_SKILLS.md), read by NativeSkill::parseDeclaration();
+ * C++ code can use PythonSkillLoader::registerNativeSkill().
+ */
+struct NativeSkillSpec {
+    /**
+     * How the base power is computed
+     */
+    enum class PowerCurve : uint8_t {
+        FIXED,          // power
+        HP_RATIO,       // max(1, int(power * current_hp / max_hp)) (e.g. Eruption)
+        SPEED_RATIO     // First speedTable entry whose ratio <= attacker/defender speed, else power (e.g. Electro Ball)
+    };
+    
+    /**
+     * Defender stat the damage is divided by
+     */
+    enum class DefenseStat : uint8_t {
+        DEFENSE,
+        SPECIAL_DEFENSE
+    };
+    
+    PowerCurve curve = PowerCurve::FIXED;
+    int power = 0;                      // Base power; maximum power (HP_RATIO); fallback power (SPEED_RATIO)
+    std::vector<std::pair<double, int>> speedTable;  // (minimum speed ratio, power), descending ratios
+    DefenseStat defense = DefenseStat::DEFENSE;
+    int level = 50;                     // Level used in the formula
+    int randomMin = 85;                 // Random factor range, in percent
+    int randomMax = 100;
+    int bonusChance = 0;                // Percent chance of the bonus (0 = no bonus roll)
+    double bonusMultiplier = 1.0;       // Damage multiplier when the bonus applies
+    bool bonusBeforeRandom = false;     // Roll the bonus before the random factor (e.g. Slash)
+};
+
+/**
+ * NativeSkill Class
+ * 
+ * Evaluates NativeSkillSpecs in C++, without entering the Python
+ * interpreter. Draws come from the battle's BattleRng in the same order and
+ * with the same rejection sampling as Python's random.randint() does in a
+ * skill call, so for a given battle seed a native skill returns exactly the
+ * damage its Python script would.
+ */
+class NativeSkill {
+public:
+    /**
+     * Damage of one use of a native skill
+     * 
+     * @param spec Skill description
+     * @param attacker Pokemon using the skill
+     * @param defender Pokemon being targeted
+     * @param rng Random source of the battle
+     * @return Damage (at least 1)
+     */
+    static int calculateDamage(const NativeSkillSpec& spec, const Pokemon& attacker,
+                               const Pokemon& defender, BattleRng& rng);
+    
+    /**
+     * Damage of one hit of a SkillBatch, from the stats captured in its
+     * columns
+     */
+    static int calculateDamage(const NativeSkillSpec& spec, const SkillBatch& batch, size_t hit,
+                               BattleRng& rng);
+    
+    /**
+     * Exact distribution of calculateDamage() for one attacker/defender
+     * pair: every random factor and bonus outcome, equal values merged
+     * 
+     * @return Damage values in increasing order with their probabilities
+     */
+    static DamageDistribution damageDistribution(const NativeSkillSpec& spec, const Pokemon& attacker,
+                                                 const Pokemon& defender);
+    
+    /**
+     * Read the NATIVE_SKILL dictionary from a script's source text
+     * The dictionary must be a literal (numbers, strings, True/False,
+     * tuples, lists and dicts), so the same description is found whether
+     * or not Python is running. The last top-level assignment wins.
+     * 
+     * @param source Script source
+     * @param spec Receives the parsed description
+     * @param error Receives the reason when the declaration is invalid
+     *              (left empty if the script declares none)
+     * @return true if the script declares a valid description
+     */
+    static bool parseDeclaration(const std::string& source, NativeSkillSpec& spec, std::string& error);
+    
+    /**
+     * Equivalent of Python's random.randint(low, high) in a skill call
+     * (getrandbits-based rejection sampling on the battle's BattleRng)
+     */
+    static int randint(BattleRng& rng, int low, int high);
+};
+
+#endif // NATIVE_SKILL_H
@@ -1,12 +1,37 @@
 #ifndef POKEMON_H
 #define POKEMON_H
 
+#include "MoveRegistry.h"
+#include "StatusEffect.h"
+#include "TypeEffectiveness.h"
 #include <string>
 #include <vector>
-#include <memory>
+#include <iostream>
 
-// Forward declaration to avoid circular dependency
-class Move;
+/**
+ * StatusTick Struct
+ * 
+ * Outcome of one end-of-turn status update, reported by the battle as events.
+ */
+struct StatusTick {
+    StatusEffect status = StatusEffect::NONE;  // Status that acted (NONE if healthy)
+    int damage = 0;                            // End-of-turn damage (maxHP / divisor)
+    int drained = 0;                           // HP actually lost to the opponent (Seeded)
+    bool recovered = false;                    // Status wore off this turn
+};
+
+/**
+ * PokemonState Struct
+ * 
+ * Everything about a Pokemon that changes during a battle. Kept as plain
+ * data so a whole roster can be saved and reset with flat copies (see
+ * BattleArena).
+ */
+struct PokemonState {
+    int currentHP;                 // Current hit points (0 = fainted)
+    StatusEffect statusEffect;     // Current status effect (NONE if healthy)
+    int statusDuration;            // Remaining turns for status effect
+};
 
 /**
  * Pokemon Class
@@ -17,16 +42,14 @@ class Move;
 class Pokemon {
 private:
     std::string name;              // Pokemon's name (e.g., "Pikachu")
-    std::string type;              // Pokemon's type (e.g., "Electric", "Water")
+    PokemonType type;              // Pokemon's type, parsed once from its name
     int maxHP;                     // Maximum hit points
-    int currentHP;                 // Current hit points (0 = fainted)
     int attack;                    // Attack stat (used for damage calculation)
     int defense;                   // Defense stat (reduces physical damage)
     int specialDefense;            // Special Defense stat (reduces special damage)
     int speed;                     // Speed stat (determines turn order)
-    std::vector<std::shared_ptr<Move>> moves;  // List of moves this Pokemon knows
-    std::string statusEffect;      // Current status effect ("Poisoned", "Paralyzed", etc.)
-    int statusDuration;            // Remaining turns for status effect
+    std::vector<MoveId> moves;     // Moves this Pokemon knows, in the MoveRegistry
+    PokemonState state;            // HP and status, changed by battles
 
 public:
     /**
@@ -34,29 +57,42 @@ public:
      * Creates a new Pokemon with specified stats
      * 
      * @param name Pokemon's name
-     * @param type Pokemon's type (must match types in TypeEffectiveness)
+     * @param type Pokemon's type name (must match types in TypeEffectiveness)
      * @param hp Maximum and initial HP
      * @param atk Attack stat
      * @param def Defense stat
      * @param spDef Special Defense stat
      * @param spd Speed stat (higher = attacks first)
+     * @throws std::invalid_argument if the type name is unknown
      */
     Pokemon(const std::string& name, const std::string& type, int hp, int atk, int def, int spDef, int spd);
     
     // ===== Getters =====
     // These methods provide read-only access to Pokemon's attributes
     
-    std::string getName() const { return name; }
-    std::string getType() const { return type; }
+    const std::string& getName() const { return name; }
+    std::string getType() const { return TypeEffectiveness::typeName(type); }
+    PokemonType getTypeId() const { return type; }
     int getMaxHP() const { return maxHP; }
-    int getCurrentHP() const { return currentHP; }
+    int getCurrentHP() const { return state.currentHP; }
     int getAttack() const { return attack; }
     int getDefense() const { return defense; }
     int getSpecialDefense() const { return specialDefense; }
     int getSpeed() const { return speed; }
-    const std::vector<std::shared_ptr<Move>>& getMoves() const { return moves; }
-    std::string getStatusEffect() const { return statusEffect; }
-    int getStatusDuration() const { return statusDuration; }
+    const std::vector<MoveId>& getMoveIds() const { return moves; }
+    size_t getMoveCount() const { return moves.size(); }
+    const Move& getMove(size_t slot) const { return MoveRegistry::get(moves[slot]); }
+    StatusEffect getStatusEffect() const { return state.statusEffect; }
+    const char* getStatusName() const { return StatusRules::name(state.statusEffect); }
+    int getStatusDuration() const { return state.statusDuration; }
+    const PokemonState& getState() const { return state; }
+    
+    /**
+     * Overwrites HP and status, e.g. to reset the Pokemon after a battle
+     * 
+     * @param saved State previously returned by getState()
+     */
+    void setState(const PokemonState& saved) { state = saved; }
     
     // ===== Battle Methods =====
     
@@ -81,51 +117,74 @@ public:
      * 
      * @return true if fainted, false otherwise
      */
-    bool isFainted() const { return currentHP <= 0; }
+    bool isFainted() const { return state.currentHP <= 0; }
     
     /**
-     * Adds a move to Pokemon's moveset
+     * Adds a registered move to Pokemon's moveset
      * Pokemon can learn any number of moves (no limit in current implementation)
      * 
-     * @param move Shared pointer to the Move to add
+     * @param move Id of the move in the MoveRegistry
+     */
+    void addMove(MoveId move);
+    
+    /**
+     * Registers a copy of a move and adds it to the moveset
+     * 
+     * @param move Move to register
+     * @return Id of the registered move
      */
-    void addMove(std::shared_ptr<Move> move);
+    MoveId addMove(const Move& move);
     
     /**
      * Applies a status effect to the Pokemon
      * Only works if Pokemon doesn't already have a status effect
      * 
-     * @param effect Name of status effect ("Poisoned", "Paralyzed", "Burned")
+     * @param effect Status effect to apply (NONE is ignored)
      * @param duration Number of turns the effect lasts
+     * @return true if the status was applied
      */
-    void applyStatusEffect(const std::string& effect, int duration);
+    bool applyStatusEffect(StatusEffect effect, int duration);
+    
+    /**
+     * Applies a status effect by name ("Poisoned", "Paralyzed", ...)
+     * 
+     * @param effect Name of status effect
+     * @param duration Number of turns the effect lasts
+     * @return true if the status was applied
+     * @throws std::invalid_argument if the name is not a known status
+     */
+    bool applyStatusEffect(const std::string& effect, int duration) {
+        return applyStatusEffect(StatusRules::parse(effect), duration);
+    }
     
     /**
      * Updates the Pokemon's status effect
-     * Applies damage/effects and decrements duration
+     * Applies end-of-turn damage from the status rule and decrements duration
      * Called at the end of each turn
      * 
-     * Effects:
-     * - Poisoned: 1/8 max HP damage per turn
-     * - Burned: 1/16 max HP damage per turn
-     * - Paralyzed: Handled in Battle class (50% immobilization)
+     * Turn-skipping statuses (Paralyzed, Asleep, Frozen, Confused) are
+     * handled in the Battle class before the move is used.
+     * 
+     * @return What the status did this turn (status is NONE if there was none)
      */
-    void updateStatus();
+    StatusTick updateStatus();
     
     /**
      * Checks if Pokemon currently has a status effect
      * 
      * @return true if status effect is active, false otherwise
      */
-    bool hasStatusEffect() const { return !statusEffect.empty(); }
+    bool hasStatusEffect() const { return state.statusEffect != StatusEffect::NONE; }
     
     // ===== Display =====
     
     /**
      * Displays Pokemon's current status to console
      * Shows name, type, HP, stats, status effects, and moves
+     * 
+     * @param out Stream to write to
      */
-    void displayStatus() const;
+    void displayStatus(std::ostream& out = std::cout) const;
 };
 
 #endif // POKEMON_H
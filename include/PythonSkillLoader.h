@@ -2,11 +2,23 @@
 #define PYTHON_SKILL_LOADER_H
 
 #include <string>
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <Python.h>
+#include "Move.h"
+#include "NativeSkill.h"
+#include "SkillArgumentPool.h"
+#include "SkillBatch.h"
+#include "SkillResultCache.h"
 
-// Forward declaration
+// Forward declarations
 class Pokemon;
+class BattleRng;
 
 /**
  * PythonSkillLoader Class
@@ -16,16 +28,332 @@ class Pokemon;
  * and complex effects without recompiling C++ code.
  * 
  * Usage:
- * 1. Call initialize() at program start
- * 2. Use loadSkill() to load Python functions
+ * 1. Call initialize() at program start, or initializeOnDemand() to start
+ *    Python only when a skill first needs it
+ * 2. Use bindSkill() to give a Move a script's effect (or loadSkill() for
+ *    a callable), or deferSkill() to resolve the script on first use
  * 3. Call finalize() before program exit
+ * 
+ * Many hits of one skill drawing from one random stream (e.g. the samples
+ * of a DamageTable) can be evaluated in a single interpreter call with
+ * executeSkillBatch().
+ * 
+ * Skills that only vary the standard damage formula can declare a
+ * NATIVE_SKILL dictionary; loadSkill() then returns a C++ implementation
+ * (NativeSkill) that never enters the interpreter, and Python is kept for
+ * custom logic.
+ * 
+ * Skills whose script sets DETERMINISTIC = True promise that the result
+ * only depends on the stat dictionaries. While script output is disabled
+ * their results are memoized (see setSkillMemoCapacity()), so repeated
+ * inputs skip the interpreter and the GIL.
+ * 
+ * Threading: initialize() releases the GIL once setup is done, and every
+ * loader entry point (including functions returned by loadSkill()) acquires
+ * it for the duration of the call, so skills may be executed from any
+ * thread. Calls are serialized by the GIL, unless the calling thread holds
+ * a ThreadContext: on Python 3.12+ that gives the thread a sub-interpreter
+ * with its own GIL, and Python skills on different threads run in
+ * parallel. initialize() and finalize() must run on the same thread.
+ * 
+ * Startup: with initializeOnDemand() the interpreter is started (and
+ * scripts imported) by the first call that needs Python, on whichever
+ * thread makes it, and sub-interpreters are only created by the first
+ * skill call on their thread. A run whose moves are all native or
+ * deferred and never used does not start Python at all, and
+ * setPythonEnabled(false) guarantees it.
  */
 class PythonSkillLoader {
 private:
-    // Flag to track Python interpreter state
-    static bool pythonInitialized;
+    // Flag to track Python interpreter state (set once the interpreter is ready)
+    static std::atomic<bool> pythonInitialized;
+    
+    // Start the interpreter on first use (initializeOnDemand())
+    static bool initializeOnFirstUse;
+    
+    // Whether Python may be started at all (setPythonEnabled())
+    static bool pythonEnabled;
+    
+    // Serializes starting and stopping the interpreter
+    static std::mutex initializeMutex;
+    
+    // Time spent starting the interpreter, in seconds
+    static double initializationTime;
+    
+    // Thread state saved when initialize() released the GIL
+    static PyThreadState* mainThreadState;
+    
+    /**
+     * Resolved Python skill
+     * Holds strong references to the imported module and its callable so
+     * repeated executions skip PyImport_Import and attribute lookup.
+     * Both pointers are released (and set to nullptr) by finalize().
+     */
+    struct SkillHandle {
+        PyObject* module = nullptr;     // Imported script module
+        PyObject* function = nullptr;   // Callable skill function
+        bool deterministic = false;     // Module sets DETERMINISTIC = True
+        bool precompile = false;        // Module sets PRECOMPILE = True
+    };
+    
+    // Resolved skills keyed by "module:function", cleared by finalize()
+    static std::map<std::string, std::shared_ptr<SkillHandle>> skillCache;
+    
+    // Reused stat dictionaries, one pool per calling thread (guarded by the GIL)
+    static std::vector<std::unique_ptr<SkillArgumentPool>> argumentPools;
+    
+    // Bumped by finalize() so threads drop pools from a previous interpreter
+    static unsigned poolGeneration;
+    
+    /**
+     * Python function registered for Move dispatch, addressed by ScriptSkillId
+     * A deferred skill picks between its native implementation and Python
+     * on its first call; `native` and `nativeSkill` are set before
+     * `resolved` is published.
+     */
+    struct ScriptSkill {
+        std::string scriptPath;
+        std::string functionName;
+        bool deferred;                          // Registered by registerDeferredSkill()
+        std::atomic<bool> resolved;             // Native or Python chosen (always true if not deferred)
+        bool native = false;                    // Runs nativeSkill instead of Python
+        bool deterministic = false;             // Results may be memoized (script's DETERMINISTIC)
+        bool precompile = false;                // Results may be tabulated (script's PRECOMPILE)
+        NativeSkillSpec nativeSkill;
+        std::shared_ptr<SkillHandle> handle;    // Main interpreter function (guarded by its GIL)
+        
+        ScriptSkill(const std::string& scriptPath, const std::string& functionName, bool deferred)
+            : scriptPath(scriptPath), functionName(functionName), deferred(deferred), resolved(!deferred) {}
+    };
+    
+    // Registered script skills, indexed by ScriptSkillId (entries are never
+    // removed, and never move, so calls can read them without locking)
+    static std::deque<ScriptSkill> scriptSkills;
+    
+    // Guards scriptSkills registration and deferred resolution
+    static std::mutex scriptSkillsMutex;
+    
+    // Native skill specs keyed by module name (registered or read from NATIVE_SKILL)
+    static std::map<std::string, NativeSkillSpec> nativeSkills;
+    
+    // Guards nativeSkills (threads with a ThreadContext do not share a GIL)
+    static std::mutex nativeSkillsMutex;
+    
+    // Whether loadSkill() may return native implementations
+    static bool nativeSkillsEnabled;
+    
+    // Last value passed to setScriptOutputEnabled(), applied to new sub-interpreters
+    static bool scriptOutputEnabled;
+    
+    // Entries per skill and thread in deterministic skill memos (0 = no memoization)
+    static size_t skillMemoCapacity;
+    
+    /**
+     * Sub-interpreter owned by a ThreadContext
+     * Everything in it belongs to that interpreter and is only touched by
+     * the owning thread while it holds the interpreter's GIL.
+     */
+    struct InterpreterContext {
+        PyThreadState* threadState = nullptr;   // Owning thread's state in the sub-interpreter
+        int lockDepth = 0;                      // Nested ScopedGil count on the owning thread
+        std::map<std::string, std::shared_ptr<SkillHandle>> skillCache;  // Per-interpreter skill cache
+        std::vector<std::shared_ptr<SkillHandle>> scriptSkills;         // Per-interpreter handles by ScriptSkillId
+        std::unique_ptr<SkillArgumentPool> argumentPool;                // Per-interpreter stat dictionaries
+    };
+    
+    // Sub-interpreter of the calling thread (nullptr = main interpreter)
+    static thread_local InterpreterContext* threadContext;
+    
+    // Serializes sub-interpreter creation and destruction
+    static std::mutex contextMutex;
+    
+    /**
+     * Start the main interpreter and release its GIL
+     * Caller must hold initializeMutex.
+     */
+    static void startInterpreter();
+    
+    /**
+     * Make sure the interpreter is running, starting it if it is on demand
+     * 
+     * @throws std::runtime_error if Python is disabled, or neither
+     *         initialize() nor initializeOnDemand() was called
+     */
+    static void ensureInitialized();
+    
+    /**
+     * Create the sub-interpreter of a ThreadContext on its first use
+     * Called by ScopedGil on the owning thread; Python must be initialized.
+     */
+    static void startThreadInterpreter(InterpreterContext& context);
+    
+    /**
+     * Index of a registered skill, or scriptSkills.size() if there is none
+     * Caller must hold scriptSkillsMutex.
+     */
+    static size_t findScriptSkill(const std::string& scriptPath, const std::string& functionName, bool deferred);
+    
+    /**
+     * Choose native or Python for a deferred skill on its first call
+     * 
+     * @throws std::runtime_error if Python is not initialized or the script cannot be loaded
+     */
+    static void resolveDeferredSkill(ScriptSkill& entry);
+    
+    /**
+     * Set up sys.path, the battle random source and script output in the
+     * current interpreter. Caller must hold its GIL.
+     */
+    static void prepareInterpreter();
+    
+    /**
+     * Module name of a script path ("thunderbolt.py" -> "thunderbolt")
+     */
+    static std::string moduleName(const std::string& scriptPath);
+    
+    /**
+     * Argument pool of the calling thread, created on first use
+     * Each thread needs its own pool because the GIL may switch threads
+     * while a script is still reading its arguments; threads with a
+     * ThreadContext use their interpreter's pool. Caller must hold the GIL.
+     */
+    static SkillArgumentPool& threadArgumentPool();
+    
+    /**
+     * The calling thread's result memo of a deterministic skill
+     * (emptied after a finalize() or a capacity change)
+     */
+    static SkillResultCache& threadSkillMemo(ScriptSkillId skill);
+    
+    /**
+     * Look up a skill in the cache, importing and resolving it on first use
+     * 
+     * @param scriptPath Script name with or without .py extension
+     * @param functionName Name of function to resolve
+     * Caller must hold the GIL; uses the calling thread's interpreter cache
+     * 
+     * @return Cached handle, or nullptr if the module or function is missing
+     */
+    static std::shared_ptr<SkillHandle> resolveSkill(const std::string& scriptPath, const std::string& functionName);
+    
+    /**
+     * Route Python's module-level random functions to the battle's BattleRng
+     * 
+     * Replaces random.randint, random.random, etc. with methods of a
+     * random.Random subclass whose bit source is the BattleRng of the skill
+     * call running on the current thread. Scripts keep using
+     * "import random" unchanged, and their draws come from the battle's
+     * stream, so a battle replays exactly from its seed. Outside a battle
+     * (executeSkill without a BattleRng) a per-thread fallback generator
+     * is used. Called by initialize(); caller must hold the GIL.
+     */
+    static void installScriptRandom();
+    
+    /**
+     * Call a resolved skill function with the attacker/defender stat dictionaries
+     * 
+     * Caller must hold the GIL
+     * 
+     * @return Damage value returned by Python (0 if the call failed)
+     */
+    static int callSkill(PyObject* function, const Pokemon& attacker, const Pokemon& defender);
+    
+    /**
+     * Shared body of both executeSkillBatch() overloads
+     * 
+     * @param native Native implementation of the skill, or nullptr
+     */
+    static void runSkillBatch(const std::string& scriptPath, const std::string& functionName,
+                              const NativeSkillSpec* native, SkillBatch& batch, BattleRng& rng);
+    
+    /**
+     * Call a resolved skill function with an already packed argument tuple
+     * 
+     * Caller must hold the GIL
+     */
+    static int callSkill(PyObject* function, PyObject* pArgs);
+    
+    /**
+     * Call a calculate_damage_batch function with the batch's stat columns
+     * and store the returned damage in the batch
+     * 
+     * Caller must hold the GIL
+     * 
+     * @throws std::runtime_error if the call fails or returns the wrong number of values
+     */
+    static void callSkillBatch(PyObject* function, const std::string& scriptPath, SkillBatch& batch);
     
 public:
+    /**
+     * RAII guard that holds the GIL for the current thread
+     * Required around direct Python C API calls made outside the loader.
+     * On a thread with a ThreadContext it holds the sub-interpreter's GIL.
+     */
+    class ScopedGil {
+    private:
+        PyGILState_STATE state;
+        InterpreterContext* context;    // Sub-interpreter locked, or nullptr for the main one
+    public:
+        ScopedGil();
+        ~ScopedGil();
+        ScopedGil(const ScopedGil&) = delete;
+        ScopedGil& operator=(const ScopedGil&) = delete;
+    };
+    
+    /**
+     * RAII Python execution context for a worker thread
+     * 
+     * On Python 3.12+ the calling thread gets a sub-interpreter with its
+     * own GIL, created by its first Python call (a thread that only runs
+     * native skills never creates one). Until the context is destroyed, skills
+     * called on that thread (including functions returned by loadSkill())
+     * run in the sub-interpreter, with its own module cache and argument
+     * dictionaries, in parallel with other threads. Scripts are imported
+     * again in each sub-interpreter, so module-level state is not shared.
+     * 
+     * On older Pythons, when Python is disabled, or when the thread already
+     * has a context, the context does nothing and calls share the main
+     * interpreter's GIL.
+     * 
+     * Create and destroy a context on the same thread, after initialize()
+     * (or initializeOnDemand()) and before finalize().
+     */
+    class ThreadContext {
+    private:
+        InterpreterContext* context;    // Owned sub-interpreter, or nullptr when inactive
+    public:
+        ThreadContext();
+        ~ThreadContext();
+        ThreadContext(const ThreadContext&) = delete;
+        ThreadContext& operator=(const ThreadContext&) = delete;
+        
+        /**
+         * Whether Python calls on this thread run in its own sub-interpreter
+         */
+        bool isIsolated() const { return context != nullptr; }
+        
+        /**
+         * Whether the Python version supports per-interpreter GILs (3.12+)
+         */
+        static bool isSupported();
+    };
+    
+    /**
+     * RAII guard that discards script output for its lifetime
+     * Turns setScriptOutputEnabled() off if it is on, and back on when the
+     * scope ends; does nothing if output is already off. Used around runs
+     * whose skill calls must not print (searches, table building).
+     */
+    class ScopedOutputMute {
+    private:
+        bool muted;     // Output was on and is restored on exit
+    public:
+        ScopedOutputMute();
+        ~ScopedOutputMute();
+        ScopedOutputMute(const ScopedOutputMute&) = delete;
+        ScopedOutputMute& operator=(const ScopedOutputMute&) = delete;
+    };
+    
     /**
      * Initialize Python interpreter
      * Must be called before any Python operations
@@ -33,13 +361,82 @@ public:
      */
     static void initialize();
     
+    /**
+     * Initialize the Python interpreter when it is first needed
+     * Nothing is started now: the first skill call or script import
+     * that needs the interpreter starts it (and
+     * does not print the initialize() message). finalize() ends on-demand
+     * mode; it then runs on any thread, with no skill calls running.
+     */
+    static void initializeOnDemand();
+    
+    /**
+     * Whether the interpreter is running
+     */
+    static bool isInitialized() { return pythonInitialized; }
+    
+    /**
+     * Allow or forbid starting Python (native-only runs)
+     * Disabled, initialize() and every call that needs the interpreter
+     * throw, and no ThreadContext creates a sub-interpreter;
+     * findNativeSkill() still reads NATIVE_SKILL from the script sources. Set it before starting
+     * Python, during setup.
+     * 
+     * @param enabled false to run without Python (default true)
+     */
+    static void setPythonEnabled(bool enabled) { pythonEnabled = enabled; }
+    
+    static bool isPythonEnabled() { return pythonEnabled; }
+    
+    /**
+     * Time it took to start the interpreter, in seconds (0 if it has not
+     * been started)
+     */
+    static double getInitializationTime() { return initializationTime; }
+    
     /**
      * Finalize Python interpreter
-     * Should be called before program exit to clean up Python resources
+     * Should be called before program exit to clean up Python resources,
+     * on the thread that called initialize(), with no skill calls running
+     * Releases every cached skill; functions returned by loadSkill() throw
+     * if called afterwards
      * Safe to call multiple times (only finalizes once)
      */
     static void finalize();
     
+    /**
+     * Enable or silence output printed by skill scripts
+     * When disabled, Python's sys.stdout is redirected to os.devnull;
+     * enabling restores the original stream. Before the interpreter is
+     * started the value is kept and applied when it starts.
+     * 
+     * @param enabled true to show script output (default), false to discard it
+     */
+    static void setScriptOutputEnabled(bool enabled);
+    
+    static bool isScriptOutputEnabled() { return scriptOutputEnabled; }
+    
+    /**
+     * Size the result memos of deterministic skills
+     * 
+     * A script that sets DETERMINISTIC = True at module level declares
+     * that its functions return the same value for the same stat
+     * dictionaries (no randomness, no state between calls). Move dispatch
+     * (bindSkill(), deferSkill(), loadSkill()) then keeps the results of
+     * each such skill in a per-thread LRU cache keyed on both
+     * dictionaries, and answers repeated inputs without the interpreter.
+     * A cached call prints nothing, so memos are only used while script
+     * output is disabled. executeSkill() and executeSkillBatch() always
+     * call Python.
+     * 
+     * Call it while no skills run; existing memos are emptied.
+     * 
+     * @param entries Results kept per skill and thread (default 4096, 0 disables memoization)
+     */
+    static void setSkillMemoCapacity(size_t entries);
+    
+    static size_t getSkillMemoCapacity() { return skillMemoCapacity; }
+    
     /**
      * Load a skill function from a Python script
      * 
@@ -51,16 +448,155 @@ public:
      *   def calculate_damage(attacker, defender):
      *       return int(damage)
      * 
+     * If the script has a native implementation (see findNativeSkill()) and
+     * functionName is "calculate_damage", the returned function runs it in
+     * C++ without taking the GIL while script output is disabled. With
+     * output on it calls the script, so its commentary is printed; both
+     * return the same damage from the same draws. Otherwise the module
+     * and function are resolved once and cached; the
+     * returned function keeps a strong reference to them until finalize().
+     * Python's random functions draw from the BattleRng argument during
+     * the call, so scripted randomness follows the battle seed.
+     * 
      * @param scriptPath Name of Python file without .py extension (e.g., "thunderbolt")
      * @param functionName Name of function to load (typically "calculate_damage")
-     * @return Function object that can be called with Pokemon references
+     * @return Function object that can be called with Pokemon references and the battle's BattleRng
+     * @throws std::runtime_error if script or function cannot be loaded
+     */
+    static std::function<int(Pokemon&, Pokemon&, BattleRng&)> loadSkill(const std::string& scriptPath, const std::string& functionName);
+    
+    /**
+     * Register a Python function for Move dispatch
+     * The function is resolved once now; registering the same function
+     * again returns the same id.
+     * 
+     * @param scriptPath Name of Python file without .py extension
+     * @param functionName Name of function to register
+     * @return Handle for callScriptSkill() and Move::setScriptEffect()
+     * @throws std::runtime_error if script or function cannot be loaded
+     */
+    static ScriptSkillId registerScriptSkill(const std::string& scriptPath, const std::string& functionName);
+    
+    /**
+     * Register a skill function without loading its script
+     * Nothing is imported until the first callScriptSkill(), which picks
+     * the native implementation or Python as bindSkill() would (with the
+     * setNativeSkillsEnabled() value at that time). Registering the same
+     * function again returns the same id. Python need not be initialized
+     * yet, but must be by the first call, or be started on demand then.
+     * 
+     * @param scriptPath Name of Python file without .py extension
+     * @param functionName Name of function to register
+     * @return Handle for callScriptSkill() and Move::setScriptEffect()
+     */
+    static ScriptSkillId registerDeferredSkill(const std::string& scriptPath, const std::string& functionName);
+    
+    /**
+     * Call a registered Python function, as a loadSkill() function would
+     * (GIL, the thread's sub-interpreter if any, Python random from rng)
+     * 
+     * @throws std::runtime_error if Python is not initialized (or cannot be
+     *         started on demand), or a deferred skill's script cannot be loaded
+     */
+    static int callScriptSkill(ScriptSkillId skill, Pokemon& attacker, Pokemon& defender, BattleRng& rng);
+    
+    /**
+     * Whether a registered skill runs its native implementation (false
+     * for Python skills and for deferred skills not resolved yet)
+     */
+    static bool isNativeSkill(ScriptSkillId skill);
+    
+    /**
+     * Whether a registered skill may be replaced by a DamageTable: it runs
+     * in Python (not natively) and its script sets PRECOMPILE = True,
+     * declaring that its result depends only on the static stats of both
+     * Pokemon (max_hp, attack, defense, special_defense, speed), not on
+     * current_hp or name. Resolves a deferred skill.
+     */
+    static bool isPrecompilable(ScriptSkillId skill);
+    
+    /**
+     * Exact damage distribution of a registered skill (see
+     * Move::damageDistribution()): the native spec's when the skill runs
+     * natively, otherwise the one its script declares with a
+     * damage_distribution(attacker, defender) function returning
+     * (damage, probability) pairs for the same stat dictionaries as the
+     * skill function.
+     * 
+     * @param outcomes Receives the distribution
+     * @return false if the script declares none
+     * @throws std::runtime_error if the declaration fails or is not a
+     *         sequence of (int, float) pairs
+     */
+    static bool damageDistribution(ScriptSkillId skill, const Pokemon& attacker, const Pokemon& defender,
+                                   DamageDistribution& outcomes);
+    
+    /**
+     * Give a move the effect of a script's skill function
+     * Same choice as loadSkill(): a skill with a native implementation
+     * runs it while script output is disabled and the script otherwise;
+     * other skills always call the registered Python function. Either way
+     * the move gets Move::setScriptEffect() and is called without
+     * std::function.
+     * 
+     * @param move Move to update
+     * @param scriptPath Name of Python file without .py extension
+     * @param functionName Name of function to bind
      * @throws std::runtime_error if script or function cannot be loaded
      */
-    static std::function<int(Pokemon&, Pokemon&)> loadSkill(const std::string& scriptPath, const std::string& functionName);
+    static void bindSkill(Move& move, const std::string& scriptPath,
+                          const std::string& functionName = "calculate_damage");
+    
+    /**
+     * Give a move a script's effect, resolved when the move is first used
+     * (registerDeferredSkill()). Setting up moves imports nothing, and a
+     * missing script is only reported when the move is used.
+     * 
+     * @param move Move to update
+     * @param scriptPath Name of Python file without .py extension
+     * @param functionName Name of function to bind
+     */
+    static void deferSkill(Move& move, const std::string& scriptPath,
+                           const std::string& functionName = "calculate_damage");
+    
+    /**
+     * Register a native implementation for a script
+     * loadSkill() on this script then returns the native implementation
+     * instead of calling Python, as if the script declared NATIVE_SKILL.
+     * 
+     * @param scriptPath Script name with or without .py extension
+     * @param spec Damage formula description
+     */
+    static void registerNativeSkill(const std::string& scriptPath, const NativeSkillSpec& spec);
+    
+    /**
+     * Native description of a script's calculate_damage, if it has one
+     * Checks registered specs first, then the script's NATIVE_SKILL
+     * dictionary, read from its source by NativeSkill::parseDeclaration()
+     * (never through the interpreter, so runs with and without Python get
+     * the same description). The script is looked up as Python imports
+     * it: in the working directory, then in scripts/. An invalid
+     * NATIVE_SKILL is reported on stderr and treated as absent.
+     * 
+     * @param scriptPath Script name with or without .py extension
+     * @param spec Receives the description
+     * @return true if the script has a native implementation
+     */
+    static bool findNativeSkill(const std::string& scriptPath, NativeSkillSpec& spec);
+    
+    /**
+     * Allow or forbid native implementations in loadSkill()
+     * Disabled, every skill is called in Python (e.g. to compare both paths).
+     * Affects skills loaded afterwards.
+     * 
+     * @param enabled true to use native implementations (default)
+     */
+    static void setNativeSkillsEnabled(bool enabled) { nativeSkillsEnabled = enabled; }
     
     /**
      * Execute Python skill directly without creating a function object
-     * Useful for one-time calculations or testing
+     * Useful for one-time calculations or testing; always calls Python
+     * Shares the skill cache with loadSkill()
      * 
      * @param scriptPath Name of Python file without .py extension
      * @param functionName Name of function to execute
@@ -71,6 +607,48 @@ public:
      */
     static int executeSkill(const std::string& scriptPath, const std::string& functionName,
                            Pokemon& attacker, Pokemon& defender);
+    
+    /**
+     * Execute Python skill directly with Python's random functions drawing
+     * from the given random stream (reproducible variant of the above)
+     */
+    static int executeSkill(const std::string& scriptPath, const std::string& functionName,
+                           Pokemon& attacker, Pokemon& defender, BattleRng& rng);
+    
+    /**
+     * Evaluate every hit of a batch with one skill, all drawing from one
+     * random stream (e.g. the samples of DamageTable::build()). Battles
+     * each draw from their own BattleRng, so the battle engines call skills
+     * per hit instead.
+     * 
+     * If the script defines calculate_damage_batch(attackers, defenders),
+     * it is called once for the whole batch. Each argument is a dict
+     * mapping the stat keys (current_hp, max_hp, attack, defense,
+     * special_defense, speed) to read-only memoryviews of signed 32-bit
+     * ints over the batch's columns; there is no "name" key. The function
+     * returns one damage value per hit, as a sequence of ints or an integer
+     * buffer (e.g. array('i') or a NumPy array). The views are released
+     * when the call returns, so scripts must not keep them.
+     * 
+     * Scripts without a batch function fall back to calling
+     * calculate_damage once per hit, and skills with a native
+     * implementation (see loadSkill()) run natively. Either way random
+     * draws come from rng; a batch function that draws per hit in order
+     * gives the same damage as the per-hit calls would.
+     * 
+     * @param scriptPath Name of Python file without .py extension
+     * @param batch Hits to evaluate; receives the damage of each hit
+     * @param rng Random source for the whole batch
+     * @throws std::runtime_error if the script cannot be loaded or the batch call fails
+     */
+    static void executeSkillBatch(const std::string& scriptPath, SkillBatch& batch, BattleRng& rng);
+    
+    /**
+     * executeSkillBatch() for a registered skill; the batch function is
+     * the skill's function name followed by _batch
+     * (e.g. calculate_damage_batch)
+     */
+    static void executeSkillBatch(ScriptSkillId skill, SkillBatch& batch, BattleRng& rng);
 };
 
 #endif // PYTHON_SKILL_LOADER_H
@@ -0,0 +1,143 @@
+#ifndef REPLAY_LOG_H
+#define REPLAY_LOG_H
+
+#include "BattleReplay.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Replay Log Format
+ *
+ * An append-only binary file of recorded battles (all integers little-endian):
+ *
+ *   File header   "PKRL", u16 version, u16 flags (kNativeOnly: recorded
+ *                 with Python disabled; kPrecompiled: recorded with damage
+ *                 tables; high byte: expectimax AI depth, 0 for
+ *                 random moves; every battle in a log has the same flags)
+ *   Battle record u32 size of the rest of the record
+ *                 u64 seed
+ *                 2 x Pokemon: u8 name length, name, u8 type,
+ *                              u16 HP/ATK/DEF/SP.DEF/SPD,
+ *                              u8 move count, (u8 length, move name) per move
+ *                 u8 winner side, u16 turn count, u32 action count
+ *                 u32 first action index per turn (the turn index)
+ *                 12-byte actions: u8 actor, u8 move, u8 outcome,
+ *                              u8 effectiveness x4, i16 damage,
+ *                              u16 HP x2, u8 status x2
+ *
+ * A typical battle takes 150-300 bytes (mostly the roster snapshot),
+ * against several kilobytes for its text transcript.
+ */
+
+/**
+ * ReplayLogWriter Class
+ *
+ * Appends battles to a replay log, creating the file if needed.
+ */
+class ReplayLogWriter {
+private:
+    std::ofstream file;     // Log opened for appending
+    std::string record;     // Reused serialization buffer
+
+public:
+    /**
+     * Header flag: the battles were run with Python disabled, so scripts
+     * without a native skill used the built-in formula
+     */
+    static const uint16_t kNativeOnly = 0x0001;
+
+    /**
+     * Header flag: PRECOMPILE scripts drew their damage from tables built
+     * by DamageTable::precompile() with its default seed
+     */
+    static const uint16_t kPrecompiled = 0x0002;
+
+    /**
+     * Header bits holding the AI depth the battles were played with
+     * (0: random moves)
+     */
+    static const uint16_t kAiDepthMask = 0xFF00;
+    static const int kAiDepthShift = 8;
+
+    /**
+     * Header flags for an AI depth
+     *
+     * @param aiDepth Expectimax depth, 0 for random moves
+     * @throws std::invalid_argument if the depth does not fit in the header
+     */
+    static uint16_t aiDepthFlags(int aiDepth);
+
+    /**
+     * Open a log for appending
+     *
+     * @param path Log file; created with a header if missing or empty
+     * @param flags Header flags of the battles to append
+     * @throws std::runtime_error if the file cannot be opened, is not a replay
+     *         log, has another version, or was recorded with other flags
+     */
+    explicit ReplayLogWriter(const std::string& path, uint16_t flags = 0);
+
+    /**
+     * Append one battle
+     *
+     * @param replay Completed battle, e.g. from ReplayRecorder::getReplay()
+     * @throws std::runtime_error on write failure or values the format cannot hold
+     */
+    void append(const BattleReplay& replay);
+
+    /**
+     * Flush appended battles to disk
+     */
+    void flush() { file.flush(); }
+};
+
+/**
+ * ReplayLogReader Class
+ *
+ * Random access to the battles of a replay log. Opening the log scans only
+ * the record sizes to index battle offsets; a battle is decoded when read.
+ */
+class ReplayLogReader {
+private:
+    std::ifstream file;                 // Log opened for reading
+    std::vector<uint64_t> offsets;      // File offset of each battle record
+    uint16_t flags;                     // Header flags (see ReplayLogWriter)
+
+public:
+    /**
+     * Open and index a log
+     *
+     * @param path Log file
+     * @throws std::runtime_error if the file is missing, not a replay log, or truncated
+     */
+    explicit ReplayLogReader(const std::string& path);
+
+    /**
+     * Number of battles in the log
+     */
+    size_t getBattleCount() const { return offsets.size(); }
+
+    /**
+     * Header flags the battles were recorded with
+     */
+    uint16_t getFlags() const { return flags; }
+
+    /**
+     * AI depth the battles were played with (0: random moves)
+     */
+    int getAiDepth() const { return (flags & ReplayLogWriter::kAiDepthMask) >> ReplayLogWriter::kAiDepthShift; }
+
+    /**
+     * Decode one battle
+     *
+     * @param index Battle number (0-based, in the order battles were appended)
+     * @return The recorded battle
+     * @throws std::out_of_range if there is no such battle
+     * @throws std::runtime_error if the record is corrupt
+     */
+    BattleReplay readBattle(size_t index);
+};
+
+#endif // REPLAY_LOG_H
@@ -0,0 +1,102 @@
+#ifndef SKILL_ARGUMENT_POOL_H
+#define SKILL_ARGUMENT_POOL_H
+
+#include <string>
+#include <Python.h>
+
+// Forward declaration
+class Pokemon;
+class SkillBatch;
+
+/**
+ * SkillArgumentPool Class
+ * 
+ * Reusable argument objects for Python skill calls.
+ * Instead of building two fresh stat dictionaries per call, the pool keeps
+ * one attacker dict, one defender dict and the (attacker, defender) argument
+ * tuple alive between calls. Keys are interned once, and only the fields
+ * whose values changed since the previous call are replaced.
+ * 
+ * Scripts receive the same dict objects on every call, so they must treat
+ * them as read-only.
+ * 
+ * All methods require the Python interpreter to be initialized.
+ */
+class SkillArgumentPool {
+private:
+    /**
+     * Stat fields exposed to scripts, in dictionary insertion order
+     */
+    enum Field {
+        CURRENT_HP,
+        MAX_HP,
+        ATTACK,
+        DEFENSE,
+        SPECIAL_DEFENSE,
+        SPEED,
+        FIELD_COUNT
+    };
+    
+    /**
+     * One reusable stat dictionary with a shadow copy of its values
+     */
+    struct StatDict {
+        PyObject* dict = nullptr;       // Dictionary handed to scripts
+        std::string name;               // Name currently stored in the dict
+        long values[FIELD_COUNT];       // Values currently stored in the dict
+        bool populated = false;         // False until the first update
+    };
+    
+    PyObject* nameKey;                  // Interned "name"
+    PyObject* fieldKeys[FIELD_COUNT];   // Interned stat keys
+    StatDict attackerStats;
+    StatDict defenderStats;
+    PyObject* args;                     // (attacker dict, defender dict)
+    
+    /**
+     * Bring a stat dictionary up to date with a name and stat values
+     * Only changed entries are written
+     */
+    void update(StatDict& stats, const std::string& name, const long (&values)[FIELD_COUNT]);
+    
+    /**
+     * update() with a Pokemon's current stats
+     */
+    void update(StatDict& stats, const Pokemon& pokemon);
+    
+public:
+    /**
+     * Create the interned keys, both dictionaries and the argument tuple
+     */
+    SkillArgumentPool();
+    
+    /**
+     * Release all Python objects (must run before Py_Finalize)
+     */
+    ~SkillArgumentPool();
+    
+    SkillArgumentPool(const SkillArgumentPool&) = delete;
+    SkillArgumentPool& operator=(const SkillArgumentPool&) = delete;
+    
+    /**
+     * Refresh the pooled dictionaries for a call
+     * 
+     * Dictionary keys: name, current_hp, max_hp, attack, defense,
+     * special_defense, speed
+     * 
+     * @param attacker Attacking Pokemon
+     * @param defender Defending Pokemon
+     * @return Borrowed reference to the (attacker, defender) argument tuple
+     */
+    PyObject* pack(const Pokemon& attacker, const Pokemon& defender);
+    
+    /**
+     * Refresh the pooled dictionaries from one hit of a SkillBatch
+     * (the stats and names captured when the hit was added)
+     * 
+     * @return Borrowed reference to the (attacker, defender) argument tuple
+     */
+    PyObject* pack(const SkillBatch& batch, size_t hit);
+};
+
+#endif // SKILL_ARGUMENT_POOL_H
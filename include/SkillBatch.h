@@ -0,0 +1,119 @@
+#ifndef SKILL_BATCH_H
+#define SKILL_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Forward declaration
+class Pokemon;
+
+/**
+ * SkillBatch Class
+ *
+ * Pending hits of one skill, evaluated together by
+ * PythonSkillLoader::executeSkillBatch() from one random stream (e.g. the
+ * samples of a DamageTable).
+ *
+ * Attacker and defender stats are stored column by column (one int32 array
+ * per stat and side), which is what a script's calculate_damage_batch()
+ * receives as memoryviews, without copying. Every evaluation path reads
+ * these captured values (with the names, for per-hit calls), so the
+ * Pokemon may change or go away after add().
+ *
+ * Usage:
+ *   SkillBatch batch;
+ *   batch.add(pikachu, squirtle);
+ *   ...
+ *   PythonSkillLoader::executeSkillBatch("thunderbolt", batch, rng);
+ *   int damage = batch.getDamage(0);
+ */
+class SkillBatch {
+public:
+    /**
+     * Stat columns, in the order of the dictionary keys scripts see
+     */
+    enum Stat {
+        CURRENT_HP,
+        MAX_HP,
+        ATTACK,
+        DEFENSE,
+        SPECIAL_DEFENSE,
+        SPEED,
+        STAT_COUNT
+    };
+
+    /**
+     * Side of a hit
+     */
+    enum Side {
+        ATTACKER,
+        DEFENDER
+    };
+
+private:
+    std::vector<int32_t> columns[2][STAT_COUNT];    // columns[side][stat][hit]
+    std::vector<std::string> names[2];              // names[side][hit]
+    std::vector<int> damage;                        // Result per hit, set by execution
+
+public:
+    /**
+     * Dictionary key of a stat column ("current_hp", "max_hp", ...)
+     */
+    static const char* statName(Stat stat);
+
+    /**
+     * Queue one hit, capturing both Pokemon's current stats
+     *
+     * @param attacker Pokemon using the skill
+     * @param defender Pokemon being targeted
+     * @return Index of the hit in the batch
+     */
+    size_t add(const Pokemon& attacker, const Pokemon& defender);
+
+    /**
+     * Remove all hits (keeps the allocated capacity)
+     */
+    void clear();
+
+    /**
+     * Reserve room for a number of hits
+     */
+    void reserve(size_t hits);
+
+    size_t size() const { return damage.size(); }
+    bool empty() const { return damage.empty(); }
+
+    /**
+     * Stat column of one side (size() entries)
+     */
+    const int32_t* column(Side side, Stat stat) const { return columns[side][stat].data(); }
+
+    /**
+     * Captured stat of one side of a hit
+     */
+    int32_t getStat(Side side, Stat stat, size_t hit) const { return columns[side][stat][hit]; }
+
+    /**
+     * Name of the Pokemon on one side of a hit
+     */
+    const std::string& getName(Side side, size_t hit) const { return names[side][hit]; }
+
+    /**
+     * Damage of a hit (0 until the batch has been executed)
+     */
+    int getDamage(size_t hit) const { return damage[hit]; }
+
+    /**
+     * Damage of every hit, in insertion order
+     */
+    const std::vector<int>& getDamage() const { return damage; }
+
+    /**
+     * Store the damage of a hit
+     */
+    void setDamage(size_t hit, int value) { damage[hit] = value; }
+};
+
+#endif // SKILL_BATCH_H
@@ -0,0 +1,78 @@
+#ifndef SKILL_RESULT_CACHE_H
+#define SKILL_RESULT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Forward declaration
+class Pokemon;
+
+/**
+ * SkillResultCache Class
+ *
+ * Bounded least-recently-used map from a skill call's inputs to its
+ * result, for Python skills that declare DETERMINISTIC = True.
+ *
+ * The key holds everything the script sees: both stat dictionaries
+ * (name, current_hp, max_hp, attack, defense, special_defense, speed).
+ * Once full, inserting evicts the entry used longest ago.
+ *
+ * Not thread-safe: PythonSkillLoader keeps one cache per skill and thread,
+ * so lookups need neither a lock nor the GIL.
+ */
+class SkillResultCache {
+public:
+    /**
+     * Inputs of one skill call
+     */
+    struct Key {
+        std::string names[2];       // Attacker, defender
+        int32_t stats[2][6];        // Attacker, defender: stat dictionary values in key order
+
+        Key() = default;
+        Key(const Pokemon& attacker, const Pokemon& defender);
+
+        bool operator==(const Key& other) const;
+    };
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    typedef std::list<std::pair<Key, int>> EntryList;
+
+    EntryList entries;      // Most recently used first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+    size_t capacity;
+    uint64_t hits;
+    uint64_t misses;
+
+public:
+    /**
+     * @param capacity Most entries kept (at least 1)
+     */
+    explicit SkillResultCache(size_t capacity);
+
+    /**
+     * Look up a result and mark it as recently used
+     *
+     * @return Cached result, or nullptr on a miss
+     */
+    const int* find(const Key& key);
+
+    /**
+     * Store a result, evicting the least recently used entry if full
+     */
+    void insert(const Key& key, int result);
+
+    size_t size() const { return entries.size(); }
+    size_t getCapacity() const { return capacity; }
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+};
+
+#endif // SKILL_RESULT_CACHE_H
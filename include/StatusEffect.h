@@ -0,0 +1,77 @@
+#ifndef STATUS_EFFECT_H
+#define STATUS_EFFECT_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * StatusEffect Enumeration
+ * 
+ * Status conditions a Pokemon can suffer from. At most one is active at a
+ * time. Values index the rule table in StatusRules.
+ */
+enum class StatusEffect : uint8_t {
+    NONE,       // No status condition
+    POISONED,   // Loses 1/8 max HP per turn
+    BURNED,     // Loses 1/16 max HP per turn
+    PARALYZED,  // 50% chance to lose its turn
+    ASLEEP,     // Cannot move
+    FROZEN,     // Cannot move
+    CONFUSED,   // 33% chance to hit itself (1/8 max HP) instead of moving
+    SEEDED,     // Loses 1/8 max HP per turn to the opponent (Leech Seed)
+    COUNT       // Number of statuses (not a status)
+};
+
+/**
+ * StatusRule Struct
+ * 
+ * Data-driven behaviour of one status condition.
+ * Battle and Pokemon consult the rule instead of branching on the status,
+ * so a new status only needs an enum value and a table row.
+ */
+struct StatusRule {
+    const char* name;           // Display name ("Poisoned"), also used to parse moves
+    int tickDamageDivisor;      // End-of-turn damage = maxHP / divisor (0 = none)
+    bool drainsToOpponent;      // End-of-turn damage heals the opponent
+    int skipTurnChance;         // Percent chance to lose the turn (0 = never)
+    int selfHitDivisor;         // Damage taken when the turn is lost = maxHP / divisor (0 = none)
+    bool ticksOnLostTurn;       // End-of-turn update also runs when the turn is lost (duration counts down)
+    const char* tickMessage;    // End-of-turn message after the name (nullptr = silent)
+    const char* skipMessage;    // Message after the name when the turn is lost
+};
+
+/**
+ * StatusRules Class
+ * 
+ * Rule table and name conversion for StatusEffect.
+ */
+class StatusRules {
+private:
+    // One rule per StatusEffect, in enum order
+    static const StatusRule rules[static_cast<int>(StatusEffect::COUNT)];
+    
+public:
+    /**
+     * Rule for a status (single indexed load)
+     */
+    static const StatusRule& get(StatusEffect status) {
+        return rules[static_cast<int>(status)];
+    }
+    
+    /**
+     * Display name of a status ("" for NONE)
+     */
+    static const char* name(StatusEffect status) { return get(status).name; }
+    
+    /**
+     * Parse a status name ("Poisoned", "Paralyzed", ...)
+     * An empty name parses as StatusEffect::NONE
+     * 
+     * @param name Status name, case-sensitive
+     * @return Parsed status
+     * @throws std::invalid_argument if the name is not a known status
+     */
+    static StatusEffect parse(const std::string& name);
+};
+
+#endif // STATUS_EFFECT_H
@@ -0,0 +1,86 @@
+#ifndef TEAM_H
+#define TEAM_H
+
+#include "Pokemon.h"
+#include <cstddef>
+
+/**
+ * Team Class
+ *
+ * A party of up to six Pokemon for a TeamBattle, and which of them is in
+ * battle. The Pokemon are borrowed (e.g. from a BattleArena) and must
+ * outlive the team. Members are held in a fixed array, so copying a team
+ * allocates nothing.
+ *
+ * Usage:
+ *   Team red;
+ *   red.add(arena.get(0));     // The first member added leads
+ *   red.add(arena.get(1));
+ */
+class Team {
+public:
+    static const size_t kMaxSize = 6;
+
+private:
+    Pokemon* members[kMaxSize];     // Party in slot order
+    size_t count;                   // Members added so far
+    size_t activeSlot;              // Member in battle
+
+public:
+    Team() : members(), count(0), activeSlot(0) {}
+
+    /**
+     * Add a Pokemon to the party
+     *
+     * @param pokemon Member to add; must outlive the team
+     * @return Its party slot
+     * @throws std::runtime_error if the party already has six members
+     */
+    size_t add(Pokemon& pokemon);
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * Member by party slot (slots are numbered in the order members were added)
+     */
+    Pokemon& get(size_t slot) const { return *members[slot]; }
+
+    /**
+     * The member in battle
+     */
+    Pokemon& active() const { return *members[activeSlot]; }
+    size_t getActiveSlot() const { return activeSlot; }
+
+    /**
+     * Send a member into battle
+     *
+     * @throws std::out_of_range if slot is not a party slot
+     */
+    void setActive(size_t slot);
+
+    /**
+     * Whether the member in slot could be sent in: a healthy Pokemon other
+     * than the active one
+     */
+    bool canSwitchTo(size_t slot) const {
+        return slot < count && slot != activeSlot && !members[slot]->isFainted();
+    }
+
+    /**
+     * Number of members that could be sent in (see canSwitchTo())
+     */
+    size_t benchCount() const;
+
+    /**
+     * First slot that could be sent in, or size() if there is none
+     */
+    size_t firstBenchSlot() const;
+
+    /**
+     * Whether every member has fainted
+     */
+    bool isDefeated() const;
+};
+
+#endif // TEAM_H
@@ -0,0 +1,143 @@
+#ifndef TEAM_BATTLE_H
+#define TEAM_BATTLE_H
+
+#include "BattleEvent.h"
+#include "BattleRng.h"
+#include "DecisionPolicy.h"
+#include "Team.h"
+#include <cstdint>
+
+/**
+ * TeamBattle Class
+ *
+ * Battle between two parties of up to six Pokemon (see Team), one in
+ * battle per side at a time, until one side has no Pokemon left.
+ * Actions use the same rules as Battle (Battle::executeAction()), so
+ * moves, status effects and type effectiveness behave identically.
+ *
+ * Each turn:
+ * 1. Sides may switch instead of moving (faster side first); switches
+ *    happen before any move
+ * 2. The Pokemon in battle act in Speed order (ties go to side 0)
+ * 3. After each action a fainted Pokemon is replaced at once; the
+ *    replacement does not act until the next turn
+ * 4. If the first mover's side runs out of Pokemon by its own action
+ *    (status damage, a confusion self-hit), the second side still acts,
+ *    as in Battle; if both sides run out, side 1 wins
+ *
+ * Turn order is kept incrementally: it is recomputed only when a side
+ * sends in another Pokemon, not every turn. The teams are copied in (a
+ * fixed array each) and nothing is allocated per turn, so team battles
+ * on a BattleArena run at the throughput of 1v1 battles. With teams of
+ * one Pokemon and no switching, the same seed gives the same winner in
+ * the same number of turns as Battle.
+ *
+ * Usage:
+ *   TeamBattle battle(red, blue, seed, events);
+ *   battle.setSwitchChance(10);
+ *   int winner = battle.start();   // 0 or 1
+ */
+class TeamBattle {
+private:
+    Team teams[2];                  // Parties; their active members are in battle
+    BattleEventSink* events;        // Receives everything that happens in the battle
+    BattleRng rng;                  // Random source for this battle only
+    DecisionPolicy* policies[2];    // Decisions of each side (nullptr = random)
+    int switchChance;               // Percent chance per turn a side without a policy switches
+    int turnCount;                  // Turns started so far
+    int switchCount;                // Pokemon sent in so far, voluntarily or after fainting
+    int firstSide;                  // Side that acts first, valid unless orderStale
+    bool orderStale;                // A side sent in another Pokemon since firstSide was set
+
+    /**
+     * Recompute firstSide if a side sent in another Pokemon
+     */
+    void updateTurnOrder();
+
+    /**
+     * Move a side uses this action, from its policy (or at random)
+     */
+    int chooseMove(int side, bool movesFirst);
+
+    /**
+     * Let a side switch at the start of a turn
+     *
+     * @return Whether it switched (and so does not move this turn)
+     */
+    bool trySwitch(int side);
+
+    /**
+     * Report a side's fainted Pokemon (a FAINTED event) and replace it
+     *
+     * @return false if the side has no healthy Pokemon left
+     */
+    bool replaceFainted(int side);
+
+    /**
+     * One side's action, replacing any Pokemon that fainted during it
+     *
+     * @return false if a side has no healthy Pokemon left
+     */
+    bool act(int side, bool movesFirst);
+
+    /**
+     * Send in a party member (a SWITCHED event)
+     */
+    void sendIn(int side, size_t slot);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param team1 Party of side 0 (copied; its Pokemon must outlive the battle
+     *        and must not also be in team2)
+     * @param team2 Party of side 1 (copied; its Pokemon must outlive the battle)
+     * @param seed Seed for this battle's random stream
+     * @param events Sink for battle events; must outlive the battle
+     * @throws std::invalid_argument if a team is empty
+     */
+    TeamBattle(const Team& team1, const Team& team2, uint64_t seed, BattleEventSink& events);
+
+    /**
+     * Choose how each side picks moves, switches and replacements
+     * Without a policy (the default) moves are drawn uniformly at random,
+     * switches follow setSwitchChance(), and a fainted Pokemon is replaced
+     * by the first healthy one in party order.
+     *
+     * @param policy1 Policy of side 0 (nullptr = random); must outlive the battle
+     * @param policy2 Policy of side 1 (nullptr = random); must outlive the battle
+     */
+    void setPolicies(DecisionPolicy* policy1, DecisionPolicy* policy2) {
+        policies[0] = policy1;
+        policies[1] = policy2;
+    }
+
+    /**
+     * Percent chance that a side without a policy switches to a random
+     * healthy bench member at the start of a turn (default 0: never)
+     */
+    void setSwitchChance(int percent) { switchChance = percent; }
+
+    /**
+     * Run the battle until one side has no healthy Pokemon
+     * A battle where both sides run out on the same action is won by
+     * side 1, as in Battle.
+     *
+     * @return Winning side (0 or 1)
+     */
+    int start();
+
+    const Team& getTeam(int side) const { return teams[side]; }
+
+    /**
+     * Number of turns started in this battle (including the final turn)
+     */
+    int getTurnCount() const { return turnCount; }
+
+    /**
+     * Number of Pokemon sent in after the leads (switches and replacements)
+     */
+    int getSwitchCount() const { return switchCount; }
+};
+
+#endif // TEAM_BATTLE_H
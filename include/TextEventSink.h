@@ -0,0 +1,43 @@
+#ifndef TEXT_EVENT_SINK_H
+#define TEXT_EVENT_SINK_H
+
+#include "BattleEvent.h"
+#include <ostream>
+#include <sstream>
+
+/**
+ * TextEventSink Class
+ *
+ * Renders battle events as the familiar battle transcript.
+ * Text is collected in an internal buffer and written to the output stream
+ * in blocks rather than flushed line by line: before each move is used (so
+ * the commentary printed by Python skills stays in order), at the end of
+ * the battle, on flush() and on destruction.
+ */
+class TextEventSink : public BattleEventSink {
+private:
+    std::ostream* out;          // Destination of the rendered transcript
+    std::ostringstream buffer;  // Text not yet written to out
+
+public:
+    /**
+     * Constructor
+     *
+     * @param out Stream to render the transcript to
+     */
+    explicit TextEventSink(std::ostream& out);
+
+    /**
+     * Writes any buffered text
+     */
+    ~TextEventSink() override;
+
+    void onEvent(const BattleEvent& event) override;
+
+    /**
+     * Write buffered text to the output stream and flush it
+     */
+    void flush();
+};
+
+#endif // TEXT_EVENT_SINK_H
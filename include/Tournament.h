@@ -0,0 +1,95 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "DecisionPolicy.h"
+#include "Pokemon.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * TournamentResult Struct
+ * 
+ * Win-rate matrix of a round-robin tournament.
+ * Entry (i, j) describes entrant i fighting entrant j with i as the first
+ * Pokemon of the battle; the diagonal is left empty.
+ */
+struct TournamentResult {
+    std::vector<std::string> names;     // Entrant names, in entrant order
+    int repetitions = 0;                // Battles played per ordered pair
+    std::vector<int> wins;              // wins[i * names.size() + j] = battles i won against j
+    
+    /**
+     * Battles entrant i won as first Pokemon against entrant j
+     */
+    int getWins(size_t i, size_t j) const { return wins[i * names.size() + j]; }
+    
+    /**
+     * Fraction of battles entrant i won against entrant j (0.0 - 1.0)
+     */
+    double winRate(size_t i, size_t j) const {
+        return repetitions > 0 ? static_cast<double>(getWins(i, j)) / repetitions : 0.0;
+    }
+};
+
+/**
+ * Tournament Class
+ * 
+ * Round-robin tournament runner over the Battle engine.
+ * Every ordered pair of distinct entrants fights a fixed number of silent
+ * battles. The work is split into fixed-size chunks of battles that run on
+ * a WorkStealingPool. Each chunk derives its battle seeds from the
+ * tournament seed and its own (pair, chunk) position, and results are
+ * summed per pair afterwards, so the win-rate matrix is identical for any
+ * thread count.
+ * 
+ * Python-backed moves are safe to use. With more than one thread, each
+ * worker runs them in its own PythonSkillLoader::ThreadContext, so they run
+ * in parallel on Python 3.12+ and serialize on the GIL before that.
+ */
+class Tournament {
+private:
+    std::vector<Pokemon> entrants;  // Pristine entrants, copied for every battle
+    int repetitions;                // Battles per ordered pair
+    uint64_t seed;                  // Base seed for the whole tournament
+    std::function<std::unique_ptr<DecisionPolicy>()> policyFactory;  // Move choice (empty = random)
+    
+    // Battles per scheduled task: large enough to amortize scheduling,
+    // small enough to balance uneven matchups across threads
+    static const int kBattlesPerTask = 64;
+    
+public:
+    /**
+     * Constructor
+     * 
+     * @param entrants Pokemon taking part (copied, including movesets)
+     * @param repetitions Battles to play for every ordered pair
+     * @param seed Base seed; the same seed always yields the same matrix
+     */
+    Tournament(const std::vector<Pokemon>& entrants, int repetitions, uint64_t seed);
+    
+    /**
+     * Play the whole tournament
+     * 
+     * @param threads Worker threads (0 = hardware concurrency)
+     * @return Win-rate matrix
+     */
+    TournamentResult run(unsigned threads = 0);
+    
+    /**
+     * Give every Pokemon a policy instead of random move choice
+     * Each task creates its own pair of policies, so a policy is only used
+     * on one thread, and the matrix stays independent of the thread count
+     * for policies that do not depend on timing.
+     * 
+     * @param factory Creates one policy (called on worker threads); empty
+     *                to go back to random moves
+     */
+    void setPolicyFactory(std::function<std::unique_ptr<DecisionPolicy>()> factory) {
+        policyFactory = std::move(factory);
+    }
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,74 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include "Pokemon.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * TranspositionTable Class
+ *
+ * Fixed-size cache of search values keyed by a 64-bit hash of the battle
+ * state: HP, status and status duration of both Pokemon and which one acts
+ * next. Everything else about a matchup (stats, moves) is constant during
+ * a battle, so the key is only valid for one matchup; clear the table when
+ * the Pokemon change.
+ *
+ * Each key maps to one slot; a new value replaces the slot's entry unless
+ * that entry holds a different state searched deeper. A lookup succeeds
+ * when the entry was searched at least as deep as requested.
+ */
+class TranspositionTable {
+private:
+    struct Entry {
+        uint64_t key = 0;       // State hash (0 = empty)
+        double value = 0.0;     // Search value of the state
+        int depth = -1;         // Remaining depth the value was searched to
+    };
+
+    std::vector<Entry> entries;     // Power-of-two number of slots
+    size_t mask;                    // entries.size() - 1
+    size_t hits;                    // Successful lookups since clear()
+    size_t used;                    // Occupied slots
+
+public:
+    /**
+     * Constructor
+     *
+     * @param capacity Number of slots, rounded up to a power of two
+     */
+    explicit TranspositionTable(size_t capacity);
+
+    /**
+     * Hash of a battle state (never 0)
+     *
+     * @param first State of the Pokemon acting first in each turn
+     * @param second State of the other Pokemon
+     * @param actor Which one acts next (0 = first, 1 = second)
+     */
+    static uint64_t key(const PokemonState& first, const PokemonState& second, int actor);
+
+    /**
+     * Value of a state searched at least `depth` deep
+     *
+     * @return true if found (value is set)
+     */
+    bool find(uint64_t key, int depth, double& value);
+
+    /**
+     * Record the value of a state searched `depth` deep
+     */
+    void store(uint64_t key, int depth, double value);
+
+    /**
+     * Forget every entry
+     */
+    void clear();
+
+    size_t capacity() const { return entries.size(); }
+    size_t size() const { return used; }
+    size_t getHits() const { return hits; }
+};
+
+#endif // TRANSPOSITION_TABLE_H
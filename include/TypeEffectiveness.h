@@ -1,9 +1,37 @@
 #ifndef TYPE_EFFECTIVENESS_H
 #define TYPE_EFFECTIVENESS_H
 
+#include <cstdint>
 #include <string>
-#include <map>
-#include <utility>
+
+/**
+ * PokemonType Enumeration
+ * 
+ * The 18 Pokemon types. Values index the rows and columns of the type
+ * chart directly. Types are parsed from their display names once, when a
+ * Pokemon or Move is constructed.
+ */
+enum class PokemonType : uint8_t {
+    NORMAL,
+    FIRE,
+    WATER,
+    ELECTRIC,
+    GRASS,
+    ICE,
+    FIGHTING,
+    POISON,
+    GROUND,
+    FLYING,
+    PSYCHIC,
+    BUG,
+    ROCK,
+    GHOST,
+    DRAGON,
+    DARK,
+    STEEL,
+    FAIRY,
+    COUNT       // Number of types (not a type)
+};
 
 /**
  * TypeEffectiveness Class
@@ -12,42 +40,93 @@
  * Implements the type advantage/disadvantage system where certain types
  * deal more or less damage to other types.
  * 
+ * The chart is a dense 18x18 table built at compile time, so a lookup by
+ * PokemonType is a single indexed load. The string overload is kept for
+ * callers that still work with type names.
+ * 
  * Examples:
  * - Water beats Fire (2x damage)
  * - Fire beats Grass (2x damage)
  * - Electric has no effect on Ground (0x damage)
  */
 class TypeEffectiveness {
-private:
+public:
+    static const int kTypeCount = static_cast<int>(PokemonType::COUNT);
+    
     /**
-     * Map of type matchups to effectiveness multipliers
-     * Key: (attacking type, defending type)
-     * Value: multiplier (2.0 = super effective, 0.5 = not very effective, 0.0 = no effect)
+     * Dense multiplier table
+     * multipliers[attack][defense] (2.0 = super effective, 0.5 = not very
+     * effective, 0.0 = no effect, 1.0 = everything else)
      */
-    static std::map<std::pair<std::string, std::string>, double> effectivenessChart;
-    
-    // Flag to ensure chart is only initialized once
-    static bool initialized;
+    struct Chart {
+        double multipliers[kTypeCount][kTypeCount];
+    };
     
+private:
     /**
-     * Initialize the type effectiveness chart with all matchups
-     * Called automatically on first use
+     * Build the type chart with all matchups
+     * Evaluated at compile time
      */
-    static void initializeChart();
+    static constexpr Chart buildChart();
+    
+    // Compile-time type chart
+    static const Chart chart;
     
 public:
     /**
      * Get the type effectiveness multiplier for an attack
      * 
-     * @param attackType Type of the attacking move (e.g., "Electric")
-     * @param defenseType Type of the defending Pokemon (e.g., "Water")
+     * @param attackType Type of the attacking move
+     * @param defenseType Type of the defending Pokemon
      * @return Effectiveness multiplier:
      *         - 2.0: Super effective
      *         - 1.0: Normal effectiveness (default)
      *         - 0.5: Not very effective
      *         - 0.0: No effect (immune)
      */
+    static double getEffectiveness(PokemonType attackType, PokemonType defenseType) {
+        return chart.multipliers[static_cast<int>(attackType)][static_cast<int>(defenseType)];
+    }
+    
+    /**
+     * The whole chart, for table-driven callers (e.g. DamageKernel)
+     */
+    static const Chart& getChart() {
+        return chart;
+    }
+    
+    /**
+     * Get the type effectiveness multiplier for an attack by type name
+     * Unknown type names are treated as neutral (1.0)
+     * 
+     * @param attackType Type of the attacking move (e.g., "Electric")
+     * @param defenseType Type of the defending Pokemon (e.g., "Water")
+     * @return Effectiveness multiplier (see above)
+     */
     static double getEffectiveness(const std::string& attackType, const std::string& defenseType);
+    
+    /**
+     * Parse a type name ("Fire", "Water", ...)
+     * 
+     * @param name Type name, case-sensitive
+     * @param type Receives the parsed type on success
+     * @return true if the name is a known type
+     */
+    static bool tryParseType(const std::string& name, PokemonType& type);
+    
+    /**
+     * Parse a type name, rejecting unknown names
+     * 
+     * @param name Type name, case-sensitive
+     * @return Parsed type
+     * @throws std::invalid_argument if the name is not a known type
+     */
+    static PokemonType parseType(const std::string& name);
+    
+    /**
+     * Display name of a type (e.g., "Electric")
+     */
+    static const char* typeName(PokemonType type);
 };
 
 #endif // TYPE_EFFECTIVENESS_H
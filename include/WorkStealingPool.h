@@ -0,0 +1,82 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * WorkStealingPool Class
+ * 
+ * Runs a batch of independent tasks on a fixed number of threads.
+ * Tasks are dealt round-robin into one deque per worker. Each worker pops
+ * from the back of its own deque and, when it runs dry, steals from the
+ * front of another worker's deque, so uneven task lengths still keep all
+ * threads busy. The calling thread acts as worker 0.
+ */
+class WorkStealingPool {
+private:
+    /**
+     * Per-worker task queue
+     */
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    
+    unsigned threadCount;                               // Worker threads including the caller
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // One queue per worker
+    std::function<void(const std::function<void()>&)> workerScope;  // Wraps each worker loop (may be empty)
+    
+    /**
+     * Take the next task for a worker: own queue first, then steal
+     * 
+     * @param worker Index of the worker looking for work
+     * @param task Receives the task
+     * @return false when every queue is empty
+     */
+    bool takeTask(unsigned worker, std::function<void()>& task);
+    
+    /**
+     * Worker loop: run tasks until no work is left anywhere
+     */
+    void workerLoop(unsigned worker);
+    
+public:
+    /**
+     * Constructor
+     * 
+     * @param threads Number of worker threads (0 = hardware concurrency)
+     */
+    explicit WorkStealingPool(unsigned threads = 0);
+    
+    /**
+     * Number of worker threads used by run()
+     */
+    unsigned getThreadCount() const { return threadCount; }
+    
+    /**
+     * Wrap every worker's task loop, on the worker's own thread
+     * The scope must call loop() exactly once; anything it sets up around
+     * the call (e.g. a PythonSkillLoader::ThreadContext) lives for the
+     * worker's whole share of a run().
+     * 
+     * @param scope Function receiving the worker loop to run
+     */
+    void setWorkerScope(std::function<void(const std::function<void()>& loop)> scope) {
+        workerScope = std::move(scope);
+    }
+    
+    /**
+     * Run all tasks and block until they have finished
+     * If tasks throw, the first exception is rethrown after all workers stop
+     * 
+     * @param tasks Independent tasks (order of execution is unspecified)
+     */
+    void run(std::vector<std::function<void()>> tasks);
+};
+
+#endif // WORK_STEALING_POOL_H
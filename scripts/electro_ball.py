@@ -3,6 +3,13 @@ Electro Ball - Electric type special attack
 Power based on speed difference between attacker and defender
 """
 
+# Power tiers by the attacker/defender speed ratio
+NATIVE_SKILL = {
+    "power": {"speed_ratio": [(4, 150), (3, 120), (2, 80), (1, 60)], "default": 40},
+    "defense": "special_defense",
+    "random": (85, 100),
+}
+
 def calculate_damage(attacker, defender):
     """
     Special attack with power based on speed ratio
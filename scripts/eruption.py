@@ -3,29 +3,30 @@ Eruption - Fire type special attack
 Power decreases as user's HP decreases
 """
 
-def calculate_damage(attacker, defender):
+# Power 150 scaled by the attacker's remaining HP
+NATIVE_SKILL = {
+    "power": {"hp_ratio": 150},
+    "defense": "special_defense",
+    "random": (85, 100),
+}
+
+def eruption_power(current_hp, max_hp):
     """
-    Special attack whose power scales with remaining HP
-    
-    Args:
-        attacker: Dictionary with attacker's stats
-        defender: Dictionary with defender's stats
-        
-    Returns:
-        int: Damage amount to deal
+    Base power from the remaining HP ratio
+    Maximum power of 150 at full HP, minimum of 1
+    """
+    hp_ratio = current_hp / max_hp
+    return max(1, int(150 * hp_ratio))
+
+
+def eruption_damage(base_power, attack_stat, defense_stat):
+    """
+    Eruption damage for one hit (draws one random factor)
     """
     import random
     
-    # Calculate base power based on remaining HP ratio
-    # Maximum power of 150 at full HP, minimum of 1
-    hp_ratio = attacker['current_hp'] / attacker['max_hp']
-    base_power = int(150 * hp_ratio)
-    base_power = max(1, base_power)
-    
     # Damage calculation
     level = 50
-    attack_stat = attacker['attack']
-    defense_stat = defender['special_defense']
     
     damage = ((2 * level / 5 + 2) * base_power * attack_stat / defense_stat) / 50 + 2
     damage = int(damage)
@@ -35,7 +36,23 @@ def calculate_damage(attacker, defender):
     damage = int(damage * random_factor)
     
     # Minimum damage
-    damage = max(1, damage)
+    return max(1, damage)
+
+
+def calculate_damage(attacker, defender):
+    """
+    Special attack whose power scales with remaining HP
+    
+    Args:
+        attacker: Dictionary with attacker's stats
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        int: Damage amount to deal
+    """
+    hp_ratio = attacker['current_hp'] / attacker['max_hp']
+    base_power = eruption_power(attacker['current_hp'], attacker['max_hp'])
+    damage = eruption_damage(base_power, attacker['attack'], defender['special_defense'])
     
     hp_percent = int(hp_ratio * 100)
     print(f"[Python] Eruption: {attacker['name']} unleashes fire with {hp_percent}% HP!")
@@ -43,3 +60,12 @@ def calculate_damage(attacker, defender):
     print(f"[Python] Calculated damage: {damage}")
     
     return damage
+
+
+def calculate_damage_batch(attackers, defenders):
+    """
+    Eruption damage for every hit of a batch, without the output
+    """
+    return [eruption_damage(eruption_power(current_hp, max_hp), attack_stat, defense_stat)
+            for current_hp, max_hp, attack_stat, defense_stat in zip(
+                attackers['current_hp'], attackers['max_hp'], attackers['attack'], defenders['special_defense'])]
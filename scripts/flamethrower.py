@@ -3,43 +3,69 @@ Flamethrower skill - Fire type attack
 This is an example of how to define Pokemon skills in Python
 """
 
-def calculate_damage(attacker, defender):
+# The 10% burn bonus is rolled after the random factor
+NATIVE_SKILL = {
+    "power": 90,
+    "defense": "defense",
+    "random": (85, 100),
+    "bonus": {"chance": 10, "multiplier": 1.5},
+}
+
+def flamethrower_damage(attack_stat, defense_stat):
     """
-    Calculate damage for Flamethrower attack
+    Flamethrower damage for one hit (draws the random factor, then the burn)
     
-    Args:
-        attacker: Dictionary with attacker's stats (name, current_hp, max_hp, attack, defense, speed)
-        defender: Dictionary with defender's stats
-        
     Returns:
-        int: Damage amount to deal
+        tuple: (damage, whether the burn bonus applied)
     """
+    import random
+    
     # Base power for Flamethrower
     base_power = 90
     
     # Calculate damage using Pokemon formula
     level = 50  # Assume level 50
-    attack_stat = attacker['attack']
-    defense_stat = defender['defense']
     
     damage = ((2 * level / 5 + 2) * base_power * attack_stat / defense_stat) / 50 + 2
     damage = int(damage)
     
     # Random factor (85% to 100%)
-    import random
     random_factor = random.randint(85, 100) / 100.0
     damage = int(damage * random_factor)
     
     # Add burn chance (10% chance to increase damage by 50%)
-    burn_chance = random.randint(1, 100)
-    if burn_chance <= 10:
+    burned = random.randint(1, 100) <= 10
+    if burned:
         damage = int(damage * 1.5)
-        print(f"[Python] Critical burn! Extra damage!")
     
     # Minimum damage
-    damage = max(1, damage)
+    return max(1, damage), burned
+
+
+def calculate_damage(attacker, defender):
+    """
+    Calculate damage for Flamethrower attack
+    
+    Args:
+        attacker: Dictionary with attacker's stats (name, current_hp, max_hp, attack, defense, speed)
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        int: Damage amount to deal
+    """
+    damage, burned = flamethrower_damage(attacker['attack'], defender['defense'])
+    if burned:
+        print(f"[Python] Critical burn! Extra damage!")
     
     print(f"[Python] Flamethrower: {attacker['name']} attacks {defender['name']}")
     print(f"[Python] Calculated damage: {damage}")
     
     return damage
+
+
+def calculate_damage_batch(attackers, defenders):
+    """
+    Flamethrower damage for every hit of a batch, without the output
+    """
+    return [flamethrower_damage(attack_stat, defense_stat)[0]
+            for attack_stat, defense_stat in zip(attackers['attack'], defenders['defense'])]
@@ -2,6 +2,10 @@
 Healing move that restores HP
 """
 
+DETERMINISTIC = True
+
+PRECOMPILE = True
+
 def calculate_damage(attacker, defender):
     """
     Healing move - returns negative damage to indicate healing amount
@@ -22,3 +26,15 @@ def calculate_damage(attacker, defender):
     # Return negative to indicate healing
     return -heal_amount
 
+def damage_distribution(attacker, defender):
+    """
+    Recover always heals 50% of max HP
+    
+    Args:
+        attacker: Dictionary with attacker's stats
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        list: One (negative healing amount, probability 1.0) pair
+    """
+    return [(-int(attacker['max_hp'] * 0.5), 1.0)]
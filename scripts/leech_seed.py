@@ -3,6 +3,10 @@ Leech Seed - Grass type status move
 Drains HP each turn (implemented in C++)
 """
 
+DETERMINISTIC = True
+
+PRECOMPILE = True
+
 def calculate_damage(attacker, defender):
     """
     Status move that drains HP over time
@@ -19,3 +23,16 @@ def calculate_damage(attacker, defender):
     
     # Return 0 damage (leech effect would be applied by C++ each turn)
     return 0
+
+def damage_distribution(attacker, defender):
+    """
+    Planting the seed never deals damage; the drain comes later, each turn
+    
+    Args:
+        attacker: Dictionary with attacker's stats
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        list: One (0 damage, probability 1.0) pair
+    """
+    return [(0, 1.0)]
@@ -3,6 +3,14 @@ Slash - Normal type physical attack
 High critical hit ratio move
 """
 
+# The 30% critical bonus is rolled before the random factor
+NATIVE_SKILL = {
+    "power": 70,
+    "defense": "defense",
+    "random": (85, 100),
+    "bonus": {"chance": 30, "multiplier": 1.5, "before_random": True},
+}
+
 def calculate_damage(attacker, defender):
     """
     Physical attack with increased critical hit chance
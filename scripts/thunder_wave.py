@@ -3,6 +3,10 @@ Thunder Wave skill - Electric type status move
 Paralyzes the target
 """
 
+DETERMINISTIC = True
+
+PRECOMPILE = True
+
 def calculate_damage(attacker, defender):
     """
     Thunder Wave move - inflicts paralysis on the defender
@@ -18,3 +22,16 @@ def calculate_damage(attacker, defender):
     print(f"[Python] {defender['name']}'s Speed is reduced!")
     
     return 0
+
+def damage_distribution(attacker, defender):
+    """
+    Thunder Wave only paralyzes, so it always deals 0 damage
+    
+    Args:
+        attacker: Dictionary with attacker's stats
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        list: One (0 damage, probability 1.0) pair
+    """
+    return [(0, 1.0)]
@@ -3,17 +3,18 @@ Thunderbolt skill - Electric type attack
 This is an example of how to define Pokemon skills in Python
 """
 
-def calculate_damage(attacker, defender):
+NATIVE_SKILL = {
+    "power": 90,
+    "defense": "defense",
+    "random": (85, 100),
+}
+
+def thunderbolt_damage(attack_stat, defense_stat):
     """
-    Calculate damage for Thunderbolt attack
-    
-    Args:
-        attacker: Dictionary with attacker's stats (name, current_hp, max_hp, attack, defense, speed)
-        defender: Dictionary with defender's stats
-        
-    Returns:
-        int: Damage amount to deal
+    Thunderbolt damage for one hit (draws one random factor)
     """
+    import random
+    
     # Base power for Thunderbolt
     base_power = 90
     
@@ -21,21 +22,40 @@ def calculate_damage(attacker, defender):
     # Damage = ((2 * Level / 5 + 2) * Power * Attack / Defense) / 50 + 2
     # Simplified version for this demo
     level = 50  # Assume level 50
-    attack_stat = attacker['attack']
-    defense_stat = defender['defense']
     
     damage = ((2 * level / 5 + 2) * base_power * attack_stat / defense_stat) / 50 + 2
     damage = int(damage)
     
     # Random factor (85% to 100%)
-    import random
     random_factor = random.randint(85, 100) / 100.0
     damage = int(damage * random_factor)
     
     # Minimum damage
-    damage = max(1, damage)
+    return max(1, damage)
+
+
+def calculate_damage(attacker, defender):
+    """
+    Calculate damage for Thunderbolt attack
+    
+    Args:
+        attacker: Dictionary with attacker's stats (name, current_hp, max_hp, attack, defense, speed)
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        int: Damage amount to deal
+    """
+    damage = thunderbolt_damage(attacker['attack'], defender['defense'])
     
     print(f"[Python] Thunderbolt: {attacker['name']} attacks {defender['name']}")
     print(f"[Python] Calculated damage: {damage}")
     
     return damage
+
+
+def calculate_damage_batch(attackers, defenders):
+    """
+    Thunderbolt damage for every hit of a batch, without the output
+    """
+    return [thunderbolt_damage(attack_stat, defense_stat)
+            for attack_stat, defense_stat in zip(attackers['attack'], defenders['defense'])]
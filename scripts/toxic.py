@@ -3,6 +3,10 @@ Toxic skill - Poison type status move
 Badly poisons the target
 """
 
+DETERMINISTIC = True
+
+PRECOMPILE = True
+
 def calculate_damage(attacker, defender):
     """
     Toxic move - inflicts poison status on the defender
@@ -19,3 +23,16 @@ def calculate_damage(attacker, defender):
     
     # Return 0 damage (status effect is applied by C++ code)
     return 0
+
+def damage_distribution(attacker, defender):
+    """
+    Toxic only poisons, so it always deals 0 damage (poison ticks are applied in C++)
+    
+    Args:
+        attacker: Dictionary with attacker's stats
+        defender: Dictionary with defender's stats
+        
+    Returns:
+        list: One (0 damage, probability 1.0) pair
+    """
+    return [(0, 1.0)]
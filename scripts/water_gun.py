@@ -3,6 +3,12 @@ Water Gun skill - Water type attack
 Basic water attack
 """
 
+NATIVE_SKILL = {
+    "power": 40,
+    "defense": "defense",
+    "random": (85, 100),
+}
+
 def calculate_damage(attacker, defender):
     """
     Calculate damage for Water Gun attack
@@ -1,12 +1,44 @@
 #include "Battle.h"
 #include "Move.h"
-#include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include "Instrumentation.h"
+#include "TextEventSink.h"
+#include <random>
 
-// Constructor: Initialize battle with two Pokemon
-Battle::Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2)
-    : pokemon1(p1), pokemon2(p2) {
+namespace {
+
+// Nondeterministic seed for battles constructed without one
+uint64_t randomSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+} // namespace
+
+// Constructor: Initialize battle with two Pokemon and a nondeterministic seed
+Battle::Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, std::ostream& out)
+    : Battle(p1, p2, randomSeed(), out) {
+}
+
+// Constructor: Initialize battle with two Pokemon and a fixed seed
+Battle::Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, uint64_t seed, std::ostream& out)
+    : pokemon1(p1), pokemon2(p2), ownedEvents(new TextEventSink(out)), events(ownedEvents.get()),
+      rng(seed), turnCount(0), policies{nullptr, nullptr} {
+}
+
+// Constructor: event sink, nondeterministic seed
+Battle::Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, BattleEventSink& events)
+    : Battle(p1, p2, randomSeed(), events) {
+}
+
+// Constructor: event sink, fixed seed
+Battle::Battle(std::shared_ptr<Pokemon> p1, std::shared_ptr<Pokemon> p2, uint64_t seed, BattleEventSink& events)
+    : pokemon1(p1), pokemon2(p2), events(&events), rng(seed), turnCount(0), policies{nullptr, nullptr} {
+}
+
+// Constructor: borrowed Pokemon (aliasing pointers without a control block)
+Battle::Battle(Pokemon& p1, Pokemon& p2, uint64_t seed, BattleEventSink& events)
+    : pokemon1(std::shared_ptr<Pokemon>(), &p1), pokemon2(std::shared_ptr<Pokemon>(), &p2),
+      events(&events), rng(seed), turnCount(0), policies{nullptr, nullptr} {
 }
 
 // Determine which Pokemon attacks first based on Speed stat
@@ -19,82 +51,118 @@ Pokemon& Battle::determineFirstAttacker() {
     return *pokemon2;
 }
 
+// Ask the attacker's policy for a move, or draw one at random
+int Battle::chooseMove(Pokemon& attacker, Pokemon& defender, bool movesFirst) {
+    DecisionPolicy* policy = policies[&attacker == pokemon1.get() ? 0 : 1];
+    if (policy == nullptr) {
+        return rng.nextInt(static_cast<int>(attacker.getMoveCount()));
+    }
+    return policy->chooseMove(attacker, defender, movesFirst, rng);
+}
+
 // Execute a single turn for one Pokemon
 void Battle::executeTurn(Pokemon& attacker, Pokemon& defender, int moveIndex) {
+    executeAction(attacker, defender, moveIndex, rng, *events);
+}
+
+// One Pokemon's action, shared by Battle and TeamBattle
+void Battle::executeAction(Pokemon& attacker, Pokemon& defender, int moveIndex, BattleRng& rng, BattleEventSink& events) {
+    POKEMON_PROBE(ACTION);
+    
     // Check if attacker has any moves
-    if (attacker.getMoves().empty()) {
-        std::cout << attacker.getName() << " has no moves!" << std::endl;
+    if (attacker.getMoveCount() == 0) {
+        events.onEvent(BattleEvent(BattleEventType::NO_MOVES, &attacker, &defender));
         return;
     }
     
-    // Check paralysis - 50% chance to be fully paralyzed
-    if (attacker.getStatusEffect() == "Paralyzed") {
-        if (rand() % 100 < 50) {
-            std::cout << attacker.getName() << " is fully paralyzed and can't move!" << std::endl;
-            return;
+    // Status check: paralysis, sleep, freeze and confusion may cost the turn
+    const StatusRule& rule = StatusRules::get(attacker.getStatusEffect());
+    if (rule.skipTurnChance > 0 && rng.nextInt(100) < rule.skipTurnChance) {
+        int selfDamage = 0;
+        if (rule.selfHitDivisor > 0) {
+            selfDamage = attacker.getMaxHP() / rule.selfHitDivisor;
+            attacker.takeDamage(selfDamage);
         }
+        BattleEvent event(BattleEventType::TURN_LOST, &attacker, &defender, nullptr, selfDamage);
+        event.status = attacker.getStatusEffect();
+        events.onEvent(event);
+        
+        // Only sleep and freeze wear off while the Pokemon cannot move
+        if (!rule.ticksOnLostTurn) return;
+    } else {
+        // Validate move index, default to first move if invalid
+        if (moveIndex < 0 || moveIndex >= static_cast<int>(attacker.getMoveCount())) {
+            moveIndex = 0;
+        }
+        
+        // Execute the selected move
+        attacker.getMove(moveIndex).execute(attacker, defender, rng, events);
     }
     
-    // Validate move index, default to first move if invalid
-    if (moveIndex < 0 || moveIndex >= static_cast<int>(attacker.getMoves().size())) {
-        moveIndex = 0;
-    }
+    // Apply status effect damage/effects at end of turn
+    POKEMON_PROBE(STATUS_TICK);
+    StatusTick tick = attacker.updateStatus();
+    if (tick.status == StatusEffect::NONE) return;
     
-    // Execute the selected move
-    auto move = attacker.getMoves()[moveIndex];
-    move->execute(attacker, defender);
+    BattleEvent event(BattleEventType::STATUS_TICK, &attacker, &defender, nullptr, tick.damage);
+    event.status = tick.status;
+    events.onEvent(event);
     
-    // Apply status effect damage/effects at end of turn
-    attacker.updateStatus();
+    if (tick.drained > 0 && !defender.isFainted()) {
+        defender.heal(tick.drained);
+        BattleEvent absorbed(BattleEventType::ABSORBED, &defender, &attacker, nullptr, tick.drained);
+        absorbed.status = tick.status;
+        events.onEvent(absorbed);
+    }
+    
+    if (tick.recovered) {
+        BattleEvent recovered(BattleEventType::STATUS_RECOVERED, &attacker, &defender);
+        recovered.status = tick.status;
+        events.onEvent(recovered);
+    }
 }
 
-// Display current state of both Pokemon
+// Report current state of both Pokemon
 void Battle::displayBattleState() const {
-    std::cout << "\n=== Battle State ===" << std::endl;
-    pokemon1->displayStatus();
-    std::cout << "VS" << std::endl;
-    pokemon2->displayStatus();
-    std::cout << "==================\n" << std::endl;
+    events->onEvent(BattleEvent(BattleEventType::STATE_SNAPSHOT, pokemon1.get(), pokemon2.get()));
 }
 
 // Start the battle and run until one Pokemon faints
 std::shared_ptr<Pokemon> Battle::start() {
-    std::cout << "\n*** Battle Start! ***" << std::endl;
-    std::cout << pokemon1->getName() << " vs " << pokemon2->getName() << "!" << std::endl;
+    events->onEvent(BattleEvent(BattleEventType::BATTLE_START, pokemon1.get(), pokemon2.get()));
     
     // Display initial battle state
     displayBattleState();
     
-    int turn = 0;
+    turnCount = 0;
     
     // Battle loop: continue until one Pokemon faints
     while (!pokemon1->isFainted() && !pokemon2->isFainted()) {
-        std::cout << "\n--- Turn " << ++turn << " ---" << std::endl;
+        events->onEvent(BattleEvent(BattleEventType::TURN_START, nullptr, nullptr, nullptr, ++turnCount));
         
         // Determine turn order based on Speed stat
         Pokemon& first = determineFirstAttacker();
         Pokemon& second = ((&first == pokemon1.get()) ? *pokemon2 : *pokemon1);
         
         // First attacker's turn
-        std::cout << "\n" << first.getName() << "'s turn:" << std::endl;
-        // Randomly select a move (in a real game, this would be player/AI choice)
-        int firstMoveIndex = rand() % first.getMoves().size();
+        events->onEvent(BattleEvent(BattleEventType::ACTION_START, &first, &second));
+        int firstMoveIndex = chooseMove(first, second, true);
         executeTurn(first, second, firstMoveIndex);
         
         // Check if second Pokemon fainted from the attack
         if (second.isFainted()) {
-            std::cout << "\n" << second.getName() << " fainted!" << std::endl;
+            events->onEvent(BattleEvent(BattleEventType::FAINTED, &second, &first));
             break;
         }
         
         // Second attacker's turn
-        std::cout << "\n" << second.getName() << "'s turn:" << std::endl;
-        int secondMoveIndex = rand() % second.getMoves().size();
+        events->onEvent(BattleEvent(BattleEventType::ACTION_START, &second, &first));
+        int secondMoveIndex = chooseMove(second, first, false);
         executeTurn(second, first, secondMoveIndex);
         
         // Check if first Pokemon fainted from the counter-attack
         if (first.isFainted()) {
-            std::cout << "\n" << first.getName() << " fainted!" << std::endl;
+            events->onEvent(BattleEvent(BattleEventType::FAINTED, &first, &second));
             break;
         }
         
@@ -104,7 +172,8 @@ std::shared_ptr<Pokemon> Battle::start() {
     
     // Determine and announce winner
     std::shared_ptr<Pokemon> winner = pokemon1->isFainted() ? pokemon2 : pokemon1;
-    std::cout << "\n*** " << winner->getName() << " wins the battle! ***\n" << std::endl;
+    std::shared_ptr<Pokemon> loser = (winner == pokemon1) ? pokemon2 : pokemon1;
+    events->onEvent(BattleEvent(BattleEventType::BATTLE_END, winner.get(), loser.get()));
     
     return winner;
 }
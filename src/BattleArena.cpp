@@ -0,0 +1,36 @@
+#include "BattleArena.h"
+#include <stdexcept>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<PokemonState>::value,
+              "PokemonState must stay plain data so restore() is a flat copy");
+
+// Constructor: reserve the roster so Pokemon never move
+BattleArena::BattleArena(size_t capacity) {
+    pokemon.reserve(capacity);
+    saved.reserve(capacity);
+}
+
+// Copy a Pokemon in; its current state is its initial snapshot
+Pokemon& BattleArena::add(const Pokemon& prototype) {
+    if (pokemon.size() == pokemon.capacity()) {
+        throw std::runtime_error("Battle arena is full");
+    }
+    pokemon.push_back(prototype);
+    saved.push_back(prototype.getState());
+    return pokemon.back();
+}
+
+// Save every Pokemon's state
+void BattleArena::snapshot() {
+    for (size_t i = 0; i < pokemon.size(); ++i) {
+        saved[i] = pokemon[i].getState();
+    }
+}
+
+// Write the saved states back
+void BattleArena::restore() {
+    for (size_t i = 0; i < pokemon.size(); ++i) {
+        pokemon[i].setState(saved[i]);
+    }
+}
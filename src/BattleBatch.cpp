@@ -0,0 +1,242 @@
+#include "BattleBatch.h"
+#include "DamageKernel.h"
+#include "Move.h"
+#include "Pokemon.h"
+#include "TypeEffectiveness.h"
+#include <algorithm>
+#include <stdexcept>
+
+const uint8_t BattleBatch::kRunning;
+
+bool BattleBatch::supports(const Pokemon& pokemon) {
+    for (MoveId id : pokemon.getMoveIds()) {
+        if (MoveRegistry::get(id).hasCustomEffect()) return false;
+    }
+    return pokemon.getMoveCount() <= 0xFF;
+}
+
+void BattleBatch::addMoves(Side& side, const Pokemon& pokemon, const Pokemon& opponent) {
+    side.moveBase.push_back(static_cast<uint32_t>(moves.power.size()));
+    side.moveCount.push_back(static_cast<uint8_t>(pokemon.getMoveCount()));
+    for (MoveId id : pokemon.getMoveIds()) {
+        const Move& move = MoveRegistry::get(id);
+        bool statusMove = move.getCategory() == MoveCategory::STATUS;
+        moves.power.push_back(move.getBasePower());
+        moves.accuracy.push_back(move.getAccuracy());
+        moves.effectiveness.push_back(TypeEffectiveness::getEffectiveness(move.getTypeId(), opponent.getTypeId()));
+        moves.special.push_back(move.getCategory() == MoveCategory::SPECIAL ? 1 : 0);
+        moves.status.push_back(static_cast<uint8_t>(statusMove ? move.getStatusEffect() : StatusEffect::NONE));
+        moves.statusDuration.push_back(move.getStatusDuration());
+    }
+}
+
+size_t BattleBatch::add(const Pokemon& p1, const Pokemon& p2, uint64_t seed) {
+    if (!supports(p1) || !supports(p2)) {
+        throw std::invalid_argument("BattleBatch only supports moves with the built-in damage formula");
+    }
+
+    const Pokemon* pokemon[2] = {&p1, &p2};
+    for (int s = 0; s < 2; ++s) {
+        Side& side = sides[s];
+        const Pokemon& p = *pokemon[s];
+        side.hp.push_back(p.getCurrentHP());
+        side.maxHP.push_back(p.getMaxHP());
+        side.attack.push_back(p.getAttack());
+        side.defense.push_back(p.getDefense());
+        side.specialDefense.push_back(p.getSpecialDefense());
+        side.status.push_back(static_cast<uint8_t>(p.getStatusEffect()));
+        side.statusDuration.push_back(p.getStatusDuration());
+        addMoves(side, p, *pokemon[1 - s]);
+    }
+
+    size_t battle = turns.size();
+    rngs.emplace_back(seed);
+    firstSide.push_back(p1.getSpeed() >= p2.getSpeed() ? 0 : 1);
+    turns.push_back(0);
+
+    // A battle that starts with a fainted Pokemon is over before turn 1
+    if (p1.isFainted() || p2.isFainted()) {
+        winners.push_back(p1.isFainted() ? 1 : 0);
+    } else {
+        winners.push_back(kRunning);
+        running.push_back(static_cast<uint32_t>(battle));
+    }
+    return battle;
+}
+
+void BattleBatch::reserve(size_t battles) {
+    for (auto& side : sides) {
+        side.hp.reserve(battles);
+        side.maxHP.reserve(battles);
+        side.attack.reserve(battles);
+        side.defense.reserve(battles);
+        side.specialDefense.reserve(battles);
+        side.status.reserve(battles);
+        side.statusDuration.reserve(battles);
+        side.moveBase.reserve(battles);
+        side.moveCount.reserve(battles);
+    }
+    rngs.reserve(battles);
+    firstSide.reserve(battles);
+    turns.reserve(battles);
+    winners.reserve(battles);
+    running.reserve(battles);
+}
+
+void BattleBatch::clear() {
+    for (auto& side : sides) {
+        side.hp.clear();
+        side.maxHP.clear();
+        side.attack.clear();
+        side.defense.clear();
+        side.specialDefense.clear();
+        side.status.clear();
+        side.statusDuration.clear();
+        side.moveBase.clear();
+        side.moveCount.clear();
+    }
+    moves.power.clear();
+    moves.accuracy.clear();
+    moves.effectiveness.clear();
+    moves.special.clear();
+    moves.status.clear();
+    moves.statusDuration.clear();
+    rngs.clear();
+    firstSide.clear();
+    turns.clear();
+    winners.clear();
+    running.clear();
+}
+
+// Mirrors Battle::executeTurn() for every battle in the acting list
+void BattleBatch::halfTurn(bool secondMover) {
+    const size_t count = acting.size();
+    acted.resize(count);
+    selfDamage.resize(count);
+    inflictedStatus.resize(count);
+    inflictedDuration.resize(count);
+    hitAttack.resize(count);
+    hitDefense.resize(count);
+    hitPower.resize(count);
+    hitAccuracy.resize(count);
+    hitRoll.resize(count);
+    hitEffectiveness.resize(count);
+    hitDamage.resize(count);
+
+    // Pass 1: all random draws of the half-turn, in Battle's order. Every
+    // outcome is written as plain numbers (a lost turn gets accuracy 0, so
+    // it can never hit), so the later passes apply them without branching
+    // on the outcome.
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t k = acting[i];
+        const int actor = firstSide[k] ^ (secondMover ? 1 : 0);
+        const Side& self = sides[actor];
+        const Side& foe = sides[1 - actor];
+        BattleRng rng = rngs[k];    // Local copy stays in registers
+
+        const int moveCount = self.moveCount[k];
+        const uint32_t move = self.moveBase[k] + static_cast<uint32_t>(rng.nextInt(moveCount));
+        acted[i] = moveCount > 0 ? 1 : 0;
+        selfDamage[i] = 0;
+        inflictedStatus[i] = static_cast<uint8_t>(StatusEffect::NONE);
+        inflictedDuration[i] = 0;
+        hitAttack[i] = self.attack[k];
+        hitDefense[i] = 1;
+        hitPower[i] = 0;
+        hitAccuracy[i] = 0;
+        hitRoll[i] = 0;
+        hitEffectiveness[i] = 1.0;
+
+        if (moveCount > 0) {
+            const StatusRule& rule = StatusRules::get(static_cast<StatusEffect>(self.status[k]));
+            if (rule.skipTurnChance > 0 && rng.nextInt(100) < rule.skipTurnChance) {
+                selfDamage[i] = rule.selfHitDivisor > 0 ? self.maxHP[k] / rule.selfHitDivisor : 0;
+                acted[i] = rule.ticksOnLostTurn ? 1 : 0;
+            } else {
+                hitRoll[i] = rng.nextInt(100);
+                hitAccuracy[i] = moves.accuracy[move];
+                hitPower[i] = moves.power[move];
+                hitDefense[i] = moves.special[move] ? foe.specialDefense[k] : foe.defense[k];
+                hitEffectiveness[i] = moves.effectiveness[move];
+                inflictedStatus[i] = moves.status[move];
+                inflictedDuration[i] = moves.statusDuration[move];
+            }
+        }
+        rngs[k] = rng;
+    }
+
+    // Pass 2: accuracy and damage of every action at once
+    DamageKernel::computeDamage(count, hitAttack.data(), hitDefense.data(), hitPower.data(),
+                                hitAccuracy.data(), hitRoll.data(), hitEffectiveness.data(),
+                                hitDamage.data());
+
+    // Pass 3: apply damage and status moves, then end-of-turn status
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t k = acting[i];
+        const int actor = firstSide[k] ^ (secondMover ? 1 : 0);
+        Side& self = sides[actor];
+        Side& foe = sides[1 - actor];
+
+        self.hp[k] = std::max(0, self.hp[k] - selfDamage[i]);
+        foe.hp[k] = std::max(0, foe.hp[k] - hitDamage[i]);
+        const bool inflicts = hitRoll[i] < hitAccuracy[i] &&
+                              inflictedStatus[i] != static_cast<uint8_t>(StatusEffect::NONE) &&
+                              foe.status[k] == static_cast<uint8_t>(StatusEffect::NONE);
+        foe.status[k] = inflicts ? inflictedStatus[i] : foe.status[k];
+        foe.statusDuration[k] = inflicts ? inflictedDuration[i] : foe.statusDuration[k];
+
+        // End-of-turn status, as Pokemon::updateStatus() and Battle do it
+        // (skipped without a move to use, and on lost turns unless ticksOnLostTurn)
+        if (!acted[i] || self.status[k] == static_cast<uint8_t>(StatusEffect::NONE)) continue;
+        const StatusRule& rule = StatusRules::get(static_cast<StatusEffect>(self.status[k]));
+        if (rule.tickDamageDivisor > 0) {
+            const int tickDamage = self.maxHP[k] / rule.tickDamageDivisor;
+            const int lost = std::min(self.hp[k], tickDamage);
+            self.hp[k] = std::max(0, self.hp[k] - tickDamage);
+            if (rule.drainsToOpponent && lost > 0 && foe.hp[k] > 0) {
+                foe.hp[k] = std::min(foe.maxHP[k], foe.hp[k] + lost);
+            }
+        }
+        if (--self.statusDuration[k] <= 0) {
+            self.status[k] = static_cast<uint8_t>(StatusEffect::NONE);
+        }
+    }
+}
+
+bool BattleBatch::step() {
+    if (running.empty()) return false;
+
+    // Faster Pokemon of every unfinished battle
+    for (uint32_t k : running) {
+        turns[k]++;
+    }
+    acting.assign(running.begin(), running.end());
+    halfTurn(false);
+
+    // The slower Pokemon acts unless the first action knocked it out
+    acting.clear();
+    for (uint32_t k : running) {
+        if (sides[1 - firstSide[k]].hp[k] > 0) {
+            acting.push_back(k);
+        }
+    }
+    halfTurn(true);
+
+    // A battle ends as soon as either side has fainted
+    size_t kept = 0;
+    for (uint32_t k : running) {
+        if (sides[0].hp[k] > 0 && sides[1].hp[k] > 0) {
+            running[kept++] = k;
+        } else {
+            winners[k] = sides[0].hp[k] == 0 ? 1 : 0;
+        }
+    }
+    running.resize(kept);
+
+    return !running.empty();
+}
+
+void BattleBatch::run() {
+    while (step()) {
+    }
+}
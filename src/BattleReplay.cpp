@@ -0,0 +1,134 @@
+#include "BattleReplay.h"
+#include "Pokemon.h"
+#include "Move.h"
+#include <stdexcept>
+
+const uint8_t ReplayAction::kNone;
+
+ReplayPokemon ReplayPokemon::fromPokemon(const Pokemon& pokemon) {
+    ReplayPokemon snapshot;
+    snapshot.name = pokemon.getName();
+    snapshot.type = pokemon.getTypeId();
+    snapshot.maxHP = pokemon.getMaxHP();
+    snapshot.attack = pokemon.getAttack();
+    snapshot.defense = pokemon.getDefense();
+    snapshot.specialDefense = pokemon.getSpecialDefense();
+    snapshot.speed = pokemon.getSpeed();
+    for (size_t i = 0; i < pokemon.getMoveCount(); ++i) {
+        snapshot.moves.push_back(pokemon.getMove(i).getName());
+    }
+    return snapshot;
+}
+
+bool ReplayPokemon::matches(const Pokemon& pokemon) const {
+    if (name != pokemon.getName() || type != pokemon.getTypeId() || maxHP != pokemon.getMaxHP() ||
+        attack != pokemon.getAttack() || defense != pokemon.getDefense() ||
+        specialDefense != pokemon.getSpecialDefense() || speed != pokemon.getSpeed() ||
+        moves.size() != pokemon.getMoveCount()) {
+        return false;
+    }
+    for (size_t i = 0; i < moves.size(); ++i) {
+        if (moves[i] != pokemon.getMove(i).getName()) return false;
+    }
+    return true;
+}
+
+size_t BattleReplay::seekTurn(int turn) const {
+    if (turn < 1 || turn > getTurnCount()) {
+        throw std::out_of_range("Replay has no turn " + std::to_string(turn));
+    }
+    return turnStarts[turn - 1];
+}
+
+int BattleReplay::getHPAtTurn(int turn, int side) const {
+    size_t first = seekTurn(turn);
+    return first == 0 ? pokemon[side].maxHP : actions[first - 1].hp[side];
+}
+
+// Constructor: nothing recorded yet
+ReplayRecorder::ReplayRecorder(BattleEventSink* forward)
+    : forward(forward), participants{nullptr, nullptr}, hasPending(false), nextSeed(0) {
+}
+
+uint8_t ReplayRecorder::sideOf(const Pokemon* pokemon) const {
+    if (pokemon != nullptr && pokemon == participants[0]) return 0;
+    if (pokemon != nullptr && pokemon == participants[1]) return 1;
+    return ReplayAction::kNone;
+}
+
+void ReplayRecorder::finishAction() {
+    if (!hasPending) return;
+    for (int side = 0; side < 2; ++side) {
+        pending.hp[side] = static_cast<uint16_t>(participants[side]->getCurrentHP());
+        pending.status[side] = static_cast<uint8_t>(participants[side]->getStatusEffect());
+    }
+    replay.actions.push_back(pending);
+    hasPending = false;
+}
+
+// Fold events into per-action records
+void ReplayRecorder::onEvent(const BattleEvent& event) {
+    switch (event.type) {
+        case BattleEventType::BATTLE_START:
+            participants[0] = event.actor;
+            participants[1] = event.target;
+            replay = BattleReplay();
+            replay.seed = nextSeed;
+            replay.pokemon[0] = ReplayPokemon::fromPokemon(*event.actor);
+            replay.pokemon[1] = ReplayPokemon::fromPokemon(*event.target);
+            hasPending = false;
+            break;
+        case BattleEventType::TURN_START:
+            finishAction();
+            replay.turnStarts.push_back(static_cast<uint32_t>(replay.actions.size()));
+            break;
+        case BattleEventType::ACTION_START:
+            finishAction();
+            pending = ReplayAction();
+            pending.actor = sideOf(event.actor);
+            hasPending = true;
+            break;
+        case BattleEventType::NO_MOVES:
+            pending.outcome = ReplayAction::NO_MOVES;
+            break;
+        case BattleEventType::TURN_LOST:
+            pending.outcome = ReplayAction::TURN_LOST;
+            pending.damage = event.value;
+            break;
+        case BattleEventType::MISSED:
+        case BattleEventType::MOVE_USED: {
+            pending.outcome = (event.type == BattleEventType::MISSED) ? ReplayAction::MISSED : ReplayAction::USED;
+            const auto& moves = event.actor->getMoveIds();
+            for (size_t i = 0; i < moves.size() && i < ReplayAction::kNone; ++i) {
+                if (moves[i] == event.move->getId()) {
+                    pending.move = static_cast<uint8_t>(i);
+                    break;
+                }
+            }
+            break;
+        }
+        case BattleEventType::DAMAGE:
+            pending.damage = event.value;
+            break;
+        case BattleEventType::HEALED:
+            pending.damage = -event.value;
+            break;
+        case BattleEventType::EFFECTIVENESS:
+            pending.effectiveness = static_cast<uint8_t>(event.multiplier * 4.0 + 0.5);
+            break;
+        case BattleEventType::FAINTED:
+            finishAction();
+            break;
+        case BattleEventType::BATTLE_END:
+            finishAction();
+            replay.winner = sideOf(event.actor);
+            break;
+        default:
+            // State snapshots and status events are reflected in the HP/status columns
+            break;
+    }
+
+    if (forward) {
+        forward->onEvent(event);
+    }
+}
@@ -0,0 +1,96 @@
+#include "BattleSimulator.h"
+#include "Battle.h"
+#include "BattleBatch.h"
+#include "ReplayLog.h"
+#include <algorithm>
+#include <random>
+
+double SimulationResult::averageTurns() const {
+    if (battles == 0) return 0.0;
+    
+    long long totalTurns = 0;
+    for (size_t turns = 0; turns < turnHistogram.size(); ++turns) {
+        totalTurns += static_cast<long long>(turns) * turnHistogram[turns];
+    }
+    return static_cast<double>(totalTurns) / battles;
+}
+
+const int BattleSimulator::kBatchSize;
+
+// Constructor: copy both Pokemon into the arena; their states are the snapshot
+BattleSimulator::BattleSimulator(const Pokemon& p1, const Pokemon& p2)
+    : arena(2), policies{nullptr, nullptr} {
+    arena.add(p1);
+    arena.add(p2);
+}
+
+// Run N silent battles from a nondeterministic base seed
+SimulationResult BattleSimulator::run(int battles) {
+    std::random_device device;
+    return run(battles, (static_cast<uint64_t>(device()) << 32) | device());
+}
+
+// Run N silent, individually seeded battles and aggregate (and optionally record) the results
+SimulationResult BattleSimulator::run(int battles, uint64_t seed, ReplayLogWriter* log) {
+    SimulationResult result;
+    long long remainingHP[2] = {0, 0};
+    ReplayRecorder recorder;
+    
+    auto countBattle = [&](int winner, int turns, int hp1, int hp2) {
+        result.wins[winner]++;
+        if (static_cast<int>(result.turnHistogram.size()) <= turns) {
+            result.turnHistogram.resize(turns + 1, 0);
+        }
+        result.turnHistogram[turns]++;
+        remainingHP[0] += hp1;
+        remainingHP[1] += hp2;
+    };
+    
+    // Batches copy the starting state, so undo the previous run's last battle
+    arena.restore();
+    Pokemon& pokemon1 = arena.get(0);
+    Pokemon& pokemon2 = arena.get(1);
+    
+    // Built-in moves only, random move choice and nothing to record: play
+    // the battles in lockstep batches, with the same seeds and outcomes as Battle
+    const bool batched = log == nullptr && policies[0] == nullptr && policies[1] == nullptr &&
+                         BattleBatch::supports(pokemon1) && BattleBatch::supports(pokemon2);
+    BattleBatch batch;
+    for (int first = 0; batched && first < battles; first += kBatchSize) {
+        const int count = std::min(kBatchSize, battles - first);
+        batch.clear();
+        batch.reserve(count);
+        for (int i = first; i < first + count; ++i) {
+            batch.add(pokemon1, pokemon2, BattleRng::deriveSeed(seed, i));
+        }
+        batch.run();
+        for (int b = 0; b < count; ++b) {
+            countBattle(batch.getWinner(b), batch.getTurnCount(b), batch.getHP(b, 0), batch.getHP(b, 1));
+        }
+    }
+    
+    for (int i = 0; !batched && i < battles; ++i) {
+        // Back to the starting HP and status
+        arena.restore();
+        
+        uint64_t battleSeed = BattleRng::deriveSeed(seed, i);
+        recorder.setSeed(battleSeed);
+        Battle battle(pokemon1, pokemon2, battleSeed, log ? static_cast<BattleEventSink&>(recorder) : events);
+        battle.setPolicies(policies[0], policies[1]);
+        auto winner = battle.start();
+        if (log) {
+            log->append(recorder.getReplay());
+        }
+        
+        countBattle(winner.get() == &pokemon1 ? 0 : 1, battle.getTurnCount(),
+                    pokemon1.getCurrentHP(), pokemon2.getCurrentHP());
+    }
+    
+    result.battles = battles;
+    if (battles > 0) {
+        result.averageRemainingHP[0] = static_cast<double>(remainingHP[0]) / battles;
+        result.averageRemainingHP[1] = static_cast<double>(remainingHP[1]) / battles;
+    }
+    
+    return result;
+}
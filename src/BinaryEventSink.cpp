@@ -0,0 +1,45 @@
+#include "BinaryEventSink.h"
+#include "Pokemon.h"
+
+const uint8_t BinaryEventRecord::kNone;
+
+// Constructor: no battle registered yet
+BinaryEventSink::BinaryEventSink() : participants{nullptr, nullptr} {
+}
+
+uint8_t BinaryEventSink::sideOf(const Pokemon* pokemon) const {
+    if (pokemon == nullptr) return BinaryEventRecord::kNone;
+    if (pokemon == participants[0]) return 0;
+    if (pokemon == participants[1]) return 1;
+    return BinaryEventRecord::kNone;
+}
+
+// Encode one event
+void BinaryEventSink::onEvent(const BattleEvent& event) {
+    if (event.type == BattleEventType::BATTLE_START) {
+        participants[0] = event.actor;
+        participants[1] = event.target;
+    }
+    
+    BinaryEventRecord record{};
+    record.type = static_cast<uint8_t>(event.type);
+    record.actor = sideOf(event.actor);
+    record.target = sideOf(event.target);
+    record.move = BinaryEventRecord::kNone;
+    record.status = static_cast<uint8_t>(event.status);
+    record.value = event.value;
+    record.multiplier = static_cast<float>(event.multiplier);
+    
+    // Moves are identified by their slot in the actor's moveset
+    if (event.move != nullptr && event.actor != nullptr) {
+        const auto& moves = event.actor->getMoveIds();
+        for (size_t i = 0; i < moves.size() && i < BinaryEventRecord::kNone; ++i) {
+            if (moves[i] == event.move->getId()) {
+                record.move = static_cast<uint8_t>(i);
+                break;
+            }
+        }
+    }
+    
+    records.push_back(record);
+}
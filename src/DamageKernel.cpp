@@ -0,0 +1,198 @@
+#include "DamageKernel.h"
+#include "TypeEffectiveness.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// SIMD implementations are compiled per function with target attributes,
+// so the rest of the build keeps the default instruction set
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DAMAGE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+typedef void (*DamageFunction)(size_t, const int32_t*, const int32_t*, const int32_t*,
+                               const int32_t*, const int32_t*, const double*, int32_t*);
+typedef void (*EffectivenessFunction)(size_t, const uint8_t*, const uint8_t*, double*);
+
+const double* chartData() {
+    return &TypeEffectiveness::getChart().multipliers[0][0];
+}
+
+// Reference implementation: the arithmetic of Move's default effect
+// followed by Move::execute(), written without branches
+void computeDamageScalar(size_t count, const int32_t* attack, const int32_t* defense,
+                         const int32_t* power, const int32_t* accuracy, const int32_t* rolls,
+                         const double* effectiveness, int32_t* damage) {
+    for (size_t i = 0; i < count; ++i) {
+        int32_t base = std::max(1, (attack[i] * power[i]) / (defense[i] * 2));
+        int32_t scaled = static_cast<int32_t>(base * effectiveness[i]);
+        damage[i] = (rolls[i] < accuracy[i] && power[i] != 0) ? scaled : 0;
+    }
+}
+
+void lookupEffectivenessScalar(size_t count, const uint8_t* attackTypes, const uint8_t* defenseTypes,
+                               double* effectiveness) {
+    const double* chart = chartData();
+    for (size_t i = 0; i < count; ++i) {
+        effectiveness[i] = chart[attackTypes[i] * TypeEffectiveness::kTypeCount + defenseTypes[i]];
+    }
+}
+
+#ifdef DAMAGE_KERNEL_X86
+
+// Four hits per iteration, two doubles per register
+__attribute__((target("sse2")))
+void computeDamageSse2(size_t count, const int32_t* attack, const int32_t* defense,
+                       const int32_t* power, const int32_t* accuracy, const int32_t* rolls,
+                       const double* effectiveness, int32_t* damage) {
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d two = _mm_set1_pd(2.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(attack + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(defense + i));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(power + i));
+        __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accuracy + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rolls + i));
+
+        __m128i halves[2];
+        for (int h = 0; h < 2; ++h) {
+            __m128i ah = h ? _mm_srli_si128(a, 8) : a;
+            __m128i dh = h ? _mm_srli_si128(d, 8) : d;
+            __m128i ph = h ? _mm_srli_si128(p, 8) : p;
+            __m128d quotient = _mm_div_pd(_mm_mul_pd(_mm_cvtepi32_pd(ah), _mm_cvtepi32_pd(ph)),
+                                          _mm_mul_pd(_mm_cvtepi32_pd(dh), two));
+            // Truncate through int32 (SSE2 has no rounding instruction)
+            __m128d base = _mm_max_pd(_mm_cvtepi32_pd(_mm_cvttpd_epi32(quotient)), one);
+            halves[h] = _mm_cvttpd_epi32(_mm_mul_pd(base, _mm_loadu_pd(effectiveness + i + 2 * h)));
+        }
+        __m128i scaled = _mm_unpacklo_epi64(halves[0], halves[1]);
+        __m128i hit = _mm_andnot_si128(_mm_cmpeq_epi32(p, _mm_setzero_si128()), _mm_cmplt_epi32(r, acc));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(damage + i), _mm_and_si128(hit, scaled));
+    }
+    computeDamageScalar(count - i, attack + i, defense + i, power + i, accuracy + i, rolls + i,
+                        effectiveness + i, damage + i);
+}
+
+// Four hits per iteration, four doubles per register
+__attribute__((target("avx2")))
+void computeDamageAvx2(size_t count, const int32_t* attack, const int32_t* defense,
+                       const int32_t* power, const int32_t* accuracy, const int32_t* rolls,
+                       const double* effectiveness, int32_t* damage) {
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d two = _mm256_set1_pd(2.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(attack + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(defense + i));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(power + i));
+        __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accuracy + i));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rolls + i));
+
+        __m256d quotient = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(a), _mm256_cvtepi32_pd(p)),
+                                         _mm256_mul_pd(_mm256_cvtepi32_pd(d), two));
+        __m256d base = _mm256_max_pd(_mm256_round_pd(quotient, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC), one);
+        __m128i scaled = _mm256_cvttpd_epi32(_mm256_mul_pd(base, _mm256_loadu_pd(effectiveness + i)));
+        __m128i hit = _mm_andnot_si128(_mm_cmpeq_epi32(p, _mm_setzero_si128()), _mm_cmplt_epi32(r, acc));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(damage + i), _mm_and_si128(hit, scaled));
+    }
+    computeDamageScalar(count - i, attack + i, defense + i, power + i, accuracy + i, rolls + i,
+                        effectiveness + i, damage + i);
+}
+
+// Chart lookups with a hardware gather, four hits per iteration
+__attribute__((target("avx2")))
+void lookupEffectivenessAvx2(size_t count, const uint8_t* attackTypes, const uint8_t* defenseTypes,
+                             double* effectiveness) {
+    const double* chart = chartData();
+    const __m128i rowSize = _mm_set1_epi32(TypeEffectiveness::kTypeCount);
+    // Masked form with a zeroed source: the unmasked intrinsic leaves its
+    // source undefined, which GCC reports as maybe-uninitialized
+    const __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32_t attackBytes, defenseBytes;
+        std::memcpy(&attackBytes, attackTypes + i, sizeof(attackBytes));
+        std::memcpy(&defenseBytes, defenseTypes + i, sizeof(defenseBytes));
+        __m128i row = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(attackBytes));
+        __m128i column = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(defenseBytes));
+        __m128i index = _mm_add_epi32(_mm_mullo_epi32(row, rowSize), column);
+        _mm256_storeu_pd(effectiveness + i, _mm256_mask_i32gather_pd(_mm256_setzero_pd(), chart, index, allLanes, 8));
+    }
+    lookupEffectivenessScalar(count - i, attackTypes + i, defenseTypes + i, effectiveness + i);
+}
+
+#endif // DAMAGE_KERNEL_X86
+
+DamageKernel::Isa detectBestIsa() {
+#ifdef DAMAGE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return DamageKernel::Isa::AVX2;
+    if (__builtin_cpu_supports("sse2")) return DamageKernel::Isa::SSE2;
+#endif
+    return DamageKernel::Isa::SCALAR;
+}
+
+// Forced implementation, or -1 for the best one
+std::atomic<int> forcedIsa(-1);
+
+} // namespace
+
+bool DamageKernel::isSupported(Isa isa) {
+    return static_cast<int>(isa) <= static_cast<int>(getBestIsa());
+}
+
+DamageKernel::Isa DamageKernel::getBestIsa() {
+    static const Isa best = detectBestIsa();
+    return best;
+}
+
+DamageKernel::Isa DamageKernel::getIsa() {
+    int forced = forcedIsa.load(std::memory_order_relaxed);
+    return forced >= 0 ? static_cast<Isa>(forced) : getBestIsa();
+}
+
+void DamageKernel::setIsa(Isa isa) {
+    if (!isSupported(isa)) {
+        throw std::invalid_argument(std::string("Damage kernel not supported on this CPU: ") + isaName(isa));
+    }
+    forcedIsa.store(static_cast<int>(isa), std::memory_order_relaxed);
+}
+
+const char* DamageKernel::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR: return "Scalar";
+        case Isa::SSE2: return "SSE2";
+        case Isa::AVX2: return "AVX2";
+    }
+    return "Unknown";
+}
+
+void DamageKernel::computeDamage(size_t count, const int32_t* attack, const int32_t* defense,
+                                 const int32_t* power, const int32_t* accuracy, const int32_t* rolls,
+                                 const double* effectiveness, int32_t* damage) {
+    DamageFunction function = computeDamageScalar;
+#ifdef DAMAGE_KERNEL_X86
+    switch (getIsa()) {
+        case Isa::AVX2: function = computeDamageAvx2; break;
+        case Isa::SSE2: function = computeDamageSse2; break;
+        case Isa::SCALAR: break;
+    }
+#endif
+    function(count, attack, defense, power, accuracy, rolls, effectiveness, damage);
+}
+
+void DamageKernel::lookupEffectiveness(size_t count, const uint8_t* attackTypes, const uint8_t* defenseTypes,
+                                       double* effectiveness) {
+    // SSE2 has no gather; its lookups stay scalar
+    EffectivenessFunction function = lookupEffectivenessScalar;
+#ifdef DAMAGE_KERNEL_X86
+    if (getIsa() == Isa::AVX2) function = lookupEffectivenessAvx2;
+#endif
+    function(count, attackTypes, defenseTypes, effectiveness);
+}
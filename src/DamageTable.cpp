@@ -0,0 +1,174 @@
+#include "DamageTable.h"
+#include "BattleRng.h"
+#include "Move.h"
+#include "MoveRegistry.h"
+#include "Pokemon.h"
+#include "PythonSkillLoader.h"
+#include "SkillBatch.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+// Profile stats are packed in 12 bits each
+const int kStatBits = 12;
+const int kStatLimit = 1 << kStatBits;
+}
+
+bool DamageTable::pack(const Pokemon& pokemon, uint64_t& key) {
+    const int stats[5] = {
+        pokemon.getMaxHP(), pokemon.getAttack(), pokemon.getDefense(),
+        pokemon.getSpecialDefense(), pokemon.getSpeed()
+    };
+    key = 0;
+    for (int stat : stats) {
+        if (stat < 0 || stat >= kStatLimit) return false;
+        key = (key << kStatBits) | static_cast<uint64_t>(stat);
+    }
+    return true;
+}
+
+bool DamageTable::find(const Pokemon& attacker, const Pokemon& defender, size_t& first, size_t& last) const {
+    uint64_t attackerKey, defenderKey;
+    if (!pack(attacker, attackerKey) || !pack(defender, defenderKey)) return false;
+    auto a = profiles.find(attackerKey);
+    if (a == profiles.end()) return false;
+    auto d = profiles.find(defenderKey);
+    if (d == profiles.end()) return false;
+
+    size_t pair = a->second * profileCount + d->second;
+    first = offsets[pair];
+    last = offsets[pair + 1];
+    return true;
+}
+
+DamageTable DamageTable::build(const Move& move, const std::vector<Pokemon>& roster, int samples, uint64_t seed) {
+    if ((move.getEffect() != MoveEffect::SCRIPT && move.getEffect() != MoveEffect::TABLE) ||
+        !PythonSkillLoader::isPrecompilable(move.getScriptSkill())) {
+        throw std::invalid_argument("Move " + move.getName() + " has no script skill with PRECOMPILE = True");
+    }
+    if (samples <= 0) {
+        throw std::invalid_argument("DamageTable needs a positive sample count");
+    }
+    ScriptSkillId skill = move.getScriptSkill();
+
+    // One representative per distinct profile
+    DamageTable table;
+    std::vector<const Pokemon*> representatives;
+    for (const Pokemon& pokemon : roster) {
+        uint64_t key;
+        if (!pack(pokemon, key) || table.profiles.count(key) > 0) continue;
+        table.profiles[key] = static_cast<uint32_t>(representatives.size());
+        representatives.push_back(&pokemon);
+    }
+    table.profileCount = representatives.size();
+
+    PythonSkillLoader::ScopedOutputMute mute;
+    DamageDistribution outcomes;
+    SkillBatch batch;
+    for (size_t a = 0; a < table.profileCount; ++a) {
+        for (size_t d = 0; d < table.profileCount; ++d) {
+            Pokemon attacker(*representatives[a]);
+            Pokemon defender(*representatives[d]);
+
+            // Declared distribution, else frequencies of one batch of live calls
+            if (!PythonSkillLoader::damageDistribution(skill, attacker, defender, outcomes)) {
+                batch.clear();
+                batch.reserve(samples);
+                for (int i = 0; i < samples; ++i) {
+                    batch.add(attacker, defender);
+                }
+                BattleRng rng(BattleRng::deriveSeed(seed, a * table.profileCount + d));
+                PythonSkillLoader::executeSkillBatch(skill, batch, rng);
+
+                std::map<int, int> counts;
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    counts[batch.getDamage(i)]++;
+                }
+                for (const auto& count : counts) {
+                    outcomes.push_back(std::make_pair(count.first, static_cast<double>(count.second) / samples));
+                }
+                table.sampledPairs++;
+            }
+
+            // Merge repeated values, drop impossible ones, renormalize
+            std::map<int, double> merged;
+            double total = 0.0;
+            for (const auto& outcome : outcomes) {
+                if (outcome.second <= 0.0) continue;
+                merged[outcome.first] += outcome.second;
+                total += outcome.second;
+            }
+            if (merged.empty()) {
+                throw std::invalid_argument("Move " + move.getName() + " declares an empty damage distribution");
+            }
+
+            table.offsets.push_back(static_cast<uint32_t>(table.damage.size()));
+            double cumulative = 0.0;
+            for (const auto& outcome : merged) {
+                double probability = outcome.second / total;
+                cumulative += probability;
+                double threshold = std::min(cumulative * 4294967296.0, 4294967295.0);
+                table.damage.push_back(outcome.first);
+                table.probabilities.push_back(probability);
+                table.thresholds.push_back(static_cast<uint32_t>(threshold));
+            }
+        }
+    }
+    table.offsets.push_back(static_cast<uint32_t>(table.damage.size()));
+    return table;
+}
+
+size_t DamageTable::precompile(const std::vector<Pokemon>& roster, int samples, uint64_t seed) {
+    std::set<MoveId> used;
+    for (const Pokemon& pokemon : roster) {
+        used.insert(pokemon.getMoveIds().begin(), pokemon.getMoveIds().end());
+    }
+
+    size_t tabulated = 0;
+    for (MoveId id : used) {
+        const Move& move = MoveRegistry::get(id);
+        if (move.getEffect() != MoveEffect::SCRIPT && move.getEffect() != MoveEffect::TABLE) continue;
+        if (!PythonSkillLoader::isPrecompilable(move.getScriptSkill())) continue;
+
+        std::shared_ptr<const DamageTable> table =
+            std::make_shared<DamageTable>(build(move, roster, samples, BattleRng::deriveSeed(seed, id)));
+        MoveRegistry::setDamageTable(id, table);
+        tabulated++;
+    }
+    return tabulated;
+}
+
+bool DamageTable::draw(const Pokemon& attacker, const Pokemon& defender, BattleRng& rng, int& result) const {
+    size_t first, last;
+    if (!find(attacker, defender, first, last)) return false;
+
+    if (last - first == 1) {
+        result = damage[first];
+        return true;
+    }
+    uint32_t bits = static_cast<uint32_t>(rng() >> 32);
+    size_t index = std::upper_bound(thresholds.begin() + first, thresholds.begin() + (last - 1), bits) - thresholds.begin();
+    result = damage[index];
+    return true;
+}
+
+bool DamageTable::distribution(const Pokemon& attacker, const Pokemon& defender, DamageDistribution& outcomes) const {
+    size_t first, last;
+    if (!find(attacker, defender, first, last)) return false;
+
+    outcomes.clear();
+    for (size_t i = first; i < last; ++i) {
+        outcomes.push_back(std::make_pair(static_cast<int>(damage[i]), probabilities[i]));
+    }
+    return true;
+}
+
+size_t DamageTable::memoryBytes() const {
+    return profiles.size() * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(void*)) +
+           offsets.capacity() * sizeof(uint32_t) + damage.capacity() * sizeof(int32_t) +
+           thresholds.capacity() * sizeof(uint32_t) + probabilities.capacity() * sizeof(double);
+}
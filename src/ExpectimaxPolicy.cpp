@@ -0,0 +1,143 @@
+#include "ExpectimaxPolicy.h"
+#include "Battle.h"
+#include "PythonSkillLoader.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace {
+
+// Everything about a Pokemon that its search values depend on, except its state
+uint64_t fingerprint(const Pokemon& pokemon) {
+    uint64_t hash = BattleRng::deriveSeed(std::hash<std::string>()(pokemon.getName()), pokemon.getMaxHP());
+    const int stats[] = {pokemon.getAttack(), pokemon.getDefense(), pokemon.getSpecialDefense(), pokemon.getSpeed(),
+                         static_cast<int>(pokemon.getTypeId())};
+    for (int stat : stats) {
+        hash = BattleRng::deriveSeed(hash, static_cast<uint64_t>(stat));
+    }
+    for (MoveId move : pokemon.getMoveIds()) {
+        hash = BattleRng::deriveSeed(hash, move);
+    }
+    return hash;
+}
+
+double hpFraction(const Pokemon& pokemon) {
+    return static_cast<double>(pokemon.getCurrentHP()) / pokemon.getMaxHP();
+}
+
+} // namespace
+
+ExpectimaxPolicy::ExpectimaxPolicy(int maxDepth, int samples, double timeBudget, size_t tableSize)
+    : maxDepth(std::max(1, maxDepth)), samples(std::max(1, samples)), timeBudget(timeBudget), table(tableSize),
+      matchup(0), self(0), timed(false), aborted(false), nodes(0), lastDepth(0) {
+    sides.reserve(2);
+}
+
+void ExpectimaxPolicy::clear() {
+    table.clear();
+    sides.clear();
+}
+
+double ExpectimaxPolicy::expectedValue(int actor, int move, int depth, uint64_t key) {
+    const PokemonState saved[2] = {sides[0].getState(), sides[1].getState()};
+    Pokemon& attacker = sides[actor];
+    Pokemon& defender = sides[1 - actor];
+
+    double total = 0.0;
+    for (int sample = 0; sample < samples && !aborted; ++sample) {
+        // Same state, move and sample: same outcome, so cached values stay consistent
+        Battle action(sides[0], sides[1], BattleRng::deriveSeed(key, static_cast<uint64_t>(move * samples + sample)),
+                      events);
+        action.executeTurn(attacker, defender, move);
+        total += value(1 - actor, depth - 1);
+        sides[0].setState(saved[0]);
+        sides[1].setState(saved[1]);
+    }
+    return total / samples;
+}
+
+double ExpectimaxPolicy::value(int actor, int depth) {
+    const Pokemon& mine = sides[self];
+    const Pokemon& theirs = sides[1 - self];
+    if (theirs.isFainted()) return mine.isFainted() ? 0.0 : 1.0;
+    if (mine.isFainted()) return -1.0;
+    if (depth == 0) return hpFraction(mine) - hpFraction(theirs);
+
+    uint64_t key = TranspositionTable::key(sides[0].getState(), sides[1].getState(), actor);
+    double cached;
+    if (table.find(key, depth, cached)) {
+        return cached;
+    }
+
+    // Check the clock every 256 expanded states
+    if (++nodes % 256 == 0 && timed && Clock::now() > deadline) {
+        aborted = true;
+        return 0.0;
+    }
+
+    // Ours: best move; the opponent's: uniformly random
+    int moves = std::max(1, static_cast<int>(sides[actor].getMoveCount()));
+    double best = -std::numeric_limits<double>::infinity();
+    double total = 0.0;
+    for (int move = 0; move < moves; ++move) {
+        double expected = expectedValue(actor, move, depth, key);
+        if (aborted) return 0.0;
+        best = std::max(best, expected);
+        total += expected;
+    }
+
+    double result = (actor == self) ? best : total / moves;
+    table.store(key, depth, result);
+    return result;
+}
+
+int ExpectimaxPolicy::chooseMove(const Pokemon& me, const Pokemon& opponent, bool movesFirst, BattleRng&) {
+    lastDepth = 0;
+    nodes = 0;
+    int moves = static_cast<int>(me.getMoveCount());
+    if (moves <= 1) {
+        return 0;
+    }
+
+    // Copy the Pokemon for a new matchup (the cached values are for the old
+    // one); otherwise only their states change
+    const Pokemon& first = movesFirst ? me : opponent;
+    const Pokemon& second = movesFirst ? opponent : me;
+    uint64_t current = BattleRng::deriveSeed(BattleRng::deriveSeed(fingerprint(first), fingerprint(second)),
+                                             movesFirst ? 0 : 1);
+    if (sides.empty() || current != matchup) {
+        table.clear();
+        sides.clear();
+        sides.push_back(first);
+        sides.push_back(second);
+        matchup = current;
+        self = movesFirst ? 0 : 1;
+    } else {
+        sides[0].setState(first.getState());
+        sides[1].setState(second.getState());
+    }
+
+    PythonSkillLoader::ScopedOutputMute mute;
+    deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeBudget));
+    uint64_t key = TranspositionTable::key(sides[0].getState(), sides[1].getState(), self);
+
+    // Iterative deepening; depth 1 always completes, so there is a choice
+    int best = 0;
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        timed = timeBudget > 0.0 && depth > 1;
+        aborted = false;
+        int choice = 0;
+        double bestValue = -std::numeric_limits<double>::infinity();
+        for (int move = 0; move < moves && !aborted; ++move) {
+            double expected = expectedValue(self, move, depth, key);
+            if (expected > bestValue) {
+                bestValue = expected;
+                choice = move;
+            }
+        }
+        if (aborted) break;
+        best = choice;
+        lastDepth = depth;
+    }
+    return best;
+}
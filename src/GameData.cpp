@@ -0,0 +1,440 @@
+#include "GameData.h"
+#include "MoveRegistry.h"
+#include "PythonSkillLoader.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[4] = {'P', 'K', 'D', 'B'};
+const uint32_t kVersion = 1;
+
+// Cache layout: header, species[], moves[], learnset (u16 move indices),
+// string table (NUL-terminated, offset 0 is "")
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;        // hash() of species.csv, chained into moves.csv
+    uint32_t speciesCount;
+    uint32_t moveCount;
+    uint32_t learnsetCount;
+    uint32_t stringBytes;
+};
+
+struct SpeciesRecord {
+    uint32_t name;              // String table offset
+    uint32_t firstMove;         // First learnset entry
+    uint16_t moveCount;         // Learnset entries
+    uint8_t type;               // PokemonType
+    uint8_t reserved;
+    int32_t stats[5];           // HP, attack, defense, special defense, speed
+};
+
+struct MoveRecord {
+    uint32_t name;              // String table offset
+    uint32_t script;            // String table offset ("" = built-in formula)
+    int32_t power;
+    int32_t accuracy;
+    int32_t statusDuration;
+    uint8_t type;               // PokemonType
+    uint8_t category;           // MoveCategory
+    uint8_t status;             // StatusEffect
+    uint8_t reserved;
+};
+
+const CacheHeader& header(const unsigned char* data) {
+    return *reinterpret_cast<const CacheHeader*>(data);
+}
+
+const SpeciesRecord* speciesRecords(const unsigned char* data) {
+    return reinterpret_cast<const SpeciesRecord*>(data + sizeof(CacheHeader));
+}
+
+const MoveRecord* moveRecords(const unsigned char* data) {
+    return reinterpret_cast<const MoveRecord*>(speciesRecords(data) + header(data).speciesCount);
+}
+
+const uint16_t* learnset(const unsigned char* data) {
+    return reinterpret_cast<const uint16_t*>(moveRecords(data) + header(data).moveCount);
+}
+
+const char* stringTable(const unsigned char* data) {
+    return reinterpret_cast<const char*>(learnset(data) + header(data).learnsetCount);
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open data file: " + path);
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t end = text.find(separator, start);
+        fields.push_back(trim(text.substr(start, end == std::string::npos ? std::string::npos : end - start)));
+        if (end == std::string::npos) break;
+        start = end + 1;
+    }
+    return fields;
+}
+
+/**
+ * Data rows of a CSV file: header row, blank lines and comments skipped
+ */
+class CsvReader {
+private:
+    std::istringstream lines;
+    std::string path;
+    int lineNumber;
+    size_t columns;
+    bool headerSkipped;
+
+public:
+    CsvReader(const std::string& text, const std::string& path, size_t columns)
+        : lines(text), path(path), lineNumber(0), columns(columns), headerSkipped(false) {}
+
+    bool next(std::vector<std::string>& fields) {
+        std::string line;
+        while (std::getline(lines, line)) {
+            ++lineNumber;
+            std::string content = trim(line);
+            if (content.empty() || content[0] == '#') continue;
+            if (!headerSkipped) {
+                headerSkipped = true;
+                continue;
+            }
+            fields = split(content, ',');
+            if (fields.size() != columns) {
+                fail("expected " + std::to_string(columns) + " fields, found " + std::to_string(fields.size()));
+            }
+            return true;
+        }
+        return false;
+    }
+
+    int integer(const std::string& field) const {
+        size_t used = 0;
+        int value = 0;
+        try {
+            value = std::stoi(field, &used);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (used == 0 || used != field.size()) {
+            fail("not an integer: '" + field + "'");
+        }
+        return value;
+    }
+
+    void fail(const std::string& message) const {
+        throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + message);
+    }
+};
+
+MoveCategory parseCategory(const std::string& name) {
+    if (name == "Physical") return MoveCategory::PHYSICAL;
+    if (name == "Special") return MoveCategory::SPECIAL;
+    if (name == "Status") return MoveCategory::STATUS;
+    throw std::invalid_argument("Unknown move category: " + name);
+}
+
+template <typename Record>
+void putRecords(std::string& out, const std::vector<Record>& records) {
+    out.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+}
+
+} // namespace
+
+uint64_t GameData::hash(const std::string& bytes, uint64_t seed) {
+    uint64_t value = seed;
+    for (unsigned char byte : bytes) {
+        value = (value ^ byte) * 1099511628211ULL;
+    }
+    return value;
+}
+
+// Load: hash the sources, then use the cache if it matches, else rebuild it
+GameData::GameData(const std::string& speciesPath, const std::string& movesPath, const std::string& cachePath)
+    : data(nullptr), size(0), mapping(nullptr), cacheHit(false) {
+    std::string speciesText = readFile(speciesPath);
+    std::string movesText = readFile(movesPath);
+    uint64_t sourceHash = hash(movesText, hash(speciesText));
+
+    cacheHit = !cachePath.empty() && mapCache(cachePath, sourceHash);
+    if (!cacheHit) {
+        built = compile(speciesPath, speciesText, movesPath, movesText, sourceHash);
+        data = reinterpret_cast<const unsigned char*>(built.data());
+        size = built.size();
+
+        // Write through a temporary file so readers never map a partial cache;
+        // without a writable location the data is simply rebuilt next time
+        if (!cachePath.empty()) {
+            std::string temporary = cachePath + ".tmp";
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(built.data(), static_cast<std::streamsize>(built.size()));
+            out.close();
+            if (!out || std::rename(temporary.c_str(), cachePath.c_str()) != 0) {
+                std::remove(temporary.c_str());
+            }
+        }
+    }
+
+    moveIds.assign(getMoveCount(), MoveRegistry::kUnregistered);
+}
+
+GameData::~GameData() {
+    if (mapping != nullptr) {
+        munmap(mapping, size);
+    }
+}
+
+bool GameData::mapCache(const std::string& cachePath, uint64_t sourceHash) {
+    int fd = open(cachePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(info.st_size);
+    if (!isValid(static_cast<const unsigned char*>(mapped), length, sourceHash)) {
+        munmap(mapped, length);
+        return false;
+    }
+    mapping = mapped;
+    data = static_cast<const unsigned char*>(mapped);
+    size = length;
+    return true;
+}
+
+bool GameData::isValid(const unsigned char* bytes, size_t length, uint64_t sourceHash) {
+    if (length < sizeof(CacheHeader)) return false;
+    const CacheHeader& head = header(bytes);
+    if (std::memcmp(head.magic, kMagic, 4) != 0 || head.version != kVersion || head.sourceHash != sourceHash) {
+        return false;
+    }
+    uint64_t expected = sizeof(CacheHeader) + static_cast<uint64_t>(head.speciesCount) * sizeof(SpeciesRecord) +
+                        static_cast<uint64_t>(head.moveCount) * sizeof(MoveRecord) +
+                        static_cast<uint64_t>(head.learnsetCount) * sizeof(uint16_t) + head.stringBytes;
+    if (expected != length || head.stringBytes == 0 || stringTable(bytes)[head.stringBytes - 1] != '\0') {
+        return false;
+    }
+
+    // Every reference must stay inside the image
+    for (uint32_t i = 0; i < head.speciesCount; ++i) {
+        const SpeciesRecord& species = speciesRecords(bytes)[i];
+        if (species.name >= head.stringBytes || species.type >= static_cast<uint8_t>(PokemonType::COUNT) ||
+            static_cast<uint64_t>(species.firstMove) + species.moveCount > head.learnsetCount) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < head.moveCount; ++i) {
+        const MoveRecord& move = moveRecords(bytes)[i];
+        if (move.name >= head.stringBytes || move.script >= head.stringBytes ||
+            move.type >= static_cast<uint8_t>(PokemonType::COUNT) ||
+            move.category > static_cast<uint8_t>(MoveCategory::STATUS) ||
+            move.status >= static_cast<uint8_t>(StatusEffect::COUNT)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < head.learnsetCount; ++i) {
+        if (learnset(bytes)[i] >= head.moveCount) return false;
+    }
+    return true;
+}
+
+std::string GameData::compile(const std::string& speciesPath, const std::string& speciesText,
+                              const std::string& movesPath, const std::string& movesText, uint64_t sourceHash) {
+    std::string strings(1, '\0');
+    auto addString = [&strings](const std::string& text) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings += text;
+        strings.push_back('\0');
+        return offset;
+    };
+
+    // Moves first, so learnsets can refer to them by index
+    std::vector<MoveRecord> moves;
+    std::map<std::string, uint16_t> moveIndex;
+    CsvReader moveRows(movesText, movesPath, 8);
+    std::vector<std::string> fields;
+    while (moveRows.next(fields)) {
+        if (moveIndex.count(fields[0]) || fields[0].empty()) {
+            moveRows.fail("duplicate or empty move name '" + fields[0] + "'");
+        }
+        if (moves.size() >= MoveRegistry::kUnregistered) {
+            moveRows.fail("too many moves");
+        }
+        MoveRecord move = {};
+        move.name = addString(fields[0]);
+        // Unknown type, category or status names: report them at this line
+        try {
+            move.type = static_cast<uint8_t>(TypeEffectiveness::parseType(fields[1]));
+            move.category = static_cast<uint8_t>(parseCategory(fields[2]));
+            move.status = static_cast<uint8_t>(StatusRules::parse(fields[6]));
+        } catch (const std::invalid_argument& e) {
+            moveRows.fail(e.what());
+        }
+        move.power = moveRows.integer(fields[3]);
+        move.accuracy = moveRows.integer(fields[4]);
+        move.script = addString(fields[5]);
+        move.statusDuration = fields[7].empty() ? 0 : moveRows.integer(fields[7]);
+        moveIndex[fields[0]] = static_cast<uint16_t>(moves.size());
+        moves.push_back(move);
+    }
+
+    std::vector<SpeciesRecord> species;
+    std::vector<uint16_t> learnsets;
+    std::map<std::string, bool> speciesNames;
+    CsvReader speciesRows(speciesText, speciesPath, 8);
+    while (speciesRows.next(fields)) {
+        if (speciesNames.count(fields[0]) || fields[0].empty()) {
+            speciesRows.fail("duplicate or empty species name '" + fields[0] + "'");
+        }
+        speciesNames[fields[0]] = true;
+        SpeciesRecord record = {};
+        record.name = addString(fields[0]);
+        try {
+            record.type = static_cast<uint8_t>(TypeEffectiveness::parseType(fields[1]));
+        } catch (const std::invalid_argument& e) {
+            speciesRows.fail(e.what());
+        }
+        for (int stat = 0; stat < 5; ++stat) {
+            record.stats[stat] = speciesRows.integer(fields[2 + stat]);
+            if (record.stats[stat] <= 0) {
+                speciesRows.fail("stats must be positive");
+            }
+        }
+        record.firstMove = static_cast<uint32_t>(learnsets.size());
+        if (!fields[7].empty()) {
+            for (const auto& name : split(fields[7], ';')) {
+                auto move = moveIndex.find(name);
+                if (move == moveIndex.end()) {
+                    speciesRows.fail("unknown move '" + name + "'");
+                }
+                learnsets.push_back(move->second);
+            }
+        }
+        record.moveCount = static_cast<uint16_t>(learnsets.size() - record.firstMove);
+        species.push_back(record);
+    }
+
+    CacheHeader head = {};
+    std::memcpy(head.magic, kMagic, 4);
+    head.version = kVersion;
+    head.sourceHash = sourceHash;
+    head.speciesCount = static_cast<uint32_t>(species.size());
+    head.moveCount = static_cast<uint32_t>(moves.size());
+    head.learnsetCount = static_cast<uint32_t>(learnsets.size());
+    head.stringBytes = static_cast<uint32_t>(strings.size());
+
+    std::string image(reinterpret_cast<const char*>(&head), sizeof(head));
+    putRecords(image, species);
+    putRecords(image, moves);
+    putRecords(image, learnsets);
+    image += strings;
+    return image;
+}
+
+const char* GameData::stringAt(uint32_t offset) const {
+    return stringTable(data) + offset;
+}
+
+size_t GameData::getSpeciesCount() const {
+    return header(data).speciesCount;
+}
+
+size_t GameData::getMoveCount() const {
+    return header(data).moveCount;
+}
+
+const char* GameData::getSpeciesName(size_t index) const {
+    return stringAt(speciesRecords(data)[index].name);
+}
+
+const char* GameData::getMoveName(size_t index) const {
+    return stringAt(moveRecords(data)[index].name);
+}
+
+int GameData::findSpecies(const std::string& name) const {
+    for (size_t i = 0; i < getSpeciesCount(); ++i) {
+        if (name == getSpeciesName(i)) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int GameData::findMove(const std::string& name) const {
+    for (size_t i = 0; i < getMoveCount(); ++i) {
+        if (name == getMoveName(i)) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+Move GameData::createMove(size_t index) const {
+    const MoveRecord& record = moveRecords(data)[index];
+    std::string script = stringAt(record.script);
+    Move move(stringAt(record.name), script, record.power, record.accuracy,
+              TypeEffectiveness::typeName(static_cast<PokemonType>(record.type)),
+              static_cast<MoveCategory>(record.category),
+              StatusRules::name(static_cast<StatusEffect>(record.status)), record.statusDuration);
+    if (!script.empty()) {
+        // Without Python, a script with no native skill leaves
+        // the move on the built-in formula
+        NativeSkillSpec spec;
+        if (PythonSkillLoader::isPythonEnabled()) {
+            PythonSkillLoader::deferSkill(move, script);
+        } else if (PythonSkillLoader::findNativeSkill(script, spec)) {
+            move.setNativeEffect(spec);
+        }
+    }
+    return move;
+}
+
+MoveId GameData::getMoveId(size_t index) {
+    if (moveIds[index] == MoveRegistry::kUnregistered) {
+        moveIds[index] = MoveRegistry::add(createMove(index));
+    }
+    return moveIds[index];
+}
+
+Pokemon GameData::createPokemon(const std::string& species) {
+    int index = findSpecies(species);
+    if (index < 0) {
+        throw std::invalid_argument("Unknown species: " + species);
+    }
+    const SpeciesRecord& record = speciesRecords(data)[index];
+    Pokemon pokemon(stringAt(record.name), TypeEffectiveness::typeName(static_cast<PokemonType>(record.type)),
+                    record.stats[0], record.stats[1], record.stats[2], record.stats[3], record.stats[4]);
+    for (uint16_t i = 0; i < record.moveCount; ++i) {
+        pokemon.addMove(getMoveId(learnset(data)[record.firstMove + i]));
+    }
+    return pokemon;
+}
@@ -0,0 +1,203 @@
+#include "Instrumentation.h"
+#include "MoveRegistry.h"
+#include "PythonSkillLoader.h"
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Report names of the probes, in Probe order
+const char* const kProbeNames[static_cast<int>(Probe::COUNT)] = {
+    "action", "accuracy_roll", "effect", "effectiveness", "status_tick", "python_call", "skill_setup"
+};
+
+// Effect kind of a move; a deferred script reports what it resolved to
+const char* effectName(const Move& move) {
+    switch (move.getEffect()) {
+        case MoveEffect::DEFAULT: return "default";
+        case MoveEffect::NATIVE: return "native";
+        case MoveEffect::SCRIPT: return PythonSkillLoader::isNativeSkill(move.getScriptSkill()) ? "native" : "script";
+        case MoveEffect::FUNCTION: return "function";
+        case MoveEffect::TABLE: return "table";
+    }
+    return "";
+}
+
+// Live thread blocks, the merged counters of finished threads, and the
+// timer reference for converting ticks
+struct Registry {
+    std::mutex mutex;
+    std::vector<Instrumentation::Block*> live;
+    Instrumentation::Counters retired;
+    uint64_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+
+    Registry() : startTicks(Instrumentation::now()), startTime(std::chrono::steady_clock::now()) {}
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+void addCounters(std::vector<Instrumentation::Counter>& into, const std::vector<Instrumentation::Counter>& from) {
+    if (into.size() < from.size()) {
+        into.resize(from.size());
+    }
+    for (size_t i = 0; i < from.size(); ++i) {
+        into[i].calls += from[i].calls;
+        into[i].ticks += from[i].ticks;
+    }
+}
+
+double meanNs(const Instrumentation::Counter& counter, double nsPerTick) {
+    return counter.calls > 0 ? counter.ticks * nsPerTick / counter.calls : 0.0;
+}
+
+} // namespace
+
+void Instrumentation::Counters::add(const Counters& other) {
+    for (int i = 0; i < static_cast<int>(Probe::COUNT); ++i) {
+        probes[i].calls += other.probes[i].calls;
+        probes[i].ticks += other.probes[i].ticks;
+    }
+    addCounters(moveEffects, other.moveEffects);
+    addCounters(movePython, other.movePython);
+}
+
+Instrumentation::Block::Block() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.live.push_back(this);
+}
+
+Instrumentation::Block::~Block() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.retired.add(*this);
+    shared.live.erase(std::remove(shared.live.begin(), shared.live.end(), this), shared.live.end());
+}
+
+Instrumentation::Counters Instrumentation::total() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    Counters sum = shared.retired;
+    for (const Block* block : shared.live) {
+        sum.add(*block);
+    }
+    return sum;
+}
+
+double Instrumentation::nanosecondsPerTick() {
+#ifdef INSTRUMENTATION_RDTSC
+    // TSC rate measured over the run so far (at least 10 ms of it)
+    Registry& shared = registry();
+    auto minimum = shared.startTime + std::chrono::milliseconds(10);
+    if (std::chrono::steady_clock::now() < minimum) {
+        std::this_thread::sleep_until(minimum);
+    }
+    uint64_t ticks = now() - shared.startTicks;
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - shared.startTime).count();
+    return ticks > 0 ? ns / ticks : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+void Instrumentation::reset() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.retired = Counters();
+    for (Block* block : shared.live) {
+        static_cast<Counters&>(*block) = Counters();
+    }
+}
+
+void Instrumentation::report(std::ostream& out) {
+    if (!enabled()) {
+        out << "Instrumentation: not compiled in (configure with -DPOKEMON_INSTRUMENT=ON)" << std::endl;
+        return;
+    }
+    Counters sum = total();
+    double nsPerTick = nanosecondsPerTick();
+    const Counter& actions = sum.probes[static_cast<int>(Probe::ACTION)];
+
+    out << "\nInstrumentation (all threads):" << std::endl;
+    out << std::fixed << std::setprecision(1);
+    out << "  " << std::left << std::setw(16) << "Probe" << std::right << std::setw(12) << "Calls"
+        << std::setw(12) << "Total ms" << std::setw(10) << "ns/call" << std::setw(12) << "% action" << std::endl;
+    for (int i = 0; i < static_cast<int>(Probe::COUNT); ++i) {
+        const Counter& counter = sum.probes[i];
+        out << "  " << std::left << std::setw(16) << kProbeNames[i] << std::right << std::setw(12) << counter.calls
+            << std::setw(12) << counter.ticks * nsPerTick / 1e6 << std::setw(10) << meanNs(counter, nsPerTick);
+        if (i == static_cast<int>(Probe::SKILL_SETUP)) {
+            // Taken out of ACTION, so not a share of it
+            out << std::setw(12) << "-" << std::endl;
+            continue;
+        }
+        out << std::setw(11) << (actions.ticks > 0 ? 100.0 * counter.ticks / actions.ticks : 0.0) << "%" << std::endl;
+    }
+
+    out << "\n  " << std::left << std::setw(16) << "Move" << std::setw(10) << "Effect" << std::right
+        << std::setw(12) << "Uses" << std::setw(12) << "Total ms" << std::setw(10) << "ns/use"
+        << std::setw(12) << "% Python" << std::endl;
+    for (size_t id = 0; id < sum.moveEffects.size() && id < MoveRegistry::size(); ++id) {
+        const Counter& effect = sum.moveEffects[id];
+        if (effect.calls == 0) continue;
+        const Move& move = MoveRegistry::get(static_cast<MoveId>(id));
+        uint64_t pythonTicks = id < sum.movePython.size() ? sum.movePython[id].ticks : 0;
+        out << "  " << std::left << std::setw(16) << move.getName() << std::setw(10) << effectName(move)
+            << std::right << std::setw(12) << effect.calls << std::setw(12) << effect.ticks * nsPerTick / 1e6
+            << std::setw(10) << meanNs(effect, nsPerTick)
+            << std::setw(11) << (effect.ticks > 0 ? 100.0 * pythonTicks / effect.ticks : 0.0) << "%" << std::endl;
+    }
+    out.unsetf(std::ios::floatfield);
+}
+
+void Instrumentation::writeJson(std::ostream& out) {
+    if (!enabled()) {
+        out << "{\"enabled\": false}" << std::endl;
+        return;
+    }
+    Counters sum = total();
+    double nsPerTick = nanosecondsPerTick();
+
+    out << "{\n  \"enabled\": true,\n";
+#ifdef INSTRUMENTATION_RDTSC
+    out << "  \"timer\": \"rdtsc\",\n";
+#else
+    out << "  \"timer\": \"steady_clock\",\n";
+#endif
+    out << std::setprecision(10);
+    out << "  \"probes\": {";
+    for (int i = 0; i < static_cast<int>(Probe::COUNT); ++i) {
+        const Counter& counter = sum.probes[i];
+        out << (i > 0 ? "," : "") << "\n    \"" << kProbeNames[i] << "\": {\"calls\": " << counter.calls
+            << ", \"total_ns\": " << counter.ticks * nsPerTick << ", \"mean_ns\": " << meanNs(counter, nsPerTick) << "}";
+    }
+    out << "\n  },\n  \"moves\": [";
+    bool first = true;
+    for (size_t id = 0; id < sum.moveEffects.size() && id < MoveRegistry::size(); ++id) {
+        const Counter& effect = sum.moveEffects[id];
+        if (effect.calls == 0) continue;
+        const Move& move = MoveRegistry::get(static_cast<MoveId>(id));
+        Counter python = id < sum.movePython.size() ? sum.movePython[id] : Counter();
+
+        // Move names come from data files; escape what JSON requires
+        std::string name;
+        for (char c : move.getName()) {
+            if (c == '"' || c == '\\') name += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) name += c;
+        }
+        out << (first ? "" : ",") << "\n    {\"id\": " << id << ", \"name\": \"" << name << "\", \"effect\": \""
+            << effectName(move) << "\", \"calls\": " << effect.calls
+            << ", \"total_ns\": " << effect.ticks * nsPerTick << ", \"mean_ns\": " << meanNs(effect, nsPerTick)
+            << ", \"python_calls\": " << python.calls << ", \"python_ns\": " << python.ticks * nsPerTick << "}";
+        first = false;
+    }
+    out << "\n  ]\n}" << std::endl;
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
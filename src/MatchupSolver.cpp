@@ -0,0 +1,401 @@
+#include "MatchupSolver.h"
+#include "Move.h"
+#include "StatusEffect.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Bits of a packed Pokemon state: HP, status, status duration
+const int kHPBits = 16;
+const int kStatusBits = 4;
+const int kDurationBits = 11;
+const int kSideBits = kHPBits + kStatusBits + kDurationBits;
+
+// Pivots below this mean the states never lead to the end of the battle
+const double kSingularPivot = 1e-12;
+
+uint64_t packSide(const PokemonState& state) {
+    // The duration of a cleared status is never read, and an active status
+    // with no turns left clears at the next tick whatever the count
+    uint64_t duration = state.statusEffect == StatusEffect::NONE ? 0 : std::max(0, state.statusDuration);
+    return static_cast<uint64_t>(state.currentHP) |
+           (static_cast<uint64_t>(state.statusEffect) << kHPBits) |
+           (duration << (kHPBits + kStatusBits));
+}
+
+PokemonState unpackSide(uint64_t bits) {
+    PokemonState state;
+    state.currentHP = static_cast<int>(bits & ((1u << kHPBits) - 1));
+    state.statusEffect = static_cast<StatusEffect>((bits >> kHPBits) & ((1u << kStatusBits) - 1));
+    state.statusDuration = static_cast<int>((bits >> (kHPBits + kStatusBits)) & ((1u << kDurationBits) - 1));
+    return state;
+}
+
+// Check that a Pokemon's states fit in a packed key
+void checkPackable(const Pokemon& pokemon) {
+    if (pokemon.getMaxHP() >= (1 << kHPBits)) {
+        throw std::invalid_argument("MatchupSolver: " + pokemon.getName() + " has too much HP");
+    }
+    int longest = pokemon.getState().statusDuration;
+    for (size_t move = 0; move < pokemon.getMoveCount(); ++move) {
+        longest = std::max(longest, pokemon.getMove(move).getStatusDuration());
+    }
+    if (longest >= (1 << kDurationBits)) {
+        throw std::invalid_argument("MatchupSolver: status duration too long in " + pokemon.getName() + "'s moves");
+    }
+}
+
+} // namespace
+
+MatchupSolver::MatchupSolver(const Pokemon& p1, const Pokemon& p2, size_t maxCycleStates)
+    : firstSide(p1.getSpeed() >= p2.getSpeed() ? 0 : 1), maxCycleStates(maxCycleStates), largestCycle(0) {
+    // Same order as Battle::determineFirstAttacker()
+    checkPackable(p1);
+    checkPackable(p2);
+    sides.reserve(2);
+    sides.push_back(firstSide == 0 ? p1 : p2);
+    sides.push_back(firstSide == 0 ? p2 : p1);
+    initial[0] = sides[0].getState();
+    initial[1] = sides[1].getState();
+}
+
+uint64_t MatchupSolver::pack(const PokemonState& first, const PokemonState& second, int actor) {
+    return packSide(first) | (packSide(second) << kSideBits) | (static_cast<uint64_t>(actor) << (2 * kSideBits));
+}
+
+void MatchupSolver::unpack(uint64_t key, PokemonState& first, PokemonState& second, int& actor) {
+    const uint64_t sideMask = (static_cast<uint64_t>(1) << kSideBits) - 1;
+    first = unpackSide(key & sideMask);
+    second = unpackSide((key >> kSideBits) & sideMask);
+    actor = static_cast<int>(key >> (2 * kSideBits));
+}
+
+uint32_t MatchupSolver::intern(uint64_t key) {
+    auto found = ids.find(key);
+    if (found != ids.end()) {
+        return found->second;
+    }
+    uint32_t id = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.back().key = key;
+    ids.emplace(key, id);
+    return id;
+}
+
+const DamageDistribution& MatchupSolver::distribution(int actor, int move) {
+    const Pokemon& attacker = sides[actor];
+    const Pokemon& defender = sides[1 - actor];
+    uint64_t key = (static_cast<uint64_t>(actor) << 63) | (static_cast<uint64_t>(move) << 40) |
+                   (static_cast<uint64_t>(attacker.getCurrentHP()) << 20) |
+                   static_cast<uint64_t>(defender.getCurrentHP());
+    auto found = distributions.find(key);
+    if (found != distributions.end()) {
+        return found->second;
+    }
+
+    const Move& used = attacker.getMove(move);
+    DamageDistribution outcomes;
+    if (!used.damageDistribution(attacker, defender, outcomes)) {
+        throw std::invalid_argument("MatchupSolver: " + used.getName() + " does not declare its damage distribution");
+    }
+    double total = 0.0;
+    for (const auto& outcome : outcomes) {
+        total += outcome.second;
+    }
+    if (std::fabs(total - 1.0) > 1e-9) {
+        throw std::invalid_argument("MatchupSolver: damage probabilities of " + used.getName() + " do not sum to 1");
+    }
+    return distributions.emplace(key, outcomes).first->second;
+}
+
+void MatchupSolver::addOutcome(uint32_t node, int actor, double probability) {
+    if (probability <= 0.0) return;
+
+    // Battle::start() ends the battle when the second Pokemon faints after
+    // the first one's action, and when either has fainted after the second's
+    const Pokemon& first = sides[0];
+    const Pokemon& second = sides[1];
+    bool ended = second.isFainted() || (actor == 1 && first.isFainted());
+    if (ended) {
+        // The winner is side 0 unless it fainted (sides[firstSide] is side 0)
+        if (!sides[firstSide].isFainted()) {
+            nodes[node].winConstant += probability;
+        }
+        return;
+    }
+
+    uint32_t target = intern(pack(first.getState(), second.getState(), 1 - actor));
+    nodes[node].transitions.push_back(Transition{target, probability});
+}
+
+void MatchupSolver::addStatusTick(uint32_t node, int actor, double probability) {
+    // End of Battle::executeTurn()
+    Pokemon& attacker = sides[actor];
+    Pokemon& defender = sides[1 - actor];
+    StatusTick tick = attacker.updateStatus();
+    if (tick.drained > 0 && !defender.isFainted()) {
+        defender.heal(tick.drained);
+    }
+    addOutcome(node, actor, probability);
+}
+
+void MatchupSolver::addAction(uint32_t node, int actor) {
+    const PokemonState start[2] = {sides[0].getState(), sides[1].getState()};
+    auto restore = [&]() {
+        sides[0].setState(start[0]);
+        sides[1].setState(start[1]);
+    };
+    Pokemon& attacker = sides[actor];
+    Pokemon& defender = sides[1 - actor];
+
+    // Nothing happens, not even the status tick
+    int moves = static_cast<int>(attacker.getMoveCount());
+    if (moves == 0) {
+        addOutcome(node, actor, 1.0);
+        restore();
+        return;
+    }
+
+    // Lost turn (the move choice does not matter)
+    const StatusRule& rule = StatusRules::get(attacker.getStatusEffect());
+    double skip = rule.skipTurnChance > 0 ? std::min(rule.skipTurnChance, 100) / 100.0 : 0.0;
+    if (skip > 0.0) {
+        if (rule.selfHitDivisor > 0) {
+            attacker.takeDamage(attacker.getMaxHP() / rule.selfHitDivisor);
+        }
+        if (rule.ticksOnLostTurn) {
+            addStatusTick(node, actor, skip);
+        } else {
+            addOutcome(node, actor, skip);
+        }
+        restore();
+    }
+    if (skip >= 1.0) return;
+
+    // Each move, as Move::execute() plays it
+    for (int move = 0; move < moves; ++move) {
+        const Move& used = attacker.getMove(move);
+        double chosen = (1.0 - skip) / moves;
+        double hit = std::min(std::max(used.getAccuracy(), 0), 100) / 100.0;
+        if (hit < 1.0) {
+            addStatusTick(node, actor, chosen * (1.0 - hit));
+            restore();
+        }
+        if (hit <= 0.0) continue;
+
+        const DamageDistribution& outcomes = distribution(actor, move);
+        for (const auto& outcome : outcomes) {
+            int damage = outcome.first;
+            if (damage > 0) {
+                double effectiveness = TypeEffectiveness::getEffectiveness(used.getTypeId(), defender.getTypeId());
+                defender.takeDamage(static_cast<int>(damage * effectiveness));
+            } else if (damage < 0) {
+                attacker.heal(-damage);
+            }
+            if (used.getStatusEffect() != StatusEffect::NONE && used.getCategory() == MoveCategory::STATUS) {
+                defender.applyStatusEffect(used.getStatusEffect(), used.getStatusDuration());
+            }
+            addStatusTick(node, actor, chosen * hit * outcome.second);
+            restore();
+        }
+    }
+}
+
+void MatchupSolver::expand(uint32_t node) {
+    PokemonState first;
+    PokemonState second;
+    int actor;
+    unpack(nodes[node].key, first, second, actor);
+    sides[0].setState(first);
+    sides[1].setState(second);
+    addAction(node, actor);
+
+    // Merge transitions to the same state
+    std::vector<Transition>& transitions = nodes[node].transitions;
+    std::sort(transitions.begin(), transitions.end(),
+              [](const Transition& a, const Transition& b) { return a.target < b.target; });
+    size_t merged = 0;
+    for (size_t i = 0; i < transitions.size(); ++i) {
+        if (merged > 0 && transitions[merged - 1].target == transitions[i].target) {
+            transitions[merged - 1].probability += transitions[i].probability;
+        } else {
+            transitions[merged++] = transitions[i];
+        }
+    }
+    transitions.resize(merged);
+}
+
+void MatchupSolver::solveComponent(const std::vector<uint32_t>& component) {
+    // A turn starts at each state where the first Pokemon acts
+    auto turnReward = [](const Node& node) {
+        return (node.key >> (2 * kSideBits)) == 0 ? 1.0 : 0.0;
+    };
+
+    // A single state that does not lead back to itself: all successors are solved
+    if (component.size() == 1) {
+        Node& node = nodes[component[0]];
+        bool selfLoop = false;
+        double win = node.winConstant;
+        double turns = turnReward(node);
+        for (const Transition& transition : node.transitions) {
+            if (transition.target == component[0]) {
+                selfLoop = true;
+                break;
+            }
+            win += transition.probability * nodes[transition.target].win;
+            turns += transition.probability * nodes[transition.target].turns;
+        }
+        if (!selfLoop) {
+            node.win = win;
+            node.turns = turns;
+            std::vector<Transition>().swap(node.transitions);
+            return;
+        }
+    }
+
+    // (I - P) x = b over the component, for the win probability and the
+    // expected turns at once; P is its transitions among themselves and b
+    // what the solved states and the end of the battle contribute
+    size_t n = component.size();
+    if (n > maxCycleStates) {
+        throw std::runtime_error("MatchupSolver: " + std::to_string(n) +
+                                 " repeating states exceed the limit of " + std::to_string(maxCycleStates));
+    }
+    largestCycle = std::max(largestCycle, n);
+
+    std::unordered_map<uint32_t, size_t> local;
+    for (size_t i = 0; i < n; ++i) {
+        local[component[i]] = i;
+    }
+    std::vector<double> matrix(n * n, 0.0);
+    std::vector<double> rhs(2 * n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        const Node& node = nodes[component[i]];
+        matrix[i * n + i] = 1.0;
+        rhs[2 * i] = node.winConstant;
+        rhs[2 * i + 1] = turnReward(node);
+        for (const Transition& transition : node.transitions) {
+            auto inside = local.find(transition.target);
+            if (inside != local.end()) {
+                matrix[i * n + inside->second] -= transition.probability;
+            } else {
+                rhs[2 * i] += transition.probability * nodes[transition.target].win;
+                rhs[2 * i + 1] += transition.probability * nodes[transition.target].turns;
+            }
+        }
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (size_t column = 0; column < n; ++column) {
+        size_t pivot = column;
+        for (size_t row = column + 1; row < n; ++row) {
+            if (std::fabs(matrix[row * n + column]) > std::fabs(matrix[pivot * n + column])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(matrix[pivot * n + column]) < kSingularPivot) {
+            throw std::runtime_error("MatchupSolver: the battle can go on forever (no move ever ends it)");
+        }
+        if (pivot != column) {
+            std::swap_ranges(matrix.begin() + pivot * n, matrix.begin() + (pivot + 1) * n, matrix.begin() + column * n);
+            std::swap(rhs[2 * pivot], rhs[2 * column]);
+            std::swap(rhs[2 * pivot + 1], rhs[2 * column + 1]);
+        }
+        for (size_t row = column + 1; row < n; ++row) {
+            double factor = matrix[row * n + column] / matrix[column * n + column];
+            if (factor == 0.0) continue;
+            for (size_t k = column; k < n; ++k) {
+                matrix[row * n + k] -= factor * matrix[column * n + k];
+            }
+            rhs[2 * row] -= factor * rhs[2 * column];
+            rhs[2 * row + 1] -= factor * rhs[2 * column + 1];
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        for (size_t k = i + 1; k < n; ++k) {
+            rhs[2 * i] -= matrix[i * n + k] * rhs[2 * k];
+            rhs[2 * i + 1] -= matrix[i * n + k] * rhs[2 * k + 1];
+        }
+        rhs[2 * i] /= matrix[i * n + i];
+        rhs[2 * i + 1] /= matrix[i * n + i];
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        Node& node = nodes[component[i]];
+        node.win = rhs[2 * i];
+        node.turns = rhs[2 * i + 1];
+        std::vector<Transition>().swap(node.transitions);
+    }
+}
+
+SolverResult MatchupSolver::solve() {
+    nodes.clear();
+    ids.clear();
+    distributions.clear();
+    largestCycle = 0;
+
+    SolverResult result;
+    sides[0].setState(initial[0]);
+    sides[1].setState(initial[1]);
+    if (sides[0].isFainted() || sides[1].isFainted()) {
+        // Battle::start() plays no turn
+        result.winProbability[sides[firstSide].isFainted() ? 1 : 0] = 1.0;
+        return result;
+    }
+
+    // Iterative Tarjan: each set of mutually reachable states is solved
+    // when it completes, after every state it leads to
+    std::vector<uint32_t> stack;
+    std::vector<std::pair<uint32_t, size_t>> path;     // (node, next transition to follow)
+    int visited = 0;
+    auto visit = [&](uint32_t node) {
+        nodes[node].index = nodes[node].lowlink = visited++;
+        nodes[node].onStack = true;
+        stack.push_back(node);
+        expand(node);
+        path.emplace_back(node, 0);
+    };
+
+    uint32_t root = intern(pack(initial[0], initial[1], 0));
+    visit(root);
+    while (!path.empty()) {
+        uint32_t node = path.back().first;
+        if (path.back().second < nodes[node].transitions.size()) {
+            uint32_t target = nodes[node].transitions[path.back().second++].target;
+            if (nodes[target].index < 0) {
+                visit(target);
+            } else if (nodes[target].onStack) {
+                nodes[node].lowlink = std::min(nodes[node].lowlink, nodes[target].index);
+            }
+            continue;
+        }
+
+        path.pop_back();
+        if (!path.empty()) {
+            Node& parent = nodes[path.back().first];
+            parent.lowlink = std::min(parent.lowlink, nodes[node].lowlink);
+        }
+        if (nodes[node].lowlink == nodes[node].index) {
+            std::vector<uint32_t> component;
+            uint32_t member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                nodes[member].onStack = false;
+                component.push_back(member);
+            } while (member != node);
+            solveComponent(component);
+        }
+    }
+
+    double win = std::min(1.0, std::max(0.0, nodes[root].win));
+    result.winProbability[0] = win;
+    result.winProbability[1] = 1.0 - win;
+    result.expectedTurns = nodes[root].turns;
+    result.states = nodes.size();
+    result.largestCycle = largestCycle;
+    return result;
+}
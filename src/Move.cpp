@@ -1,85 +1,174 @@
 #include "Move.h"
 #include "Pokemon.h"
 #include "TypeEffectiveness.h"
-#include <iostream>
-#include <cstdlib>
-#include <ctime>
+#include "BattleRng.h"
+#include "BattleEvent.h"
+#include "MoveRegistry.h"
+#include "PythonSkillLoader.h"
+#include "DamageTable.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <stdexcept>
 
-// Constructor: Initialize move with properties and default effect function
+// Constructor: Initialize move with properties and the built-in damage formula
 Move::Move(const std::string& name, const std::string& scriptPath, 
            int power, int accuracy, const std::string& type, MoveCategory cat,
            const std::string& status, int duration)
     : name(name), scriptPath(scriptPath), basePower(power), accuracy(accuracy), 
-      type(type), category(cat), statusEffect(status), statusDuration(duration) {
+      type(TypeEffectiveness::parseType(type)), category(cat), statusEffect(StatusRules::parse(status)), statusDuration(duration),
+      id(MoveRegistry::kUnregistered), effect(MoveEffect::DEFAULT), scriptSkill(0) {
+}
+
+// Basic damage calculation, used unless a skill replaces it
+int Move::defaultDamage(const Pokemon& attacker, const Pokemon& defender) const {
+    // Status moves don't deal damage
+    if (basePower == 0) return 0;
     
-    // Set default effect function (basic damage calculation)
-    // This will be replaced if a Python script is loaded
-    effectFunction = [this](Pokemon& attacker, Pokemon& defender) -> int {
-        // Status moves don't deal damage
-        if (this->basePower == 0) return 0;
-        
-        // Determine which stats to use based on move category
-        // Note: Current implementation uses same 'attack' stat for both physical and special moves
-        // Only the defensive stat differs (defense for physical, special_defense for special)
-        int attackStat = attacker.getAttack();
-        int defenseStat = (this->category == MoveCategory::SPECIAL) ? defender.getSpecialDefense() : defender.getDefense();
-        
-        // Simple damage formula: (Attack * Power / Defense) / 2
-        int damage = (attackStat * this->basePower) / (defenseStat * 2);
-        damage = std::max(1, damage); // Minimum 1 damage
-        
-        // Note: Type effectiveness is applied in execute(), not here
-        
-        return damage;
-    };
+    // Determine which stats to use based on move category
+    // Note: Current implementation uses same 'attack' stat for both physical and special moves
+    // Only the defensive stat differs (defense for physical, special_defense for special)
+    int attackStat = attacker.getAttack();
+    int defenseStat = (category == MoveCategory::SPECIAL) ? defender.getSpecialDefense() : defender.getDefense();
+    
+    // Simple damage formula: (Attack * Power / Defense) / 2
+    int damage = (attackStat * basePower) / (defenseStat * 2);
+    damage = std::max(1, damage); // Minimum 1 damage
+    
+    // Note: Type effectiveness is applied in execute(), not here
+    
+    return damage;
+}
+
+// Dispatch on the effect tag
+int Move::calculateDamage(Pokemon& attacker, Pokemon& defender, BattleRng& rng) const {
+    switch (effect) {
+        case MoveEffect::DEFAULT:
+            return defaultDamage(attacker, defender);
+        case MoveEffect::NATIVE:
+            return NativeSkill::calculateDamage(nativeSkill, attacker, defender, rng);
+        case MoveEffect::SCRIPT:
+            return PythonSkillLoader::callScriptSkill(scriptSkill, attacker, defender, rng);
+        case MoveEffect::FUNCTION:
+            return effectFunction(attacker, defender, rng);
+        case MoveEffect::TABLE: {
+            // Only while output is discarded: a table draw prints nothing
+            int damage;
+            if (!PythonSkillLoader::isScriptOutputEnabled() && damageTable->draw(attacker, defender, rng, damage)) {
+                return damage;
+            }
+            return PythonSkillLoader::callScriptSkill(scriptSkill, attacker, defender, rng);
+        }
+    }
+    return 0;
+}
+
+// Distribution of calculateDamage(), by the same dispatch
+bool Move::damageDistribution(const Pokemon& attacker, const Pokemon& defender, DamageDistribution& outcomes) const {
+    switch (effect) {
+        case MoveEffect::DEFAULT:
+            outcomes.assign(1, std::make_pair(defaultDamage(attacker, defender), 1.0));
+            return true;
+        case MoveEffect::NATIVE:
+            outcomes = NativeSkill::damageDistribution(nativeSkill, attacker, defender);
+            return true;
+        case MoveEffect::SCRIPT:
+            return PythonSkillLoader::damageDistribution(scriptSkill, attacker, defender, outcomes);
+        case MoveEffect::FUNCTION:
+            break;
+        case MoveEffect::TABLE:
+            if (damageTable->distribution(attacker, defender, outcomes)) {
+                return true;
+            }
+            return PythonSkillLoader::damageDistribution(scriptSkill, attacker, defender, outcomes);
+    }
+    outcomes.clear();
+    return false;
 }
 
 // Execute the move in battle
-int Move::execute(Pokemon& attacker, Pokemon& defender) {
+int Move::execute(Pokemon& attacker, Pokemon& defender, BattleRng& rng, BattleEventSink& events) const {
     // Step 1: Check if move hits based on accuracy
-    int roll = rand() % 100;
+    int roll;
+    {
+        POKEMON_PROBE(ACCURACY_ROLL);
+        roll = rng.nextInt(100);
+    }
     if (roll >= accuracy) {
-        std::cout << attacker.getName() << "'s " << name << " missed!" << std::endl;
+        events.onEvent(BattleEvent(BattleEventType::MISSED, &attacker, &defender, this));
         return 0;
     }
     
-    std::cout << attacker.getName() << " used " << name << "!" << std::endl;
+    events.onEvent(BattleEvent(BattleEventType::MOVE_USED, &attacker, &defender, this));
     
-    // Step 2: Calculate damage using effect function (Python or default)
-    int damage = effectFunction(attacker, defender);
+    // Step 2: Calculate damage using the move's effect (Python, native or default)
+    int damage;
+    {
+        POKEMON_PROBE_MOVE(EFFECT, id != MoveRegistry::kUnregistered ? static_cast<int>(id) : -1);
+        damage = calculateDamage(attacker, defender, rng);
+    }
     
     if (damage > 0) {
         // Step 3: Apply type effectiveness multiplier for damaging moves
-        double effectiveness = TypeEffectiveness::getEffectiveness(type, defender.getType());
+        double effectiveness;
+        {
+            POKEMON_PROBE(EFFECTIVENESS);
+            effectiveness = TypeEffectiveness::getEffectiveness(type, defender.getTypeId());
+        }
         damage = static_cast<int>(damage * effectiveness);
         
         // Step 4: Deal damage to defender
         defender.takeDamage(damage);
-        std::cout << "It dealt " << damage << " damage!" << std::endl;
+        events.onEvent(BattleEvent(BattleEventType::DAMAGE, &attacker, &defender, this, damage));
         
-        // Step 5: Display effectiveness message
-        if (effectiveness > 1.0) {
-            std::cout << "It's super effective!" << std::endl;
-        } else if (effectiveness < 1.0 && effectiveness > 0.0) {
-            std::cout << "It's not very effective..." << std::endl;
-        } else if (effectiveness == 0.0) {
-            std::cout << "It doesn't affect " << defender.getName() << "..." << std::endl;
+        // Step 5: Report super/not very/no effect
+        if (effectiveness != 1.0) {
+            BattleEvent event(BattleEventType::EFFECTIVENESS, &attacker, &defender, this);
+            event.multiplier = effectiveness;
+            events.onEvent(event);
         }
     } else if (damage < 0) {
         // Negative damage = healing move
         attacker.heal(-damage);
-        std::cout << attacker.getName() << " restored " << (-damage) << " HP!" << std::endl;
+        events.onEvent(BattleEvent(BattleEventType::HEALED, &attacker, &defender, this, -damage));
     }
     
     // Step 6: Apply status effect if this is a status move
-    if (!statusEffect.empty() && category == MoveCategory::STATUS) {
-        defender.applyStatusEffect(statusEffect, statusDuration);
+    if (statusEffect != StatusEffect::NONE && category == MoveCategory::STATUS) {
+        if (defender.applyStatusEffect(statusEffect, statusDuration)) {
+            BattleEvent event(BattleEventType::STATUS_APPLIED, &defender, &attacker, this);
+            event.status = statusEffect;
+            events.onEvent(event);
+        }
     }
     
     return damage;
 }
 
-// Set custom effect function (typically loaded from Python)
-void Move::setEffectFunction(std::function<int(Pokemon&, Pokemon&)> func) {
+void Move::setNativeEffect(const NativeSkillSpec& spec) {
+    effect = MoveEffect::NATIVE;
+    nativeSkill = spec;
+    effectFunction = nullptr;
+    damageTable.reset();
+}
+
+void Move::setScriptEffect(ScriptSkillId skill) {
+    effect = MoveEffect::SCRIPT;
+    scriptSkill = skill;
+    effectFunction = nullptr;
+    damageTable.reset();
+}
+
+void Move::setTableEffect(std::shared_ptr<const DamageTable> table) {
+    if (effect != MoveEffect::SCRIPT && effect != MoveEffect::TABLE) {
+        throw std::logic_error("Move " + name + " has no script skill to tabulate");
+    }
+    effect = MoveEffect::TABLE;
+    damageTable = std::move(table);
+}
+
+// Set custom effect function
+void Move::setEffectFunction(std::function<int(Pokemon&, Pokemon&, BattleRng&)> func) {
+    effect = MoveEffect::FUNCTION;
     effectFunction = func;
+    damageTable.reset();
 }
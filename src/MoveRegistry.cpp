@@ -0,0 +1,24 @@
+#include "MoveRegistry.h"
+#include <stdexcept>
+#include <utility>
+
+std::vector<Move> MoveRegistry::moves;
+std::mutex MoveRegistry::mutex;
+const MoveId MoveRegistry::kUnregistered;
+
+MoveId MoveRegistry::add(const Move& move) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (moves.size() >= kUnregistered) {
+        throw std::runtime_error("Move registry is full");
+    }
+
+    MoveId id = static_cast<MoveId>(moves.size());
+    moves.push_back(move);
+    moves.back().id = id;
+    return id;
+}
+
+void MoveRegistry::setDamageTable(MoveId id, std::shared_ptr<const DamageTable> table) {
+    std::lock_guard<std::mutex> lock(mutex);
+    moves.at(id).setTableEffect(std::move(table));
+}
@@ -0,0 +1,443 @@
+#include "NativeSkill.h"
+#include "Pokemon.h"
+#include "BattleRng.h"
+#include "SkillBatch.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+// random.randint(low, high) -> low + _randbelow(n) with n = high - low + 1:
+// draw bit_length(n) bits (the top bits of one generator output, as the
+// script random source does) until the value is below n
+int NativeSkill::randint(BattleRng& rng, int low, int high) {
+    const uint64_t n = static_cast<uint64_t>(high - low) + 1;
+    int bits = 0;
+    while ((n >> bits) != 0) ++bits;
+    
+    uint64_t r = rng() >> (64 - bits);
+    while (r >= n) {
+        r = rng() >> (64 - bits);
+    }
+    return low + static_cast<int>(r);
+}
+
+namespace {
+
+// Stats a native skill reads, from a live Pokemon or a SkillBatch column
+struct SkillStats {
+    int currentHP;
+    int maxHP;
+    int attack;
+    int defense;
+    int specialDefense;
+    int speed;
+};
+
+SkillStats statsOf(const Pokemon& pokemon) {
+    return {pokemon.getCurrentHP(), pokemon.getMaxHP(), pokemon.getAttack(),
+            pokemon.getDefense(), pokemon.getSpecialDefense(), pokemon.getSpeed()};
+}
+
+SkillStats statsOf(const SkillBatch& batch, SkillBatch::Side side, size_t hit) {
+    return {batch.getStat(side, SkillBatch::CURRENT_HP, hit), batch.getStat(side, SkillBatch::MAX_HP, hit),
+            batch.getStat(side, SkillBatch::ATTACK, hit), batch.getStat(side, SkillBatch::DEFENSE, hit),
+            batch.getStat(side, SkillBatch::SPECIAL_DEFENSE, hit), batch.getStat(side, SkillBatch::SPEED, hit)};
+}
+
+// Damage before the random factor and bonus: power curve and level-based
+// formula, with the scripts' float arithmetic
+int baseDamage(const NativeSkillSpec& spec, const SkillStats& attacker, const SkillStats& defender) {
+    int power = spec.power;
+    if (spec.curve == NativeSkillSpec::PowerCurve::HP_RATIO) {
+        double hpRatio = static_cast<double>(attacker.currentHP) / attacker.maxHP;
+        power = std::max(1, static_cast<int>(spec.power * hpRatio));
+    } else if (spec.curve == NativeSkillSpec::PowerCurve::SPEED_RATIO) {
+        double speedRatio = static_cast<double>(attacker.speed) / std::max(defender.speed, 1);
+        for (const auto& step : spec.speedTable) {
+            if (speedRatio >= step.first) {
+                power = step.second;
+                break;
+            }
+        }
+    }
+    
+    // Evaluated in the same order as the scripts
+    int defenseStat = (spec.defense == NativeSkillSpec::DefenseStat::SPECIAL_DEFENSE)
+                      ? defender.specialDefense : defender.defense;
+    double base = ((2.0 * spec.level / 5 + 2) * power * attacker.attack / defenseStat) / 50 + 2;
+    return static_cast<int>(base);
+}
+
+// Random factor and bonus roll on top of baseDamage()
+int rollDamage(const NativeSkillSpec& spec, int damage, BattleRng& rng) {
+    if (spec.bonusChance > 0 && spec.bonusBeforeRandom) {
+        if (NativeSkill::randint(rng, 1, 100) <= spec.bonusChance) {
+            damage = static_cast<int>(damage * spec.bonusMultiplier);
+        }
+    }
+    
+    double randomFactor = NativeSkill::randint(rng, spec.randomMin, spec.randomMax) / 100.0;
+    damage = static_cast<int>(damage * randomFactor);
+    
+    if (spec.bonusChance > 0 && !spec.bonusBeforeRandom) {
+        if (NativeSkill::randint(rng, 1, 100) <= spec.bonusChance) {
+            damage = static_cast<int>(damage * spec.bonusMultiplier);
+        }
+    }
+    
+    return std::max(1, damage);
+}
+
+} // namespace
+
+int NativeSkill::calculateDamage(const NativeSkillSpec& spec, const Pokemon& attacker,
+                                 const Pokemon& defender, BattleRng& rng) {
+    return rollDamage(spec, baseDamage(spec, statsOf(attacker), statsOf(defender)), rng);
+}
+
+int NativeSkill::calculateDamage(const NativeSkillSpec& spec, const SkillBatch& batch, size_t hit,
+                                 BattleRng& rng) {
+    return rollDamage(spec, baseDamage(spec, statsOf(batch, SkillBatch::ATTACKER, hit),
+                                       statsOf(batch, SkillBatch::DEFENDER, hit)), rng);
+}
+
+DamageDistribution NativeSkill::damageDistribution(const NativeSkillSpec& spec, const Pokemon& attacker,
+                                                   const Pokemon& defender) {
+    // randint(1, 100) <= bonusChance and randint(randomMin, randomMax) are uniform draws
+    double bonus = spec.bonusChance > 0 ? std::min(spec.bonusChance, 100) / 100.0 : 0.0;
+    int base = baseDamage(spec, statsOf(attacker), statsOf(defender));
+    int factors = spec.randomMax - spec.randomMin + 1;
+    
+    std::map<int, double> outcomes;
+    for (int bonusRoll = 0; bonusRoll < 2; ++bonusRoll) {
+        double bonusProbability = bonusRoll ? bonus : 1.0 - bonus;
+        if (bonusProbability == 0.0) continue;
+        
+        for (int factor = spec.randomMin; factor <= spec.randomMax; ++factor) {
+            int damage = base;
+            if (bonusRoll && spec.bonusBeforeRandom) {
+                damage = static_cast<int>(damage * spec.bonusMultiplier);
+            }
+            damage = static_cast<int>(damage * (factor / 100.0));
+            if (bonusRoll && !spec.bonusBeforeRandom) {
+                damage = static_cast<int>(damage * spec.bonusMultiplier);
+            }
+            outcomes[std::max(1, damage)] += bonusProbability / factors;
+        }
+    }
+    return DamageDistribution(outcomes.begin(), outcomes.end());
+}
+
+namespace {
+
+// Python literal as written in a NATIVE_SKILL declaration
+struct Literal {
+    enum class Kind { INT, FLOAT, STRING, BOOL, SEQUENCE, DICT };
+    
+    Kind kind = Kind::INT;
+    double number = 0.0;                                // INT, FLOAT and BOOL value
+    std::string text;                                   // STRING value
+    std::vector<Literal> items;                         // SEQUENCE (tuple or list) items
+    std::vector<std::pair<std::string, Literal>> entries;  // DICT entries, in source order
+    
+    bool isInt() const { return kind == Kind::INT; }
+    bool isNumber() const { return kind == Kind::INT || kind == Kind::FLOAT; }
+    
+    // Last entry with this key (Python keeps the last duplicate), or nullptr
+    const Literal* find(const std::string& key) const {
+        const Literal* found = nullptr;
+        for (const auto& entry : entries) {
+            if (entry.first == key) found = &entry.second;
+        }
+        return found;
+    }
+    
+    // Distinct keys of a dict
+    size_t size() const {
+        size_t distinct = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (find(entries[i].first) == &entries[i].second) ++distinct;
+        }
+        return distinct;
+    }
+};
+
+// Recursive-descent reader for the literal subset NATIVE_SKILL may use
+class LiteralReader {
+private:
+    const std::string& source;
+    size_t position;
+    
+    // Skip whitespace (newlines included: the value is inside brackets) and comments
+    void skipSpace() {
+        while (position < source.size()) {
+            char c = source[position];
+            if (c == '#') {
+                while (position < source.size() && source[position] != '\n') ++position;
+            } else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                ++position;
+            } else {
+                break;
+            }
+        }
+    }
+    
+    bool accept(char expected) {
+        skipSpace();
+        if (position < source.size() && source[position] == expected) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+    
+    bool readWord(const char* word) {
+        size_t length = std::strlen(word);
+        if (source.compare(position, length, word) != 0) return false;
+        size_t end = position + length;
+        if (end < source.size() && (std::isalnum(static_cast<unsigned char>(source[end])) || source[end] == '_')) {
+            return false;
+        }
+        position = end;
+        return true;
+    }
+    
+    bool readString(std::string& out) {
+        char quote = source[position++];
+        size_t end = source.find_first_of(std::string(1, quote) + "\\\n", position);
+        if (end == std::string::npos || source[end] != quote) return false;
+        out = source.substr(position, end - position);
+        position = end + 1;
+        return true;
+    }
+    
+    bool readNumber(Literal& value) {
+        size_t start = position;
+        if (source[position] == '-' || source[position] == '+') ++position;
+        bool fraction = false;
+        while (position < source.size() &&
+               (std::isdigit(static_cast<unsigned char>(source[position])) || source[position] == '.' ||
+                source[position] == '_')) {
+            fraction = fraction || source[position] == '.';
+            ++position;
+        }
+        std::string digits;
+        for (size_t i = start; i < position; ++i) {
+            if (source[i] != '_') digits += source[i];
+        }
+        char* end = nullptr;
+        value.kind = fraction ? Literal::Kind::FLOAT : Literal::Kind::INT;
+        value.number = std::strtod(digits.c_str(), &end);
+        return !digits.empty() && end == digits.c_str() + digits.size();
+    }
+    
+    // Items up to the closing bracket; a trailing comma is allowed
+    bool readItems(char close, Literal& value) {
+        value.kind = Literal::Kind::SEQUENCE;
+        while (!accept(close)) {
+            Literal item;
+            if (!readValue(item)) return false;
+            value.items.push_back(item);
+            if (!accept(',')) return accept(close);
+        }
+        return true;
+    }
+    
+    bool readDict(Literal& value) {
+        value.kind = Literal::Kind::DICT;
+        while (!accept('}')) {
+            Literal key;
+            if (!readValue(key) || key.kind != Literal::Kind::STRING) return false;
+            if (!accept(':')) return false;
+            Literal item;
+            if (!readValue(item)) return false;
+            value.entries.push_back(std::make_pair(key.text, item));
+            if (!accept(',')) return accept('}');
+        }
+        return true;
+    }
+    
+public:
+    LiteralReader(const std::string& source, size_t position) : source(source), position(position) {}
+    
+    bool readValue(Literal& value) {
+        skipSpace();
+        if (position >= source.size()) return false;
+        char c = source[position];
+        if (c == '{') {
+            ++position;
+            return readDict(value);
+        }
+        if (c == '(' || c == '[') {
+            ++position;
+            return readItems(c == '(' ? ')' : ']', value);
+        }
+        if (c == '"' || c == '\'') {
+            value.kind = Literal::Kind::STRING;
+            return readString(value.text);
+        }
+        value.kind = Literal::Kind::BOOL;
+        if (readWord("True")) {
+            value.number = 1.0;
+            return true;
+        }
+        if (readWord("False")) {
+            value.number = 0.0;
+            return true;
+        }
+        return readNumber(value);
+    }
+};
+
+// Value of the last top-level "NATIVE_SKILL = ..." assignment
+enum class Declaration { ABSENT, INVALID, FOUND };
+
+Declaration readDeclaration(const std::string& source, Literal& value) {
+    const std::string name = "NATIVE_SKILL";
+    size_t found = std::string::npos;
+    size_t line = 0;
+    while (line < source.size()) {
+        if (source.compare(line, name.size(), name) == 0) {
+            size_t next = source.find_first_not_of(" \t", line + name.size());
+            if (next != std::string::npos && source[next] == '=' && source.compare(next, 2, "==") != 0) {
+                found = next + 1;
+            }
+        }
+        size_t end = source.find('\n', line);
+        if (end == std::string::npos) break;
+        line = end + 1;
+    }
+    if (found == std::string::npos) {
+        return Declaration::ABSENT;
+    }
+    LiteralReader reader(source, found);
+    return reader.readValue(value) ? Declaration::FOUND : Declaration::INVALID;
+}
+
+bool literalInt(const Literal* value, int& out) {
+    if (value == nullptr || !value->isInt()) return false;
+    out = static_cast<int>(value->number);
+    return true;
+}
+
+bool literalNumber(const Literal* value, double& out) {
+    if (value == nullptr || !value->isNumber()) return false;
+    out = value->number;
+    return true;
+}
+
+bool literalPair(const Literal& value, const Literal*& first, const Literal*& second) {
+    if (value.kind != Literal::Kind::SEQUENCE || value.items.size() != 2) return false;
+    first = &value.items[0];
+    second = &value.items[1];
+    return true;
+}
+
+} // namespace
+
+bool NativeSkill::parseDeclaration(const std::string& source, NativeSkillSpec& spec, std::string& error) {
+    error.clear();
+    Literal dict;
+    Declaration declaration = readDeclaration(source, dict);
+    if (declaration == Declaration::ABSENT) {
+        return false;
+    }
+    if (declaration == Declaration::INVALID) {
+        error = "NATIVE_SKILL must be a literal of numbers, strings, tuples, lists and dicts";
+        return false;
+    }
+    if (dict.kind != Literal::Kind::DICT) {
+        error = "NATIVE_SKILL must be a dict";
+        return false;
+    }
+    
+    spec = NativeSkillSpec();
+    bool hasPower = false;
+    for (const auto& entry : dict.entries) {
+        const std::string& field = entry.first;
+        const Literal& value = entry.second;
+        
+        if (field == "power") {
+            hasPower = true;
+            spec.speedTable.clear();
+            if (literalInt(&value, spec.power)) {
+                spec.curve = NativeSkillSpec::PowerCurve::FIXED;
+            } else if (value.kind == Literal::Kind::DICT && value.find("hp_ratio") != nullptr) {
+                // {"hp_ratio": maximum power}
+                spec.curve = NativeSkillSpec::PowerCurve::HP_RATIO;
+                if (value.size() != 1 || !literalInt(value.find("hp_ratio"), spec.power)) {
+                    error = "power {'hp_ratio': N} needs an integer N";
+                    return false;
+                }
+            } else if (value.kind == Literal::Kind::DICT && value.find("speed_ratio") != nullptr) {
+                // {"speed_ratio": [(minimum ratio, power), ...], "default": power}
+                spec.curve = NativeSkillSpec::PowerCurve::SPEED_RATIO;
+                const Literal* table = value.find("speed_ratio");
+                if (value.size() != 2 || !literalInt(value.find("default"), spec.power) ||
+                    table->kind != Literal::Kind::SEQUENCE) {
+                    error = "power {'speed_ratio': [(ratio, power), ...], 'default': N} is malformed";
+                    return false;
+                }
+                for (const auto& item : table->items) {
+                    const Literal* ratio;
+                    const Literal* power;
+                    std::pair<double, int> step;
+                    if (!literalPair(item, ratio, power) || !literalNumber(ratio, step.first) ||
+                        !literalInt(power, step.second)) {
+                        error = "speed_ratio entries must be (ratio, power) pairs";
+                        return false;
+                    }
+                    spec.speedTable.push_back(step);
+                }
+            } else {
+                error = "power must be an integer, {'hp_ratio': N} or {'speed_ratio': [...], 'default': N}";
+                return false;
+            }
+        } else if (field == "defense") {
+            bool isString = value.kind == Literal::Kind::STRING;
+            if (isString && value.text == "defense") {
+                spec.defense = NativeSkillSpec::DefenseStat::DEFENSE;
+            } else if (isString && value.text == "special_defense") {
+                spec.defense = NativeSkillSpec::DefenseStat::SPECIAL_DEFENSE;
+            } else {
+                error = "defense must be 'defense' or 'special_defense'";
+                return false;
+            }
+        } else if (field == "level") {
+            if (!literalInt(&value, spec.level)) {
+                error = "level must be an integer";
+                return false;
+            }
+        } else if (field == "random") {
+            const Literal* low;
+            const Literal* high;
+            if (!literalPair(value, low, high) || !literalInt(low, spec.randomMin) ||
+                !literalInt(high, spec.randomMax) || spec.randomMin > spec.randomMax) {
+                error = "random must be a (low, high) pair of percentages";
+                return false;
+            }
+        } else if (field == "bonus") {
+            bool isDict = value.kind == Literal::Kind::DICT;
+            const Literal* beforeRandom = isDict ? value.find("before_random") : nullptr;
+            size_t expected = 2 + (beforeRandom != nullptr ? 1 : 0);
+            if (!isDict || value.size() != expected || !literalInt(value.find("chance"), spec.bonusChance) ||
+                !literalNumber(value.find("multiplier"), spec.bonusMultiplier) ||
+                (beforeRandom != nullptr && beforeRandom->kind != Literal::Kind::BOOL)) {
+                error = "bonus must be {'chance': N, 'multiplier': X[, 'before_random': bool]}";
+                return false;
+            }
+            spec.bonusBeforeRandom = beforeRandom != nullptr && beforeRandom->number != 0.0;
+        } else {
+            error = "unknown key '" + field + "'";
+            return false;
+        }
+    }
+    
+    if (!hasPower) {
+        error = "power is required";
+        return false;
+    }
+    return true;
+}
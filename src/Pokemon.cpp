@@ -5,75 +5,85 @@
 
 // Constructor: Initialize Pokemon with stats
 Pokemon::Pokemon(const std::string& name, const std::string& type, int hp, int atk, int def, int spDef, int spd)
-    : name(name), type(type), maxHP(hp), currentHP(hp), attack(atk), defense(def), 
-      specialDefense(spDef), speed(spd), statusEffect(""), statusDuration(0) {
+    : name(name), type(TypeEffectiveness::parseType(type)), maxHP(hp), attack(atk), defense(def), 
+      specialDefense(spDef), speed(spd) {
+    state.currentHP = hp;
+    state.statusEffect = StatusEffect::NONE;
+    state.statusDuration = 0;
 }
 
 // Reduce HP by damage amount, minimum 0
 void Pokemon::takeDamage(int damage) {
-    currentHP = std::max(0, currentHP - damage);
+    state.currentHP = std::max(0, state.currentHP - damage);
 }
 
 // Restore HP by amount, maximum maxHP
 void Pokemon::heal(int amount) {
-    currentHP = std::min(maxHP, currentHP + amount);
+    state.currentHP = std::min(maxHP, state.currentHP + amount);
 }
 
-// Add a move to this Pokemon's moveset
-void Pokemon::addMove(std::shared_ptr<Move> move) {
+// Add a registered move to this Pokemon's moveset
+void Pokemon::addMove(MoveId move) {
     moves.push_back(move);
 }
 
+// Register a move and add it to this Pokemon's moveset
+MoveId Pokemon::addMove(const Move& move) {
+    MoveId id = MoveRegistry::add(move);
+    moves.push_back(id);
+    return id;
+}
+
 // Apply a status effect if Pokemon doesn't already have one
-void Pokemon::applyStatusEffect(const std::string& effect, int duration) {
-    if (statusEffect.empty()) {
-        statusEffect = effect;
-        statusDuration = duration;
-        std::cout << name << " is now " << effect << "!" << std::endl;
+bool Pokemon::applyStatusEffect(StatusEffect effect, int duration) {
+    if (state.statusEffect != StatusEffect::NONE || effect == StatusEffect::NONE) {
+        return false;
     }
+    state.statusEffect = effect;
+    state.statusDuration = duration;
+    return true;
 }
 
 // Update status effect: apply damage and decrement duration
-void Pokemon::updateStatus() {
-    if (statusEffect.empty()) return;
+StatusTick Pokemon::updateStatus() {
+    StatusTick tick;
+    if (state.statusEffect == StatusEffect::NONE) return tick;
     
-    // Apply status effect damage/effects
-    if (statusEffect == "Poisoned") {
-        // Poison deals 1/8 max HP per turn
-        int poisonDamage = maxHP / 8;
-        takeDamage(poisonDamage);
-        std::cout << name << " is hurt by poison! (-" << poisonDamage << " HP)" << std::endl;
-    } else if (statusEffect == "Burned") {
-        // Burn deals 1/16 max HP per turn
-        int burnDamage = maxHP / 16;
-        takeDamage(burnDamage);
-        std::cout << name << " is hurt by burn! (-" << burnDamage << " HP)" << std::endl;
-    } else if (statusEffect == "Paralyzed") {
-        // Paralysis message (50% chance to be unable to move is handled in Battle class)
-        std::cout << name << " is paralyzed!" << std::endl;
+    // Apply end-of-turn damage from the status rule
+    const StatusRule& rule = StatusRules::get(state.statusEffect);
+    tick.status = state.statusEffect;
+    if (rule.tickDamageDivisor > 0) {
+        tick.damage = maxHP / rule.tickDamageDivisor;
+        int lost = std::min(state.currentHP, tick.damage);
+        takeDamage(tick.damage);
+        if (rule.drainsToOpponent) {
+            tick.drained = lost;
+        }
     }
     
     // Decrement duration and clear if expired
-    statusDuration--;
-    if (statusDuration <= 0) {
-        std::cout << name << " recovered from " << statusEffect << "!" << std::endl;
-        statusEffect = "";
+    state.statusDuration--;
+    if (state.statusDuration <= 0) {
+        tick.recovered = true;
+        state.statusEffect = StatusEffect::NONE;
     }
+    
+    return tick;
 }
 
 // Display Pokemon's current battle status
-void Pokemon::displayStatus() const {
-    std::cout << name << " (" << type << " type) - HP: " << currentHP << "/" << maxHP;
-    if (!statusEffect.empty()) {
-        std::cout << " [" << statusEffect << "]";
+void Pokemon::displayStatus(std::ostream& out) const {
+    out << name << " (" << TypeEffectiveness::typeName(type) << " type) - HP: " << state.currentHP << "/" << maxHP;
+    if (state.statusEffect != StatusEffect::NONE) {
+        out << " [" << StatusRules::name(state.statusEffect) << "]";
     }
-    std::cout << std::endl;
-    std::cout << "Stats - ATK: " << attack << ", DEF: " << defense 
+    out << std::endl;
+    out << "Stats - ATK: " << attack << ", DEF: " << defense 
               << ", SP.DEF: " << specialDefense << ", SPD: " << speed << std::endl;
-    std::cout << "Moves: ";
+    out << "Moves: ";
     for (size_t i = 0; i < moves.size(); ++i) {
-        std::cout << moves[i]->getName();
-        if (i < moves.size() - 1) std::cout << ", ";
+        out << getMove(i).getName();
+        if (i < moves.size() - 1) out << ", ";
     }
-    std::cout << std::endl;
+    out << std::endl;
 }
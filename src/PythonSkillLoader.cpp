@@ -1,53 +1,226 @@
 #include "PythonSkillLoader.h"
 #include "Pokemon.h"
+#include "BattleRng.h"
+#include "Instrumentation.h"
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 
-bool PythonSkillLoader::pythonInitialized = false;
+std::atomic<bool> PythonSkillLoader::pythonInitialized(false);
+bool PythonSkillLoader::initializeOnFirstUse = false;
+bool PythonSkillLoader::pythonEnabled = true;
+std::mutex PythonSkillLoader::initializeMutex;
+double PythonSkillLoader::initializationTime = 0.0;
+std::map<std::string, std::shared_ptr<PythonSkillLoader::SkillHandle>> PythonSkillLoader::skillCache;
+PyThreadState* PythonSkillLoader::mainThreadState = nullptr;
+std::vector<std::unique_ptr<SkillArgumentPool>> PythonSkillLoader::argumentPools;
+unsigned PythonSkillLoader::poolGeneration = 0;
+std::deque<PythonSkillLoader::ScriptSkill> PythonSkillLoader::scriptSkills;
+std::mutex PythonSkillLoader::scriptSkillsMutex;
+std::map<std::string, NativeSkillSpec> PythonSkillLoader::nativeSkills;
+std::mutex PythonSkillLoader::nativeSkillsMutex;
+bool PythonSkillLoader::nativeSkillsEnabled = true;
+bool PythonSkillLoader::scriptOutputEnabled = true;
+size_t PythonSkillLoader::skillMemoCapacity = 4096;
+thread_local PythonSkillLoader::InterpreterContext* PythonSkillLoader::threadContext = nullptr;
+std::mutex PythonSkillLoader::contextMutex;
+
+namespace {
+
+// BattleRng of the skill call running on this thread (nullptr outside calls)
+thread_local BattleRng* activeScriptRng = nullptr;
+
+/**
+ * Makes a BattleRng the random source of Python scripts on this thread
+ * for the lifetime of the scope
+ */
+class ScriptRngScope {
+private:
+    BattleRng* previous;
+public:
+    explicit ScriptRngScope(BattleRng& rng) : previous(activeScriptRng) { activeScriptRng = &rng; }
+    ~ScriptRngScope() { activeScriptRng = previous; }
+};
+
+// Random source for scripts: the active battle's generator, or a
+// per-thread fallback for calls made outside a battle
+BattleRng& scriptRng() {
+    if (activeScriptRng != nullptr) return *activeScriptRng;
+    static thread_local BattleRng fallback((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}());
+    return fallback;
+}
+
+// Python: random() -> float in [0.0, 1.0) with 53 random bits
+PyObject* scriptRandom(PyObject*, PyObject*) {
+    return PyFloat_FromDouble(static_cast<double>(scriptRng()() >> 11) * (1.0 / 9007199254740992.0));
+}
+
+// Python: getrandbits(k) -> non-negative int with k random bits
+PyObject* scriptGetRandBits(PyObject*, PyObject* arg) {
+    long k = PyLong_AsLong(arg);
+    if (k == -1 && PyErr_Occurred()) return nullptr;
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "number of bits must be non-negative");
+        return nullptr;
+    }
+    if (k == 0) return PyLong_FromLong(0);
+    if (k <= 64) return PyLong_FromUnsignedLongLong(scriptRng()() >> (64 - k));
+    
+    // Wider requests: concatenate 64-bit words, most significant first
+    PyObject* result = PyLong_FromUnsignedLongLong(scriptRng()() >> ((64 - k % 64) % 64));
+    PyObject* shift = PyLong_FromLong(64);
+    for (long remaining = k - (k % 64 == 0 ? 64 : k % 64); remaining > 0 && result != nullptr; remaining -= 64) {
+        PyObject* shifted = PyNumber_Lshift(result, shift);
+        Py_DECREF(result);
+        if (shifted == nullptr) { result = nullptr; break; }
+        PyObject* word = PyLong_FromUnsignedLongLong(scriptRng()());
+        result = PyNumber_Or(shifted, word);
+        Py_DECREF(shifted);
+        Py_DECREF(word);
+    }
+    Py_DECREF(shift);
+    return result;
+}
+
+} // namespace
 
 void PythonSkillLoader::initialize() {
+    std::lock_guard<std::mutex> lock(initializeMutex);
     if (!pythonInitialized) {
-        Py_Initialize();
-        
-        // Add current directory to Python path
-        PyRun_SimpleString("import sys");
-        PyRun_SimpleString("sys.path.append('.')");
-        PyRun_SimpleString("sys.path.append('./scripts')");
-        
-        pythonInitialized = true;
+        if (!pythonEnabled) {
+            throw std::runtime_error("Python is disabled");
+        }
+        startInterpreter();
         std::cout << "Python interpreter initialized." << std::endl;
     }
 }
 
+void PythonSkillLoader::initializeOnDemand() {
+    std::lock_guard<std::mutex> lock(initializeMutex);
+    initializeOnFirstUse = true;
+}
+
+void PythonSkillLoader::startInterpreter() {
+    POKEMON_PROBE(SKILL_SETUP);
+    auto start = std::chrono::steady_clock::now();
+    Py_Initialize();
+    prepareInterpreter();
+    
+    // Release the GIL so skills can be called from any thread
+    mainThreadState = PyEval_SaveThread();
+    
+    initializationTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    pythonInitialized = true;
+}
+
+void PythonSkillLoader::ensureInitialized() {
+    if (pythonInitialized) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(initializeMutex);
+    if (pythonInitialized) {
+        return;
+    }
+    if (!pythonEnabled) {
+        throw std::runtime_error("Python is disabled");
+    }
+    if (!initializeOnFirstUse) {
+        throw std::runtime_error("Python not initialized!");
+    }
+    startInterpreter();
+}
+
+void PythonSkillLoader::prepareInterpreter() {
+    // Add current directory to Python path
+    PyRun_SimpleString("import sys");
+    PyRun_SimpleString("sys.path.append('.')");
+    PyRun_SimpleString("sys.path.append('./scripts')");
+    
+    installScriptRandom();
+    
+    if (!scriptOutputEnabled) {
+        PyRun_SimpleString("import os, sys\nsys.stdout = open(os.devnull, 'w')");
+    }
+}
+
 void PythonSkillLoader::finalize() {
+    std::lock_guard<std::mutex> lock(initializeMutex);
+    initializeOnFirstUse = false;
     if (pythonInitialized) {
+        PyEval_RestoreThread(mainThreadState);
+        mainThreadState = nullptr;
+        
+        // Drop cached references while the interpreter is still alive.
+        // Handles are shared with registered script skills, so they are
+        // emptied in place rather than just removed from the map.
+        for (auto& entry : skillCache) {
+            Py_XDECREF(entry.second->function);
+            Py_XDECREF(entry.second->module);
+            entry.second->function = nullptr;
+            entry.second->module = nullptr;
+        }
+        skillCache.clear();
+        argumentPools.clear();
+
+        poolGeneration++;
+        
         Py_Finalize();
         pythonInitialized = false;
     }
 }
 
-int PythonSkillLoader::executeSkill(const std::string& scriptPath, const std::string& functionName,
-                                    Pokemon& attacker, Pokemon& defender) {
+void PythonSkillLoader::setScriptOutputEnabled(bool enabled) {
+    scriptOutputEnabled = enabled;
     if (!pythonInitialized) {
-        throw std::runtime_error("Python not initialized!");
+        return;     // Applied by prepareInterpreter() when Python starts
     }
     
-    // Extract module name from script path (remove .py extension)
-    std::string moduleName = scriptPath;
-    size_t dotPos = moduleName.find_last_of('.');
-    if (dotPos != std::string::npos) {
-        moduleName = moduleName.substr(0, dotPos);
+    ScopedGil gil;
+    if (enabled) {
+        PyRun_SimpleString("import sys\nsys.stdout = sys.__stdout__");
+    } else {
+        PyRun_SimpleString("import os, sys\nsys.stdout = open(os.devnull, 'w')");
+    }
+}
+
+PythonSkillLoader::ScopedOutputMute::ScopedOutputMute() : muted(scriptOutputEnabled) {
+    if (muted) setScriptOutputEnabled(false);
+}
+
+PythonSkillLoader::ScopedOutputMute::~ScopedOutputMute() {
+    if (muted) setScriptOutputEnabled(true);
+}
+
+// Extract module name from script path (remove .py extension)
+std::string PythonSkillLoader::moduleName(const std::string& scriptPath) {
+    size_t dotPos = scriptPath.find_last_of('.');
+    return (dotPos != std::string::npos) ? scriptPath.substr(0, dotPos) : scriptPath;
+}
+
+std::shared_ptr<PythonSkillLoader::SkillHandle> PythonSkillLoader::resolveSkill(
+    const std::string& scriptPath, const std::string& functionName) {
+    
+    std::string module = moduleName(scriptPath);
+    std::string key = module + ":" + functionName;
+    auto& cache = threadContext != nullptr ? threadContext->skillCache : skillCache;
+    auto cached = cache.find(key);
+    if (cached != cache.end()) {
+        return cached->second;
     }
     
     // Import the module
-    PyObject* pName = PyUnicode_DecodeFSDefault(moduleName.c_str());
+    PyObject* pName = PyUnicode_DecodeFSDefault(module.c_str());
     PyObject* pModule = PyImport_Import(pName);
     Py_DECREF(pName);
     
     if (pModule == nullptr) {
         PyErr_Print();
-        std::cerr << "Failed to load module: " << moduleName << std::endl;
-        return 0;
+        std::cerr << "Failed to load module: " << module << std::endl;
+        return nullptr;
     }
     
     // Get the function
@@ -58,29 +231,167 @@ int PythonSkillLoader::executeSkill(const std::string& scriptPath, const std::st
         std::cerr << "Cannot find function: " << functionName << std::endl;
         Py_XDECREF(pFunc);
         Py_DECREF(pModule);
-        return 0;
+        return nullptr;
+    }
+    
+    // Opt-in memoization: module-level DETERMINISTIC = True
+    PyObject* pDeterministic = PyObject_GetAttrString(pModule, "DETERMINISTIC");
+    bool deterministic = pDeterministic != nullptr && PyObject_IsTrue(pDeterministic) == 1;
+    Py_XDECREF(pDeterministic);
+    PyObject* pPrecompile = PyObject_GetAttrString(pModule, "PRECOMPILE");
+    bool precompile = pPrecompile != nullptr && PyObject_IsTrue(pPrecompile) == 1;
+    Py_XDECREF(pPrecompile);
+    PyErr_Clear();
+    
+    // Cache owns the new references until finalize() (or the end of the
+    // ThreadContext whose interpreter they belong to)
+    auto handle = std::make_shared<SkillHandle>();
+    handle->module = pModule;
+    handle->function = pFunc;
+    handle->deterministic = deterministic;
+    handle->precompile = precompile;
+    cache[key] = handle;
+    
+    return handle;
+}
+
+SkillArgumentPool& PythonSkillLoader::threadArgumentPool() {
+    struct ThreadPool {
+        SkillArgumentPool* pool = nullptr;
+        unsigned generation = 0;
+    };
+    static thread_local ThreadPool local;
+    
+    if (threadContext != nullptr) {
+        return *threadContext->argumentPool;
+    }
+    if (local.pool == nullptr || local.generation != poolGeneration) {
+        argumentPools.emplace_back(new SkillArgumentPool());
+        local.pool = argumentPools.back().get();
+        local.generation = poolGeneration;
     }
+    return *local.pool;
+}
+
+SkillResultCache& PythonSkillLoader::threadSkillMemo(ScriptSkillId skill) {
+    struct ThreadMemos {
+        std::vector<std::unique_ptr<SkillResultCache>> skills;
+        unsigned generation = 0;
+        size_t capacity = 0;
+    };
+    static thread_local ThreadMemos local;
     
-    // Create a dictionary with Pokemon stats
-    PyObject* pAttackerDict = PyDict_New();
-    PyDict_SetItemString(pAttackerDict, "name", PyUnicode_FromString(attacker.getName().c_str()));
-    PyDict_SetItemString(pAttackerDict, "current_hp", PyLong_FromLong(attacker.getCurrentHP()));
-    PyDict_SetItemString(pAttackerDict, "max_hp", PyLong_FromLong(attacker.getMaxHP()));
-    PyDict_SetItemString(pAttackerDict, "attack", PyLong_FromLong(attacker.getAttack()));
-    PyDict_SetItemString(pAttackerDict, "defense", PyLong_FromLong(attacker.getDefense()));
-    PyDict_SetItemString(pAttackerDict, "speed", PyLong_FromLong(attacker.getSpeed()));
+    // A restarted interpreter may have loaded changed scripts
+    if (local.generation != poolGeneration || local.capacity != skillMemoCapacity) {
+        local.skills.clear();
+        local.generation = poolGeneration;
+        local.capacity = skillMemoCapacity;
+    }
+    if (local.skills.size() <= skill) {
+        local.skills.resize(skill + 1);
+    }
+    if (!local.skills[skill]) {
+        local.skills[skill].reset(new SkillResultCache(skillMemoCapacity));
+    }
+    return *local.skills[skill];
+}
+
+void PythonSkillLoader::setSkillMemoCapacity(size_t entries) {
+    skillMemoCapacity = entries;
+}
+
+void PythonSkillLoader::installScriptRandom() {
+    static PyMethodDef randomMethods[] = {
+        {"random", scriptRandom, METH_NOARGS, nullptr},
+        {"getrandbits", scriptGetRandBits, METH_O, nullptr},
+        {nullptr, nullptr, 0, nullptr}
+    };
     
-    PyObject* pDefenderDict = PyDict_New();
-    PyDict_SetItemString(pDefenderDict, "name", PyUnicode_FromString(defender.getName().c_str()));
-    PyDict_SetItemString(pDefenderDict, "current_hp", PyLong_FromLong(defender.getCurrentHP()));
-    PyDict_SetItemString(pDefenderDict, "max_hp", PyLong_FromLong(defender.getMaxHP()));
-    PyDict_SetItemString(pDefenderDict, "attack", PyLong_FromLong(defender.getAttack()));
-    PyDict_SetItemString(pDefenderDict, "defense", PyLong_FromLong(defender.getDefense()));
-    PyDict_SetItemString(pDefenderDict, "speed", PyLong_FromLong(defender.getSpeed()));
+    PyObject* globals = PyDict_New();
+    PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+    for (PyMethodDef* method = randomMethods; method->ml_name != nullptr; ++method) {
+        PyObject* function = PyCFunction_New(method, nullptr);
+        PyDict_SetItemString(globals, (std::string("_battle_") + method->ml_name).c_str(), function);
+        Py_DECREF(function);
+    }
     
-    // Call the function
-    PyObject* pArgs = PyTuple_Pack(2, pAttackerDict, pDefenderDict);
-    PyObject* pValue = PyObject_CallObject(pFunc, pArgs);
+    // random.Random derives randint, choice, uniform, ... from random() and
+    // getrandbits(); the module-level functions are bound to one instance,
+    // so rebinding them to ours redirects every "random.xxx()" call
+    const char* code =
+        "import random\n"
+        "class BattleRandom(random.Random):\n"
+        "    def seed(self, *args, **kwargs):\n"
+        "        pass\n"
+        "    random = staticmethod(_battle_random)\n"
+        "    getrandbits = staticmethod(_battle_getrandbits)\n"
+        "_instance = BattleRandom()\n"
+        "for _name in ('random', 'uniform', 'triangular', 'randint', 'choice', 'randrange',\n"
+        "              'sample', 'shuffle', 'choices', 'normalvariate', 'lognormvariate',\n"
+        "              'expovariate', 'vonmisesvariate', 'gammavariate', 'gauss',\n"
+        "              'betavariate', 'paretovariate', 'weibullvariate', 'getrandbits'):\n"
+        "    if hasattr(random, _name):\n"
+        "        setattr(random, _name, getattr(_instance, _name))\n";
+    
+    PyObject* result = PyRun_String(code, Py_file_input, globals, globals);
+    Py_DECREF(globals);
+    if (result == nullptr) {
+        PyErr_Print();
+        throw std::runtime_error("Cannot install battle random source in Python");
+    }
+    Py_DECREF(result);
+}
+
+void PythonSkillLoader::registerNativeSkill(const std::string& scriptPath, const NativeSkillSpec& spec) {
+    std::lock_guard<std::mutex> lock(nativeSkillsMutex);
+    nativeSkills[moduleName(scriptPath)] = spec;
+}
+
+bool PythonSkillLoader::findNativeSkill(const std::string& scriptPath, NativeSkillSpec& spec) {
+    {
+        std::lock_guard<std::mutex> lock(nativeSkillsMutex);
+        auto registered = nativeSkills.find(moduleName(scriptPath));
+        if (registered != nativeSkills.end()) {
+            spec = registered->second;
+            return true;
+        }
+    }
+    
+    // Read from the source, where Python would import it from, so the
+    // description is the same whether or not the interpreter runs
+    std::string module = moduleName(scriptPath);
+    std::ifstream file(module + ".py");
+    if (!file) {
+        file.open("scripts/" + module + ".py");
+    }
+    if (!file) {
+        return false;
+    }
+    std::ostringstream source;
+    source << file.rdbuf();
+    
+    std::string error;
+    if (!NativeSkill::parseDeclaration(source.str(), spec, error)) {
+        if (!error.empty()) {
+            std::cerr << "Ignoring NATIVE_SKILL in " << scriptPath << ": " << error << std::endl;
+        }
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(nativeSkillsMutex);
+    nativeSkills[module] = spec;
+    return true;
+}
+
+int PythonSkillLoader::callSkill(PyObject* function, const Pokemon& attacker, const Pokemon& defender) {
+    POKEMON_PROBE(PYTHON_CALL);
+    
+    // Refresh the pooled stat dictionaries and call the function
+    return callSkill(function, threadArgumentPool().pack(attacker, defender));
+}
+
+int PythonSkillLoader::callSkill(PyObject* function, PyObject* pArgs) {
+    PyObject* pValue = PyObject_CallObject(function, pArgs);
     
     int damage = 0;
     if (pValue != nullptr) {
@@ -91,20 +402,555 @@ int PythonSkillLoader::executeSkill(const std::string& scriptPath, const std::st
         std::cerr << "Call failed" << std::endl;
     }
     
-    // Cleanup
-    Py_DECREF(pArgs);
-    Py_DECREF(pAttackerDict);
-    Py_DECREF(pDefenderDict);
-    Py_DECREF(pFunc);
-    Py_DECREF(pModule);
-    
     return damage;
 }
 
-std::function<int(Pokemon&, Pokemon&)> PythonSkillLoader::loadSkill(
+namespace {
+
+/**
+ * Read-only int32 memoryviews over a batch's columns, released on scope exit
+ * so a script cannot reach the C++ memory after the call
+ */
+class BatchColumnViews {
+private:
+    std::vector<PyObject*> views;   // Raw byte views and their int casts
+    
+public:
+    ~BatchColumnViews() {
+        for (auto it = views.rbegin(); it != views.rend(); ++it) {
+            PyObject* released = PyObject_CallMethod(*it, "release", nullptr);
+            if (released == nullptr) {
+                // A script still exports the buffer; it keeps a stale view
+                PyErr_Clear();
+            }
+            Py_XDECREF(released);
+            Py_DECREF(*it);
+        }
+    }
+    
+    // Stat dict of one side: {"current_hp": memoryview, ...} (new reference)
+    PyObject* side(const SkillBatch& batch, SkillBatch::Side side) {
+        PyObject* dict = PyDict_New();
+        for (int stat = 0; stat < SkillBatch::STAT_COUNT; ++stat) {
+            const int32_t* column = batch.column(side, static_cast<SkillBatch::Stat>(stat));
+            PyObject* bytes = PyMemoryView_FromMemory(const_cast<char*>(reinterpret_cast<const char*>(column)),
+                                                      static_cast<Py_ssize_t>(batch.size() * sizeof(int32_t)),
+                                                      PyBUF_READ);
+            if (bytes == nullptr) {
+                Py_DECREF(dict);
+                return nullptr;
+            }
+            views.push_back(bytes);
+            PyObject* ints = PyObject_CallMethod(bytes, "cast", "s", "i");
+            if (ints == nullptr) {
+                Py_DECREF(dict);
+                return nullptr;
+            }
+            views.push_back(ints);
+            PyDict_SetItemString(dict, SkillBatch::statName(static_cast<SkillBatch::Stat>(stat)), ints);
+        }
+        return dict;
+    }
+};
+
+// Copy an integer buffer (array('i'), NumPy int arrays, ...) into the batch
+bool readDamageBuffer(PyObject* result, SkillBatch& batch) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(result, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0) {
+        PyErr_Clear();
+        return false;
+    }
+    
+    const char* format = view.format != nullptr ? view.format : "B";
+    if (*format == '@' || *format == '=') ++format;
+    bool read = false;
+    if (view.ndim <= 1 && format[0] != '\0' && format[1] == '\0' &&
+        static_cast<size_t>(view.len / view.itemsize) == batch.size()) {
+        read = true;
+        for (size_t i = 0; i < batch.size() && read; ++i) {
+            const char* item = static_cast<const char*>(view.buf) + i * view.itemsize;
+            switch (format[0]) {
+                case 'h': batch.setDamage(i, *reinterpret_cast<const short*>(item)); break;
+                case 'i': batch.setDamage(i, *reinterpret_cast<const int*>(item)); break;
+                case 'l': batch.setDamage(i, static_cast<int>(*reinterpret_cast<const long*>(item))); break;
+                case 'q': batch.setDamage(i, static_cast<int>(*reinterpret_cast<const long long*>(item))); break;
+                default: read = false; break;
+            }
+        }
+    }
+    PyBuffer_Release(&view);
+    return read;
+}
+
+} // namespace
+
+void PythonSkillLoader::callSkillBatch(PyObject* function, const std::string& scriptPath, SkillBatch& batch) {
+    POKEMON_PROBE(PYTHON_CALL);
+    
+    PyObject* result = nullptr;
+    {
+        BatchColumnViews views;
+        PyObject* attackers = views.side(batch, SkillBatch::ATTACKER);
+        PyObject* defenders = attackers != nullptr ? views.side(batch, SkillBatch::DEFENDER) : nullptr;
+        if (defenders != nullptr) {
+            result = PyObject_CallFunctionObjArgs(function, attackers, defenders, nullptr);
+        }
+        Py_XDECREF(attackers);
+        Py_XDECREF(defenders);
+    }
+    
+    if (result == nullptr) {
+        PyErr_Print();
+        throw std::runtime_error("calculate_damage_batch failed in " + scriptPath);
+    }
+    
+    // Fast path for integer buffers, otherwise any sequence of ints
+    bool read = readDamageBuffer(result, batch);
+    if (!read) {
+        PyObject* sequence = PySequence_Fast(result, "calculate_damage_batch must return a sequence");
+        if (sequence != nullptr && static_cast<size_t>(PySequence_Fast_GET_SIZE(sequence)) == batch.size()) {
+            read = true;
+            PyObject** items = PySequence_Fast_ITEMS(sequence);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                long damage = PyLong_AsLong(items[i]);
+                if (damage == -1 && PyErr_Occurred()) {
+                    read = false;
+                    break;
+                }
+                batch.setDamage(i, static_cast<int>(damage));
+            }
+        }
+        Py_XDECREF(sequence);
+    }
+    Py_DECREF(result);
+    
+    if (!read) {
+        if (PyErr_Occurred()) PyErr_Print();
+        throw std::runtime_error("calculate_damage_batch in " + scriptPath + " must return " +
+                                 std::to_string(batch.size()) + " integers");
+    }
+}
+
+int PythonSkillLoader::executeSkill(const std::string& scriptPath, const std::string& functionName,
+                                    Pokemon& attacker, Pokemon& defender) {
+    ensureInitialized();
+    
+    ScopedGil gil;
+    auto handle = resolveSkill(scriptPath, functionName);
+    if (!handle) {
+        return 0;
+    }
+    
+    return callSkill(handle->function, attacker, defender);
+}
+
+int PythonSkillLoader::executeSkill(const std::string& scriptPath, const std::string& functionName,
+                                    Pokemon& attacker, Pokemon& defender, BattleRng& rng) {
+    ensureInitialized();
+    
+    ScopedGil gil;
+    auto handle = resolveSkill(scriptPath, functionName);
+    if (!handle) {
+        return 0;
+    }
+    
+    ScriptRngScope scope(rng);
+    return callSkill(handle->function, attacker, defender);
+}
+
+std::function<int(Pokemon&, Pokemon&, BattleRng&)> PythonSkillLoader::loadSkill(
     const std::string& scriptPath, const std::string& functionName) {
     
-    return [scriptPath, functionName](Pokemon& attacker, Pokemon& defender) -> int {
-        return executeSkill(scriptPath, functionName, attacker, defender);
+    ensureInitialized();
+    
+    // Formula-only skills run natively while output is off (callScriptSkill())
+    NativeSkillSpec spec;
+    ScriptSkillId skill;
+    if (nativeSkillsEnabled && functionName == "calculate_damage" && findNativeSkill(scriptPath, spec)) {
+        skill = registerDeferredSkill(scriptPath, functionName);
+        resolveDeferredSkill(scriptSkills[skill]);
+    } else {
+        skill = registerScriptSkill(scriptPath, functionName);
+    }
+    return [skill](Pokemon& attacker, Pokemon& defender, BattleRng& rng) -> int {
+        return callScriptSkill(skill, attacker, defender, rng);
     };
 }
+
+size_t PythonSkillLoader::findScriptSkill(const std::string& scriptPath, const std::string& functionName, bool deferred) {
+    std::string module = moduleName(scriptPath);
+    size_t index = 0;
+    while (index < scriptSkills.size() &&
+           (moduleName(scriptSkills[index].scriptPath) != module || scriptSkills[index].functionName != functionName ||
+            scriptSkills[index].deferred != deferred)) {
+        ++index;
+    }
+    return index;
+}
+
+ScriptSkillId PythonSkillLoader::registerScriptSkill(const std::string& scriptPath, const std::string& functionName) {
+    ensureInitialized();
+    
+    std::lock_guard<std::mutex> lock(scriptSkillsMutex);
+    size_t index = findScriptSkill(scriptPath, functionName, false);
+    
+    // Already registered and still alive: same handle
+    if (index < scriptSkills.size() && scriptSkills[index].handle->function != nullptr) {
+        return static_cast<ScriptSkillId>(index);
+    }
+    
+    std::shared_ptr<SkillHandle> handle;
+    {
+        ScopedGil gil;
+        handle = resolveSkill(scriptPath, functionName);
+    }
+    if (!handle) {
+        throw std::runtime_error("Cannot load skill " + functionName + " from " + scriptPath);
+    }
+    
+    // A skill registered before finalize() gets its id back with a fresh handle
+    if (index == scriptSkills.size()) {
+        scriptSkills.emplace_back(scriptPath, functionName, false);
+    }
+    scriptSkills[index].handle = handle;
+    scriptSkills[index].deterministic = handle->deterministic;
+    scriptSkills[index].precompile = handle->precompile;
+    return static_cast<ScriptSkillId>(index);
+}
+
+ScriptSkillId PythonSkillLoader::registerDeferredSkill(const std::string& scriptPath, const std::string& functionName) {
+    std::lock_guard<std::mutex> lock(scriptSkillsMutex);
+    size_t index = findScriptSkill(scriptPath, functionName, true);
+    if (index == scriptSkills.size()) {
+        scriptSkills.emplace_back(scriptPath, functionName, true);
+    }
+    return static_cast<ScriptSkillId>(index);
+}
+
+void PythonSkillLoader::resolveDeferredSkill(ScriptSkill& entry) {
+    POKEMON_PROBE(SKILL_SETUP);
+    std::lock_guard<std::mutex> lock(scriptSkillsMutex);
+    if (entry.resolved.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    NativeSkillSpec spec;
+    if (nativeSkillsEnabled && entry.functionName == "calculate_damage" && findNativeSkill(entry.scriptPath, spec)) {
+        entry.native = true;
+        entry.nativeSkill = spec;
+    } else {
+        if (!pythonEnabled) {
+            throw std::runtime_error("Skill " + entry.functionName + " from " + entry.scriptPath +
+                                     " needs Python, which is disabled");
+        }
+        ensureInitialized();
+        
+        // Load it now so a missing script fails here, on first use; the
+        // handle stays cached in the calling thread's interpreter
+        ScopedGil gil;
+        auto handle = resolveSkill(entry.scriptPath, entry.functionName);
+        if (!handle) {
+            throw std::runtime_error("Cannot load skill " + entry.functionName + " from " + entry.scriptPath);
+        }
+        entry.deterministic = handle->deterministic;
+        entry.precompile = handle->precompile;
+    }
+    entry.resolved.store(true, std::memory_order_release);
+}
+
+int PythonSkillLoader::callScriptSkill(ScriptSkillId skill, Pokemon& attacker, Pokemon& defender, BattleRng& rng) {
+    ScriptSkill& entry = scriptSkills[skill];
+    if (!entry.resolved.load(std::memory_order_acquire)) {
+        resolveDeferredSkill(entry);
+    }
+    
+    // Native only while output is discarded (or Python is off): the native
+    // path prints nothing, and the script draws the same numbers
+    if (entry.native && (!scriptOutputEnabled || !pythonEnabled)) {
+        return NativeSkill::calculateDamage(entry.nativeSkill, attacker, defender, rng);
+    }
+    
+    // Deterministic skills answer repeated inputs from the thread's memo
+    // (only while output is discarded: a cached call prints nothing)
+    SkillResultCache* memo = nullptr;
+    SkillResultCache::Key key;
+    if (entry.deterministic && !scriptOutputEnabled && skillMemoCapacity > 0) {
+        memo = &threadSkillMemo(skill);
+        key = SkillResultCache::Key(attacker, defender);
+        if (const int* cached = memo->find(key)) {
+            return *cached;
+        }
+    }
+    ensureInitialized();
+    
+    ScopedGil gil;
+    
+    // Objects cannot cross interpreters: on a thread with a ThreadContext
+    // the skill is resolved again in that thread's sub-interpreter, once.
+    // Main-interpreter handles are resolved (again, after a finalize())
+    // under the main GIL.
+    std::shared_ptr<SkillHandle>* handle = &entry.handle;
+    if (threadContext != nullptr) {
+        auto& local = threadContext->scriptSkills;
+        if (local.size() <= skill) {
+            local.resize(skill + 1);
+        }
+        handle = &local[skill];
+    }
+    if (!*handle || (*handle)->function == nullptr) {
+        POKEMON_PROBE(SKILL_SETUP);
+        *handle = resolveSkill(entry.scriptPath, entry.functionName);
+        if (!*handle) {
+            throw std::runtime_error("Cannot load skill " + entry.functionName + " from " + entry.scriptPath);
+        }
+    }
+    
+    ScriptRngScope scope(rng);
+    int damage = callSkill((*handle)->function, attacker, defender);
+    if (memo != nullptr) {
+        memo->insert(key, damage);
+    }
+    return damage;
+}
+
+bool PythonSkillLoader::isNativeSkill(ScriptSkillId skill) {
+    const ScriptSkill& entry = scriptSkills[skill];
+    return entry.resolved.load(std::memory_order_acquire) && entry.native;
+}
+
+bool PythonSkillLoader::isPrecompilable(ScriptSkillId skill) {
+    ScriptSkill& entry = scriptSkills[skill];
+    if (!entry.resolved.load(std::memory_order_acquire)) {
+        resolveDeferredSkill(entry);
+    }
+    return !entry.native && entry.precompile;
+}
+
+bool PythonSkillLoader::damageDistribution(ScriptSkillId skill, const Pokemon& attacker, const Pokemon& defender,
+                                           DamageDistribution& outcomes) {
+    ScriptSkill& entry = scriptSkills[skill];
+    if (!entry.resolved.load(std::memory_order_acquire)) {
+        resolveDeferredSkill(entry);
+    }
+    if (entry.native) {
+        outcomes = NativeSkill::damageDistribution(entry.nativeSkill, attacker, defender);
+        return true;
+    }
+    outcomes.clear();
+    ensureInitialized();
+    
+    ScopedGil gil;
+    auto handle = resolveSkill(entry.scriptPath, entry.functionName);
+    if (!handle) {
+        throw std::runtime_error("Cannot load skill " + entry.functionName + " from " + entry.scriptPath);
+    }
+    PyObject* declared = PyObject_GetAttrString(handle->module, "damage_distribution");
+    if (declared == nullptr) {
+        PyErr_Clear();
+        return false;
+    }
+    
+    PyObject* result = PyObject_CallObject(declared, threadArgumentPool().pack(attacker, defender));
+    Py_DECREF(declared);
+    PyObject* items = result != nullptr ? PySequence_Fast(result, "not a sequence") : nullptr;
+    Py_XDECREF(result);
+    bool valid = items != nullptr;
+    for (Py_ssize_t i = 0; valid && i < PySequence_Fast_GET_SIZE(items); ++i) {
+        PyObject* pair = PySequence_Fast(PySequence_Fast_GET_ITEM(items, i), "not a pair");
+        valid = pair != nullptr && PySequence_Fast_GET_SIZE(pair) == 2;
+        if (valid) {
+            long damage = PyLong_AsLong(PySequence_Fast_GET_ITEM(pair, 0));
+            double probability = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(pair, 1));
+            valid = !PyErr_Occurred();
+            outcomes.push_back(std::make_pair(static_cast<int>(damage), probability));
+        }
+        Py_XDECREF(pair);
+    }
+    Py_XDECREF(items);
+    if (!valid) {
+        if (PyErr_Occurred()) PyErr_Print();
+        throw std::runtime_error("Invalid damage_distribution in " + entry.scriptPath +
+                                 ": expected (damage, probability) pairs");
+    }
+    return true;
+}
+
+void PythonSkillLoader::bindSkill(Move& move, const std::string& scriptPath, const std::string& functionName) {
+    ensureInitialized();
+    
+    NativeSkillSpec spec;
+    if (nativeSkillsEnabled && functionName == "calculate_damage" && findNativeSkill(scriptPath, spec)) {
+        ScriptSkillId skill = registerDeferredSkill(scriptPath, functionName);
+        resolveDeferredSkill(scriptSkills[skill]);
+        move.setScriptEffect(skill);
+    } else {
+        move.setScriptEffect(registerScriptSkill(scriptPath, functionName));
+    }
+}
+
+void PythonSkillLoader::deferSkill(Move& move, const std::string& scriptPath, const std::string& functionName) {
+    move.setScriptEffect(registerDeferredSkill(scriptPath, functionName));
+}
+
+void PythonSkillLoader::executeSkillBatch(const std::string& scriptPath, SkillBatch& batch, BattleRng& rng) {
+    ensureInitialized();
+    
+    NativeSkillSpec spec;
+    bool native = nativeSkillsEnabled && findNativeSkill(scriptPath, spec);
+    runSkillBatch(scriptPath, "calculate_damage", native ? &spec : nullptr, batch, rng);
+}
+
+void PythonSkillLoader::executeSkillBatch(ScriptSkillId skill, SkillBatch& batch, BattleRng& rng) {
+    ScriptSkill& entry = scriptSkills[skill];
+    if (!entry.resolved.load(std::memory_order_acquire)) {
+        resolveDeferredSkill(entry);
+    }
+    if (!entry.native) {
+        ensureInitialized();
+    }
+    runSkillBatch(entry.scriptPath, entry.functionName, entry.native ? &entry.nativeSkill : nullptr, batch, rng);
+}
+
+void PythonSkillLoader::runSkillBatch(const std::string& scriptPath, const std::string& functionName,
+                                      const NativeSkillSpec* native, SkillBatch& batch, BattleRng& rng) {
+    // Same rule as callScriptSkill(): native only while output is off
+    if (native != nullptr && (!scriptOutputEnabled || !pythonEnabled)) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch.setDamage(i, NativeSkill::calculateDamage(*native, batch, i, rng));
+        }
+        return;
+    }
+    
+    ScopedGil gil;
+    auto handle = resolveSkill(scriptPath, functionName);
+    if (!handle) {
+        throw std::runtime_error("Cannot load skill " + functionName + " from " + scriptPath);
+    }
+    if (batch.empty()) {
+        return;
+    }
+    
+    ScriptRngScope scope(rng);
+    const std::string batchName = functionName + "_batch";
+    if (PyObject_HasAttrString(handle->module, batchName.c_str())) {
+        auto batchHandle = resolveSkill(scriptPath, batchName);
+        if (batchHandle) {
+            callSkillBatch(batchHandle->function, scriptPath, batch);
+            return;
+        }
+    }
+    
+    // No batch function: one call per hit, with the captured stats
+    SkillArgumentPool& pool = threadArgumentPool();
+    for (size_t i = 0; i < batch.size(); ++i) {
+        POKEMON_PROBE(PYTHON_CALL);
+        batch.setDamage(i, callSkill(handle->function, pool.pack(batch, i)));
+    }
+}
+
+PythonSkillLoader::ScopedGil::ScopedGil() : context(threadContext) {
+    if (context == nullptr) {
+        state = PyGILState_Ensure();
+        return;
+    }
+    if (context->threadState == nullptr) {
+        startThreadInterpreter(*context);
+    }
+    if (context->lockDepth++ == 0) {
+        PyEval_RestoreThread(context->threadState);
+    }
+}
+
+PythonSkillLoader::ScopedGil::~ScopedGil() {
+    if (context == nullptr) {
+        PyGILState_Release(state);
+    } else if (--context->lockDepth == 0) {
+        PyEval_SaveThread();
+    }
+}
+
+void PythonSkillLoader::startThreadInterpreter(InterpreterContext& context) {
+    POKEMON_PROBE(SKILL_SETUP);
+#if PY_VERSION_HEX >= 0x030C0000
+    std::lock_guard<std::mutex> lock(contextMutex);
+    
+    // Isolated interpreter: own GIL and allocator, no fork/exec, and only
+    // extension modules that support multiple interpreters
+    PyInterpreterConfig config = {};
+    config.use_main_obmalloc = 0;
+    config.allow_fork = 0;
+    config.allow_exec = 0;
+    config.allow_threads = 1;
+    config.allow_daemon_threads = 0;
+    config.check_multi_interp_extensions = 1;
+    config.gil = PyInterpreterConfig_OWN_GIL;
+    
+    // Called without any thread state; the new one becomes current and
+    // holds the new interpreter's GIL
+    PyThreadState* threadState = nullptr;
+    PyStatus status = Py_NewInterpreterFromConfig(&threadState, &config);
+    if (PyStatus_Exception(status) || threadState == nullptr) {
+        throw std::runtime_error("Cannot create Python sub-interpreter");
+    }
+    
+    try {
+        prepareInterpreter();
+        context.argumentPool.reset(new SkillArgumentPool());
+    } catch (...) {
+        Py_EndInterpreter(threadState);
+        throw;
+    }
+    PyEval_SaveThread();
+    context.threadState = threadState;
+#else
+    (void)context;
+#endif
+}
+
+bool PythonSkillLoader::ThreadContext::isSupported() {
+#if PY_VERSION_HEX >= 0x030C0000
+    return true;
+#else
+    return false;
+#endif
+}
+
+PythonSkillLoader::ThreadContext::ThreadContext() : context(nullptr) {
+#if PY_VERSION_HEX >= 0x030C0000
+    if (!pythonEnabled || threadContext != nullptr) {
+        return;
+    }
+    
+    // The sub-interpreter is created by the first ScopedGil on this thread
+    context = new InterpreterContext();
+    threadContext = context;
+#endif
+}
+
+PythonSkillLoader::ThreadContext::~ThreadContext() {
+#if PY_VERSION_HEX >= 0x030C0000
+    if (context == nullptr) {
+        return;
+    }
+    
+    threadContext = nullptr;
+    if (context->threadState != nullptr) {
+        std::lock_guard<std::mutex> lock(contextMutex);
+        PyEval_RestoreThread(context->threadState);
+        
+        // Release this interpreter's objects before it is destroyed
+        for (auto& entry : context->skillCache) {
+            Py_XDECREF(entry.second->function);
+            Py_XDECREF(entry.second->module);
+            entry.second->function = nullptr;
+            entry.second->module = nullptr;
+        }
+        context->skillCache.clear();
+        context->scriptSkills.clear();
+        context->argumentPool.reset();
+        
+        Py_EndInterpreter(context->threadState);
+    }
+    delete context;
+#endif
+}
@@ -0,0 +1,323 @@
+#include "ReplayLog.h"
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[4] = {'P', 'K', 'R', 'L'};
+const uint16_t kVersion = 1;
+const size_t kHeaderSize = 8;
+const size_t kActionSize = 12;
+
+// Little-endian encoding into a byte buffer
+void putU8(std::string& out, unsigned value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+}
+
+void putU16(std::string& out, unsigned value) {
+    putU8(out, value);
+    putU8(out, value >> 8);
+}
+
+void putU32(std::string& out, uint32_t value) {
+    putU16(out, value & 0xFFFF);
+    putU16(out, value >> 16);
+}
+
+void putU64(std::string& out, uint64_t value) {
+    putU32(out, static_cast<uint32_t>(value));
+    putU32(out, static_cast<uint32_t>(value >> 32));
+}
+
+void putStat(std::string& out, int value) {
+    if (value < 0 || value > 0xFFFF) {
+        throw std::runtime_error("Replay log: stat out of range (" + std::to_string(value) + ")");
+    }
+    putU16(out, static_cast<unsigned>(value));
+}
+
+void putDamage(std::string& out, int value) {
+    if (value < -0x8000 || value > 0x7FFF) {
+        throw std::runtime_error("Replay log: damage out of range (" + std::to_string(value) + ")");
+    }
+    putU16(out, static_cast<uint16_t>(value));
+}
+
+void putString(std::string& out, const std::string& text) {
+    if (text.size() > 0xFF) {
+        throw std::runtime_error("Replay log: name too long: " + text);
+    }
+    putU8(out, static_cast<unsigned>(text.size()));
+    out += text;
+}
+
+void putPokemon(std::string& out, const ReplayPokemon& pokemon) {
+    putString(out, pokemon.name);
+    putU8(out, static_cast<unsigned>(pokemon.type));
+    putStat(out, pokemon.maxHP);
+    putStat(out, pokemon.attack);
+    putStat(out, pokemon.defense);
+    putStat(out, pokemon.specialDefense);
+    putStat(out, pokemon.speed);
+    if (pokemon.moves.size() > 0xFF) {
+        throw std::runtime_error("Replay log: too many moves for " + pokemon.name);
+    }
+    putU8(out, static_cast<unsigned>(pokemon.moves.size()));
+    for (const auto& move : pokemon.moves) {
+        putString(out, move);
+    }
+}
+
+// Little-endian u16 field of the file header
+uint16_t getU16(const char* bytes) {
+    return static_cast<uint16_t>(static_cast<unsigned char>(bytes[0]) | (static_cast<unsigned char>(bytes[1]) << 8));
+}
+
+// Bounds-checked little-endian decoding from a record buffer
+class RecordCursor {
+private:
+    const std::string& data;
+    size_t position;
+    
+    const unsigned char* take(size_t count) {
+        if (position + count > data.size()) {
+            throw std::runtime_error("Replay log: corrupt battle record");
+        }
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data()) + position;
+        position += count;
+        return bytes;
+    }
+    
+public:
+    explicit RecordCursor(const std::string& data) : data(data), position(0) {}
+    
+    uint8_t u8() { return *take(1); }
+    
+    uint16_t u16() {
+        const unsigned char* b = take(2);
+        return static_cast<uint16_t>(b[0] | (b[1] << 8));
+    }
+    
+    uint32_t u32() {
+        uint32_t low = u16();
+        return low | (static_cast<uint32_t>(u16()) << 16);
+    }
+    
+    uint64_t u64() {
+        uint64_t low = u32();
+        return low | (static_cast<uint64_t>(u32()) << 32);
+    }
+    
+    std::string string() {
+        size_t length = u8();
+        return std::string(reinterpret_cast<const char*>(take(length)), length);
+    }
+    
+    size_t remaining() const { return data.size() - position; }
+};
+
+ReplayPokemon readPokemon(RecordCursor& cursor) {
+    ReplayPokemon pokemon;
+    pokemon.name = cursor.string();
+    uint8_t type = cursor.u8();
+    if (type >= static_cast<uint8_t>(PokemonType::COUNT)) {
+        throw std::runtime_error("Replay log: corrupt battle record");
+    }
+    pokemon.type = static_cast<PokemonType>(type);
+    pokemon.maxHP = cursor.u16();
+    pokemon.attack = cursor.u16();
+    pokemon.defense = cursor.u16();
+    pokemon.specialDefense = cursor.u16();
+    pokemon.speed = cursor.u16();
+    int moveCount = cursor.u8();
+    for (int i = 0; i < moveCount; ++i) {
+        pokemon.moves.push_back(cursor.string());
+    }
+    return pokemon;
+}
+
+// Recording mode in words, for mismatch errors
+std::string describeFlags(uint16_t flags) {
+    std::string text = (flags & ReplayLogWriter::kNativeOnly) ? "Python disabled" : "Python enabled";
+    if (flags & ReplayLogWriter::kPrecompiled) {
+        text += ", damage tables";
+    }
+    int aiDepth = (flags & ReplayLogWriter::kAiDepthMask) >> ReplayLogWriter::kAiDepthShift;
+    if (aiDepth > 0) {
+        text += ", AI depth " + std::to_string(aiDepth);
+    } else {
+        text += ", random moves";
+    }
+    return text;
+}
+
+} // namespace
+
+const uint16_t ReplayLogWriter::kNativeOnly;
+const uint16_t ReplayLogWriter::kPrecompiled;
+const uint16_t ReplayLogWriter::kAiDepthMask;
+const int ReplayLogWriter::kAiDepthShift;
+
+uint16_t ReplayLogWriter::aiDepthFlags(int aiDepth) {
+    if (aiDepth < 0 || aiDepth > (kAiDepthMask >> kAiDepthShift)) {
+        throw std::invalid_argument("Replay log: AI depth out of range (" + std::to_string(aiDepth) + ")");
+    }
+    return static_cast<uint16_t>(aiDepth << kAiDepthShift);
+}
+
+// Open for appending; write the header to a new log, validate an existing one
+ReplayLogWriter::ReplayLogWriter(const std::string& path, uint16_t flags) {
+    {
+        std::ifstream existing(path, std::ios::binary);
+        char header[kHeaderSize];
+        if (existing && existing.read(header, kHeaderSize)) {
+            if (std::string(header, 4) != std::string(kMagic, 4)) {
+                throw std::runtime_error("Not a replay log: " + path);
+            }
+            uint16_t version = getU16(header + 4);
+            if (version != kVersion) {
+                throw std::runtime_error("Unsupported replay log version " + std::to_string(version) + ": " + path);
+            }
+            uint16_t recorded = getU16(header + 6);
+            if (recorded != flags) {
+                throw std::runtime_error("Replay log " + path + " was recorded with " + describeFlags(recorded) +
+                                         ", not " + describeFlags(flags));
+            }
+        } else if (existing && existing.gcount() > 0) {
+            throw std::runtime_error("Not a replay log: " + path);
+        }
+    }
+    
+    file.open(path, std::ios::binary | std::ios::app);
+    if (!file) {
+        throw std::runtime_error("Cannot open replay log: " + path);
+    }
+    file.seekp(0, std::ios::end);
+    if (file.tellp() == 0) {
+        std::string header(kMagic, 4);
+        putU16(header, kVersion);
+        putU16(header, flags);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+}
+
+void ReplayLogWriter::append(const BattleReplay& replay) {
+    if (replay.turnStarts.size() > 0xFFFF) {
+        throw std::runtime_error("Replay log: battle too long");
+    }
+    
+    // Serialize the record body after a placeholder for its size
+    record.assign(4, '\0');
+    putU64(record, replay.seed);
+    putPokemon(record, replay.pokemon[0]);
+    putPokemon(record, replay.pokemon[1]);
+    putU8(record, replay.winner);
+    putU16(record, static_cast<unsigned>(replay.turnStarts.size()));
+    putU32(record, static_cast<uint32_t>(replay.actions.size()));
+    for (uint32_t start : replay.turnStarts) {
+        putU32(record, start);
+    }
+    for (const auto& action : replay.actions) {
+        putU8(record, action.actor);
+        putU8(record, action.move);
+        putU8(record, action.outcome);
+        putU8(record, action.effectiveness);
+        putDamage(record, action.damage);
+        putU16(record, action.hp[0]);
+        putU16(record, action.hp[1]);
+        putU8(record, action.status[0]);
+        putU8(record, action.status[1]);
+    }
+    
+    uint32_t size = static_cast<uint32_t>(record.size() - 4);
+    for (int i = 0; i < 4; ++i) {
+        record[i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    }
+    
+    file.write(record.data(), static_cast<std::streamsize>(record.size()));
+    if (!file) {
+        throw std::runtime_error("Replay log: write failed");
+    }
+}
+
+// Open and index: hop from record size to record size
+ReplayLogReader::ReplayLogReader(const std::string& path) : file(path, std::ios::binary), flags(0) {
+    if (!file) {
+        throw std::runtime_error("Cannot open replay log: " + path);
+    }
+    
+    char header[kHeaderSize];
+    if (!file.read(header, kHeaderSize) || std::string(header, 4) != std::string(kMagic, 4)) {
+        throw std::runtime_error("Not a replay log: " + path);
+    }
+    uint16_t version = getU16(header + 4);
+    if (version != kVersion) {
+        throw std::runtime_error("Unsupported replay log version " + std::to_string(version) + ": " + path);
+    }
+    flags = getU16(header + 6);
+    
+    file.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    uint64_t offset = kHeaderSize;
+    while (offset < fileSize) {
+        unsigned char sizeBytes[4];
+        file.seekg(static_cast<std::streamoff>(offset));
+        if (!file.read(reinterpret_cast<char*>(sizeBytes), 4)) {
+            throw std::runtime_error("Replay log truncated: " + path);
+        }
+        uint64_t size = sizeBytes[0] | (sizeBytes[1] << 8) | (sizeBytes[2] << 16) |
+                        (static_cast<uint64_t>(sizeBytes[3]) << 24);
+        if (offset + 4 + size > fileSize) {
+            throw std::runtime_error("Replay log truncated: " + path);
+        }
+        offsets.push_back(offset);
+        offset += 4 + size;
+    }
+}
+
+BattleReplay ReplayLogReader::readBattle(size_t index) {
+    if (index >= offsets.size()) {
+        throw std::out_of_range("Replay log has no battle " + std::to_string(index));
+    }
+    
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offsets[index]));
+    unsigned char sizeBytes[4];
+    file.read(reinterpret_cast<char*>(sizeBytes), 4);
+    uint32_t size = sizeBytes[0] | (sizeBytes[1] << 8) | (sizeBytes[2] << 16) |
+                    (static_cast<uint32_t>(sizeBytes[3]) << 24);
+    std::string data(size, '\0');
+    if (!file.read(&data[0], size)) {
+        throw std::runtime_error("Replay log: corrupt battle record");
+    }
+    
+    RecordCursor cursor(data);
+    BattleReplay replay;
+    replay.seed = cursor.u64();
+    replay.pokemon[0] = readPokemon(cursor);
+    replay.pokemon[1] = readPokemon(cursor);
+    replay.winner = cursor.u8();
+    size_t turnCount = cursor.u16();
+    size_t actionCount = cursor.u32();
+    if (cursor.remaining() != turnCount * 4 + actionCount * kActionSize) {
+        throw std::runtime_error("Replay log: corrupt battle record");
+    }
+    
+    replay.turnStarts.resize(turnCount);
+    for (auto& start : replay.turnStarts) {
+        start = cursor.u32();
+    }
+    replay.actions.resize(actionCount);
+    for (auto& action : replay.actions) {
+        action.actor = cursor.u8();
+        action.move = cursor.u8();
+        action.outcome = cursor.u8();
+        action.effectiveness = cursor.u8();
+        action.damage = static_cast<int16_t>(cursor.u16());
+        action.hp[0] = cursor.u16();
+        action.hp[1] = cursor.u16();
+        action.status[0] = cursor.u8();
+        action.status[1] = cursor.u8();
+    }
+    
+    return replay;
+}
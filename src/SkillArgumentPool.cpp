@@ -0,0 +1,81 @@
+#include "SkillArgumentPool.h"
+#include "Pokemon.h"
+#include "SkillBatch.h"
+
+// Dictionary keys for each Field, in enum order
+static const char* const kFieldNames[] = {
+    "current_hp", "max_hp", "attack", "defense", "special_defense", "speed"
+};
+
+SkillArgumentPool::SkillArgumentPool() {
+    nameKey = PyUnicode_InternFromString("name");
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        fieldKeys[i] = PyUnicode_InternFromString(kFieldNames[i]);
+    }
+    
+    attackerStats.dict = PyDict_New();
+    defenderStats.dict = PyDict_New();
+    args = PyTuple_Pack(2, attackerStats.dict, defenderStats.dict);
+}
+
+SkillArgumentPool::~SkillArgumentPool() {
+    Py_XDECREF(args);
+    Py_XDECREF(attackerStats.dict);
+    Py_XDECREF(defenderStats.dict);
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        Py_XDECREF(fieldKeys[i]);
+    }
+    Py_XDECREF(nameKey);
+}
+
+void SkillArgumentPool::update(StatDict& stats, const std::string& name, const long (&current)[FIELD_COUNT]) {
+    if (!stats.populated || stats.name != name) {
+        PyObject* value = PyUnicode_FromString(name.c_str());
+        PyDict_SetItem(stats.dict, nameKey, value);
+        Py_DECREF(value);  // PyDict_SetItem holds its own reference
+        stats.name = name;
+    }
+    
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        if (stats.populated && stats.values[i] == current[i]) continue;
+        
+        PyObject* value = PyLong_FromLong(current[i]);
+        PyDict_SetItem(stats.dict, fieldKeys[i], value);
+        Py_DECREF(value);
+        stats.values[i] = current[i];
+    }
+    
+    stats.populated = true;
+}
+
+void SkillArgumentPool::update(StatDict& stats, const Pokemon& pokemon) {
+    const long current[FIELD_COUNT] = {
+        pokemon.getCurrentHP(),
+        pokemon.getMaxHP(),
+        pokemon.getAttack(),
+        pokemon.getDefense(),
+        pokemon.getSpecialDefense(),
+        pokemon.getSpeed()
+    };
+    update(stats, pokemon.getName(), current);
+}
+
+PyObject* SkillArgumentPool::pack(const Pokemon& attacker, const Pokemon& defender) {
+    update(attackerStats, attacker);
+    update(defenderStats, defender);
+    return args;
+}
+
+PyObject* SkillArgumentPool::pack(const SkillBatch& batch, size_t hit) {
+    // SkillBatch columns use the same field order
+    const SkillBatch::Side sides[] = {SkillBatch::ATTACKER, SkillBatch::DEFENDER};
+    StatDict* dicts[] = {&attackerStats, &defenderStats};
+    for (int s = 0; s < 2; ++s) {
+        long current[FIELD_COUNT];
+        for (int i = 0; i < FIELD_COUNT; ++i) {
+            current[i] = batch.getStat(sides[s], static_cast<SkillBatch::Stat>(i), hit);
+        }
+        update(*dicts[s], batch.getName(sides[s], hit), current);
+    }
+    return args;
+}
@@ -0,0 +1,47 @@
+#include "SkillBatch.h"
+#include "Pokemon.h"
+
+// Dictionary keys for each Stat, in enum order
+static const char* const kStatNames[] = {
+    "current_hp", "max_hp", "attack", "defense", "special_defense", "speed"
+};
+
+const char* SkillBatch::statName(Stat stat) {
+    return kStatNames[stat];
+}
+
+size_t SkillBatch::add(const Pokemon& attacker, const Pokemon& defender) {
+    const Pokemon* sides[2] = {&attacker, &defender};
+    for (int side = 0; side < 2; ++side) {
+        const Pokemon& p = *sides[side];
+        columns[side][CURRENT_HP].push_back(p.getCurrentHP());
+        columns[side][MAX_HP].push_back(p.getMaxHP());
+        columns[side][ATTACK].push_back(p.getAttack());
+        columns[side][DEFENSE].push_back(p.getDefense());
+        columns[side][SPECIAL_DEFENSE].push_back(p.getSpecialDefense());
+        columns[side][SPEED].push_back(p.getSpeed());
+        names[side].push_back(p.getName());
+    }
+    damage.push_back(0);
+    return damage.size() - 1;
+}
+
+void SkillBatch::clear() {
+    for (int side = 0; side < 2; ++side) {
+        for (int stat = 0; stat < STAT_COUNT; ++stat) {
+            columns[side][stat].clear();
+        }
+        names[side].clear();
+    }
+    damage.clear();
+}
+
+void SkillBatch::reserve(size_t hits) {
+    for (int side = 0; side < 2; ++side) {
+        for (int stat = 0; stat < STAT_COUNT; ++stat) {
+            columns[side][stat].reserve(hits);
+        }
+        names[side].reserve(hits);
+    }
+    damage.reserve(hits);
+}
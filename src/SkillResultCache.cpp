@@ -0,0 +1,73 @@
+#include "SkillResultCache.h"
+#include "Pokemon.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+SkillResultCache::Key::Key(const Pokemon& attacker, const Pokemon& defender) {
+    const Pokemon* sides[2] = {&attacker, &defender};
+    for (int side = 0; side < 2; ++side) {
+        const Pokemon& pokemon = *sides[side];
+        names[side] = pokemon.getName();
+        stats[side][0] = pokemon.getCurrentHP();
+        stats[side][1] = pokemon.getMaxHP();
+        stats[side][2] = pokemon.getAttack();
+        stats[side][3] = pokemon.getDefense();
+        stats[side][4] = pokemon.getSpecialDefense();
+        stats[side][5] = pokemon.getSpeed();
+    }
+}
+
+bool SkillResultCache::Key::operator==(const Key& other) const {
+    return std::equal(&stats[0][0], &stats[0][0] + 12, &other.stats[0][0]) &&
+           names[0] == other.names[0] && names[1] == other.names[1];
+}
+
+size_t SkillResultCache::KeyHash::operator()(const Key& key) const {
+    // FNV-1a over the stats, then mix in the names
+    uint64_t hash = 14695981039346656037ull;
+    for (int side = 0; side < 2; ++side) {
+        for (int i = 0; i < 6; ++i) {
+            hash = (hash ^ static_cast<uint32_t>(key.stats[side][i])) * 1099511628211ull;
+        }
+    }
+    std::hash<std::string> text;
+    hash ^= text(key.names[0]) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    hash ^= text(key.names[1]) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return static_cast<size_t>(hash);
+}
+
+SkillResultCache::SkillResultCache(size_t capacity)
+    : capacity(std::max<size_t>(capacity, 1)), hits(0), misses(0) {
+    index.reserve(this->capacity);
+}
+
+const int* SkillResultCache::find(const Key& key) {
+    auto found = index.find(key);
+    if (found == index.end()) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    return &found->second->second;
+}
+
+void SkillResultCache::insert(const Key& key, int result) {
+    auto found = index.find(key);
+    if (found != index.end()) {
+        found->second->second = result;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+
+    if (entries.size() >= capacity) {
+        // Reuse the least recently used node for the new entry
+        index.erase(entries.back().first);
+        entries.back() = std::make_pair(key, result);
+        entries.splice(entries.begin(), entries, std::prev(entries.end()));
+    } else {
+        entries.emplace_front(key, result);
+    }
+    index.emplace(key, entries.begin());
+}
@@ -0,0 +1,24 @@
+#include "StatusEffect.h"
+#include <stdexcept>
+
+// Rule table, in StatusEffect order
+const StatusRule StatusRules::rules[static_cast<int>(StatusEffect::COUNT)] = {
+    // name         tick  drain  skip%  self  lost   tick message                            skip message
+    {"",            0,    false, 0,     0,    false, nullptr,                                nullptr},
+    {"Poisoned",    8,    false, 0,     0,    false, " is hurt by poison!",                  nullptr},
+    {"Burned",      16,   false, 0,     0,    false, " is hurt by burn!",                    nullptr},
+    {"Paralyzed",   0,    false, 50,    0,    false, " is paralyzed!",                       " is fully paralyzed and can't move!"},
+    {"Asleep",      0,    false, 100,   0,    true,  nullptr,                                " is fast asleep!"},
+    {"Frozen",      0,    false, 100,   0,    true,  nullptr,                                " is frozen solid!"},
+    {"Confused",    0,    false, 33,    8,    false, nullptr,                                " hurt itself in its confusion!"},
+    {"Seeded",      8,    true,  0,     0,    false, "'s health is sapped by Leech Seed!",   nullptr},
+};
+
+StatusEffect StatusRules::parse(const std::string& name) {
+    for (int i = 0; i < static_cast<int>(StatusEffect::COUNT); ++i) {
+        if (name == rules[i].name) {
+            return static_cast<StatusEffect>(i);
+        }
+    }
+    throw std::invalid_argument("Unknown status effect: " + name);
+}
@@ -0,0 +1,47 @@
+#include "Team.h"
+#include <stdexcept>
+#include <string>
+
+const size_t Team::kMaxSize;
+
+// Add a member in the next free slot
+size_t Team::add(Pokemon& pokemon) {
+    if (count >= kMaxSize) {
+        throw std::runtime_error("Team is full (" + std::to_string(kMaxSize) + " Pokemon)");
+    }
+    members[count] = &pokemon;
+    return count++;
+}
+
+// Change the member in battle
+void Team::setActive(size_t slot) {
+    if (slot >= count) {
+        throw std::out_of_range("Team has no slot " + std::to_string(slot));
+    }
+    activeSlot = slot;
+}
+
+// Count healthy members on the bench
+size_t Team::benchCount() const {
+    size_t healthy = 0;
+    for (size_t slot = 0; slot < count; ++slot) {
+        if (canSwitchTo(slot)) healthy++;
+    }
+    return healthy;
+}
+
+// Lowest healthy bench slot
+size_t Team::firstBenchSlot() const {
+    for (size_t slot = 0; slot < count; ++slot) {
+        if (canSwitchTo(slot)) return slot;
+    }
+    return count;
+}
+
+// A team is beaten once no member can fight
+bool Team::isDefeated() const {
+    for (size_t slot = 0; slot < count; ++slot) {
+        if (!members[slot]->isFainted()) return false;
+    }
+    return true;
+}
@@ -0,0 +1,157 @@
+#include "TeamBattle.h"
+#include "Battle.h"
+#include <stdexcept>
+
+// Constructor: copy both parties; the leads are their active members
+TeamBattle::TeamBattle(const Team& team1, const Team& team2, uint64_t seed, BattleEventSink& events)
+    : teams{team1, team2}, events(&events), rng(seed), policies{nullptr, nullptr}, switchChance(0),
+      turnCount(0), switchCount(0), firstSide(0), orderStale(true) {
+    if (team1.empty() || team2.empty()) {
+        throw std::invalid_argument("TeamBattle needs at least one Pokemon per team");
+    }
+}
+
+// Speed order only changes when a side sends in another Pokemon
+void TeamBattle::updateTurnOrder() {
+    if (!orderStale) return;
+    // Higher Speed acts first; ties go to side 0
+    firstSide = (teams[0].active().getSpeed() >= teams[1].active().getSpeed()) ? 0 : 1;
+    orderStale = false;
+}
+
+// Ask the side's policy for a move, or draw one at random
+int TeamBattle::chooseMove(int side, bool movesFirst) {
+    Pokemon& self = teams[side].active();
+    DecisionPolicy* policy = policies[side];
+    if (policy == nullptr) {
+        return rng.nextInt(static_cast<int>(self.getMoveCount()));
+    }
+    return policy->chooseMove(self, teams[1 - side].active(), movesFirst, rng);
+}
+
+// Voluntary switch at the start of a turn
+bool TeamBattle::trySwitch(int side) {
+    if (policies[side] == nullptr && switchChance <= 0) return false;
+    const Team& team = teams[side];
+    size_t bench = team.benchCount();
+    if (bench == 0) return false;
+
+    int slot = -1;
+    if (policies[side] != nullptr) {
+        slot = policies[side]->chooseSwitch(team, teams[1 - side].active(), rng);
+    } else if (switchChance > 0 && rng.nextInt(100) < switchChance) {
+        // The n-th healthy bench member, uniformly
+        int pick = rng.nextInt(static_cast<int>(bench));
+        for (size_t candidate = 0; candidate < team.size(); ++candidate) {
+            if (team.canSwitchTo(candidate) && pick-- == 0) {
+                slot = static_cast<int>(candidate);
+                break;
+            }
+        }
+    }
+
+    if (slot < 0 || !team.canSwitchTo(static_cast<size_t>(slot))) return false;
+    sendIn(side, static_cast<size_t>(slot));
+    return true;
+}
+
+// Report a fainted Pokemon and send in the policy's choice, or the first
+// healthy member
+bool TeamBattle::replaceFainted(int side) {
+    const Team& team = teams[side];
+    events->onEvent(BattleEvent(BattleEventType::FAINTED, &team.active(), &teams[1 - side].active()));
+    if (team.benchCount() == 0) return false;
+
+    int slot = -1;
+    if (policies[side] != nullptr) {
+        slot = policies[side]->chooseReplacement(team, teams[1 - side].active(), rng);
+    }
+    if (slot < 0 || !team.canSwitchTo(static_cast<size_t>(slot))) {
+        slot = static_cast<int>(team.firstBenchSlot());
+    }
+    sendIn(side, static_cast<size_t>(slot));
+    return true;
+}
+
+// Change a side's active member and invalidate the turn order
+void TeamBattle::sendIn(int side, size_t slot) {
+    Team& team = teams[side];
+    Pokemon& outgoing = team.active();
+    team.setActive(slot);
+    switchCount++;
+    orderStale = true;
+    events->onEvent(BattleEvent(BattleEventType::SWITCHED, &team.active(), &outgoing, nullptr, static_cast<int>(slot)));
+}
+
+// One action, then replace whoever fainted: the target from the move, the
+// attacker from its status. A target that was already down (its side has
+// no one left) has been reported and is not replaced.
+bool TeamBattle::act(int side, bool movesFirst) {
+    Pokemon& attacker = teams[side].active();
+    Pokemon& defender = teams[1 - side].active();
+    const bool defenderDown = defender.isFainted();
+    events->onEvent(BattleEvent(BattleEventType::ACTION_START, &attacker, &defender));
+    Battle::executeAction(attacker, defender, chooseMove(side, movesFirst), rng, *events);
+
+    bool bothStanding = !defenderDown;
+    if (!defenderDown && defender.isFainted()) bothStanding = replaceFainted(1 - side);
+    if (attacker.isFainted()) bothStanding = replaceFainted(side) && bothStanding;
+    return bothStanding;
+}
+
+// Run turns until a side has no healthy Pokemon
+int TeamBattle::start() {
+    // A fainted lead is swapped for the first healthy member before the battle
+    for (Team& team : teams) {
+        if (team.active().isFainted() && team.benchCount() > 0) {
+            team.setActive(team.firstBenchSlot());
+        }
+    }
+
+    events->onEvent(BattleEvent(BattleEventType::BATTLE_START, &teams[0].active(), &teams[1].active()));
+    events->onEvent(BattleEvent(BattleEventType::STATE_SNAPSHOT, &teams[0].active(), &teams[1].active()));
+
+    turnCount = 0;
+    switchCount = 0;
+    orderStale = true;
+    bool over = teams[0].active().isFainted() || teams[1].active().isFainted();
+    // Without policies or a switch chance no side ever switches voluntarily
+    const bool switching = switchChance > 0 || policies[0] != nullptr || policies[1] != nullptr;
+
+    while (!over) {
+        events->onEvent(BattleEvent(BattleEventType::TURN_START, nullptr, nullptr, nullptr, ++turnCount));
+
+        // Switches come before moves; a side that switches does not move
+        updateTurnOrder();
+        bool moves[2] = {true, true};
+        if (switching) {
+            int leader = firstSide;
+            moves[leader] = !trySwitch(leader);
+            moves[1 - leader] = !trySwitch(1 - leader);
+            updateTurnOrder();
+        }
+        int first = firstSide;
+        int second = 1 - first;
+
+        // A Pokemon sent in after a faint does not act until the next turn.
+        // As in Battle, the second side still acts when the first mover's
+        // side ran out by its own status or confusion; if the second side
+        // then runs out too, side 1 wins.
+        if (moves[first]) {
+            size_t secondSlot = teams[second].getActiveSlot();
+            over = !act(first, true);
+            moves[second] = moves[second] && teams[second].getActiveSlot() == secondSlot;
+        }
+        if (moves[second] && !teams[second].isDefeated()) {
+            over = !act(second, false) || over;
+        }
+
+        if (!over) {
+            events->onEvent(BattleEvent(BattleEventType::STATE_SNAPSHOT, &teams[0].active(), &teams[1].active()));
+        }
+    }
+
+    int winner = teams[0].isDefeated() ? 1 : 0;
+    events->onEvent(BattleEvent(BattleEventType::BATTLE_END, &teams[winner].active(), &teams[1 - winner].active()));
+    return winner;
+}
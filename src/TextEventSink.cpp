@@ -0,0 +1,114 @@
+#include "TextEventSink.h"
+#include "Pokemon.h"
+#include "Move.h"
+
+// Constructor: render to the given stream
+TextEventSink::TextEventSink(std::ostream& out) : out(&out) {
+}
+
+// Destructor: don't lose the tail of the transcript
+TextEventSink::~TextEventSink() {
+    flush();
+}
+
+// Write buffered text in one block
+void TextEventSink::flush() {
+    const std::string text = buffer.str();
+    if (!text.empty()) {
+        out->write(text.data(), static_cast<std::streamsize>(text.size()));
+        buffer.str(std::string());
+    }
+    out->flush();
+}
+
+// Render one event as transcript lines
+void TextEventSink::onEvent(const BattleEvent& event) {
+    switch (event.type) {
+        case BattleEventType::BATTLE_START:
+            buffer << "\n*** Battle Start! ***\n";
+            buffer << event.actor->getName() << " vs " << event.target->getName() << "!\n";
+            break;
+        case BattleEventType::STATE_SNAPSHOT:
+            buffer << "\n=== Battle State ===\n";
+            event.actor->displayStatus(buffer);
+            buffer << "VS\n";
+            event.target->displayStatus(buffer);
+            buffer << "==================\n\n";
+            break;
+        case BattleEventType::TURN_START:
+            buffer << "\n--- Turn " << event.value << " ---\n";
+            break;
+        case BattleEventType::ACTION_START:
+            buffer << "\n" << event.actor->getName() << "'s turn:\n";
+            break;
+        case BattleEventType::NO_MOVES:
+            buffer << event.actor->getName() << " has no moves!\n";
+            break;
+        case BattleEventType::TURN_LOST:
+            buffer << event.actor->getName() << StatusRules::get(event.status).skipMessage;
+            if (event.value > 0) {
+                buffer << " (-" << event.value << " HP)";
+            }
+            buffer << "\n";
+            break;
+        case BattleEventType::MISSED:
+            buffer << event.actor->getName() << "'s " << event.move->getName() << " missed!\n";
+            break;
+        case BattleEventType::MOVE_USED:
+            buffer << event.actor->getName() << " used " << event.move->getName() << "!\n";
+            // The move's skill may print its own commentary next
+            flush();
+            break;
+        case BattleEventType::DAMAGE:
+            buffer << "It dealt " << event.value << " damage!\n";
+            break;
+        case BattleEventType::EFFECTIVENESS:
+            if (event.multiplier > 1.0) {
+                buffer << "It's super effective!\n";
+            } else if (event.multiplier > 0.0) {
+                buffer << "It's not very effective...\n";
+            } else {
+                buffer << "It doesn't affect " << event.target->getName() << "...\n";
+            }
+            break;
+        case BattleEventType::HEALED:
+            buffer << event.actor->getName() << " restored " << event.value << " HP!\n";
+            break;
+        case BattleEventType::STATUS_APPLIED:
+            buffer << event.actor->getName() << " is now " << StatusRules::name(event.status) << "!\n";
+            break;
+        case BattleEventType::STATUS_TICK: {
+            const StatusRule& rule = StatusRules::get(event.status);
+            if (rule.tickMessage) {
+                buffer << event.actor->getName() << rule.tickMessage;
+                if (rule.tickDamageDivisor > 0) {
+                    buffer << " (-" << event.value << " HP)";
+                }
+                buffer << "\n";
+            }
+            break;
+        }
+        case BattleEventType::ABSORBED:
+            buffer << event.actor->getName() << " absorbed " << event.value << " HP!\n";
+            break;
+        case BattleEventType::STATUS_RECOVERED:
+            buffer << event.actor->getName() << " recovered from " << StatusRules::name(event.status) << "!\n";
+            break;
+        case BattleEventType::FAINTED:
+            buffer << "\n" << event.actor->getName() << " fainted!\n";
+            break;
+        case BattleEventType::BATTLE_END:
+            buffer << "\n*** " << event.actor->getName() << " wins the battle! ***\n\n";
+            flush();
+            break;
+        case BattleEventType::SWITCHED:
+            if (event.target->isFainted()) {
+                buffer << event.actor->getName() << " is sent out!\n";
+            } else {
+                buffer << event.target->getName() << " withdrew. Go, " << event.actor->getName() << "!\n";
+            }
+            break;
+        case BattleEventType::COUNT:
+            break;
+    }
+}
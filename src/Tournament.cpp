@@ -0,0 +1,80 @@
+#include "Tournament.h"
+#include "BattleRng.h"
+#include "BattleSimulator.h"
+#include "PythonSkillLoader.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <functional>
+
+const int Tournament::kBattlesPerTask;
+
+// Constructor: keep pristine copies of all entrants
+Tournament::Tournament(const std::vector<Pokemon>& entrants, int repetitions, uint64_t seed)
+    : entrants(entrants), repetitions(repetitions), seed(seed) {
+}
+
+TournamentResult Tournament::run(unsigned threads) {
+    const size_t count = entrants.size();
+    const int chunksPerPair = (repetitions + kBattlesPerTask - 1) / kBattlesPerTask;
+    
+    TournamentResult result;
+    result.repetitions = repetitions;
+    for (const auto& entrant : entrants) {
+        result.names.push_back(entrant.getName());
+    }
+    result.wins.assign(count * count, 0);
+    
+    // One slot per task; each task writes only its own slot
+    struct ChunkTask {
+        size_t attacker;
+        size_t defender;
+        int chunk;
+        int wins;
+    };
+    std::vector<ChunkTask> chunks;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < count; ++j) {
+            if (i == j) continue;
+            for (int c = 0; c < chunksPerPair; ++c) {
+                chunks.push_back({i, j, c, 0});
+            }
+        }
+    }
+    
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunks.size());
+    for (auto& chunk : chunks) {
+        ChunkTask* slot = &chunk;
+        tasks.push_back([this, slot, count]() {
+            int battles = std::min(kBattlesPerTask, repetitions - slot->chunk * kBattlesPerTask);
+            uint64_t pairSeed = BattleRng::deriveSeed(seed, slot->attacker * count + slot->defender);
+            uint64_t chunkSeed = BattleRng::deriveSeed(pairSeed, static_cast<uint64_t>(slot->chunk));
+            
+            BattleSimulator simulator(entrants[slot->attacker], entrants[slot->defender]);
+            std::unique_ptr<DecisionPolicy> policies[2];
+            if (policyFactory) {
+                policies[0] = policyFactory();
+                policies[1] = policyFactory();
+                simulator.setPolicies(policies[0].get(), policies[1].get());
+            }
+            slot->wins = simulator.run(battles, chunkSeed).wins[0];
+        });
+    }
+    
+    WorkStealingPool pool(threads);
+    if (pool.getThreadCount() > 1) {
+        // Python skills on each worker run in the worker's own interpreter
+        // where the Python version allows it (no-op otherwise)
+        pool.setWorkerScope([](const std::function<void()>& loop) {
+            PythonSkillLoader::ThreadContext python;
+            loop();
+        });
+    }
+    pool.run(std::move(tasks));
+    
+    for (const auto& chunk : chunks) {
+        result.wins[chunk.attacker * count + chunk.defender] += chunk.wins;
+    }
+    
+    return result;
+}
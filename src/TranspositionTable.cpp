@@ -0,0 +1,52 @@
+#include "TranspositionTable.h"
+#include "BattleRng.h"
+
+TranspositionTable::TranspositionTable(size_t capacity)
+    : mask(0), hits(0), used(0) {
+    size_t slots = 1;
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+    entries.resize(slots);
+    mask = slots - 1;
+}
+
+uint64_t TranspositionTable::key(const PokemonState& first, const PokemonState& second, int actor) {
+    // HP in the high half, status and duration below it
+    auto pack = [](const PokemonState& state) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(state.currentHP)) << 32) |
+               (static_cast<uint64_t>(state.statusEffect) << 24) |
+               static_cast<uint32_t>(state.statusDuration & 0xFFFFFF);
+    };
+    uint64_t hash = BattleRng::deriveSeed(BattleRng::deriveSeed(static_cast<uint64_t>(actor), pack(first)), pack(second));
+    return hash != 0 ? hash : 1;
+}
+
+bool TranspositionTable::find(uint64_t key, int depth, double& value) {
+    const Entry& entry = entries[key & mask];
+    if (entry.key != key || entry.depth < depth) {
+        return false;
+    }
+    hits++;
+    value = entry.value;
+    return true;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, double value) {
+    Entry& entry = entries[key & mask];
+    if (entry.key != 0 && entry.key != key && entry.depth > depth) {
+        return;
+    }
+    if (entry.key == 0) {
+        used++;
+    }
+    entry.key = key;
+    entry.depth = depth;
+    entry.value = value;
+}
+
+void TranspositionTable::clear() {
+    entries.assign(entries.size(), Entry());
+    hits = 0;
+    used = 0;
+}
@@ -1,13 +1,16 @@
 #include "TypeEffectiveness.h"
-#include <iostream>
+#include <stdexcept>
 
-// Static member initialization
-std::map<std::pair<std::string, std::string>, double> TypeEffectiveness::effectivenessChart;
-bool TypeEffectiveness::initialized = false;
+// Display names, in PokemonType order
+static const char* const kTypeNames[TypeEffectiveness::kTypeCount] = {
+    "Normal", "Fire", "Water", "Electric", "Grass", "Ice",
+    "Fighting", "Poison", "Ground", "Flying", "Psychic", "Bug",
+    "Rock", "Ghost", "Dragon", "Dark", "Steel", "Fairy"
+};
 
 /**
- * Initialize the type effectiveness chart
- * This function populates the map with all type matchup multipliers
+ * Build the type effectiveness chart
+ * Every matchup starts neutral; the entries below override it
  * 
  * Multipliers:
  * - 2.0: Super effective (attacker has advantage)
@@ -15,121 +18,149 @@ bool TypeEffectiveness::initialized = false;
  * - 0.5: Not very effective (attacker has disadvantage)
  * - 0.0: No effect (attacker is completely ineffective)
  */
-void TypeEffectiveness::initializeChart() {
-    // Only initialize once
-    if (initialized) return;
+constexpr TypeEffectiveness::Chart TypeEffectiveness::buildChart() {
+    Chart c{};
+    for (int attack = 0; attack < kTypeCount; ++attack) {
+        for (int defense = 0; defense < kTypeCount; ++defense) {
+            c.multipliers[attack][defense] = 1.0;
+        }
+    }
+    
+    using T = PokemonType;
+    auto& m = c.multipliers;
+#define SET(attack, defense, value) m[static_cast<int>(T::attack)][static_cast<int>(T::defense)] = value
     
     // Fire type effectiveness
-    effectivenessChart[{"Fire", "Water"}] = 0.5;      // Fire vs Water: Not very effective
-    effectivenessChart[{"Fire", "Grass"}] = 2.0;      // Fire vs Grass: Super effective
-    effectivenessChart[{"Fire", "Fire"}] = 0.5;       // Fire vs Fire: Not very effective
-    effectivenessChart[{"Fire", "Ice"}] = 2.0;        // Fire vs Ice: Super effective
-    effectivenessChart[{"Fire", "Bug"}] = 2.0;        // Fire vs Bug: Super effective
-    effectivenessChart[{"Fire", "Rock"}] = 0.5;       // Fire vs Rock: Not very effective
+    SET(FIRE, WATER, 0.5);          // Fire vs Water: Not very effective
+    SET(FIRE, GRASS, 2.0);          // Fire vs Grass: Super effective
+    SET(FIRE, FIRE, 0.5);           // Fire vs Fire: Not very effective
+    SET(FIRE, ICE, 2.0);            // Fire vs Ice: Super effective
+    SET(FIRE, BUG, 2.0);            // Fire vs Bug: Super effective
+    SET(FIRE, ROCK, 0.5);           // Fire vs Rock: Not very effective
     
     // Water type effectiveness
-    effectivenessChart[{"Water", "Fire"}] = 2.0;      // Water vs Fire: Super effective
-    effectivenessChart[{"Water", "Water"}] = 0.5;     // Water vs Water: Not very effective
-    effectivenessChart[{"Water", "Grass"}] = 0.5;     // Water vs Grass: Not very effective
-    effectivenessChart[{"Water", "Ground"}] = 2.0;    // Water vs Ground: Super effective
-    effectivenessChart[{"Water", "Rock"}] = 2.0;      // Water vs Rock: Super effective
+    SET(WATER, FIRE, 2.0);          // Water vs Fire: Super effective
+    SET(WATER, WATER, 0.5);         // Water vs Water: Not very effective
+    SET(WATER, GRASS, 0.5);         // Water vs Grass: Not very effective
+    SET(WATER, GROUND, 2.0);        // Water vs Ground: Super effective
+    SET(WATER, ROCK, 2.0);          // Water vs Rock: Super effective
     
     // Grass type effectiveness
-    effectivenessChart[{"Grass", "Water"}] = 2.0;     // Grass vs Water: Super effective
-    effectivenessChart[{"Grass", "Ground"}] = 2.0;    // Grass vs Ground: Super effective
-    effectivenessChart[{"Grass", "Rock"}] = 2.0;      // Grass vs Rock: Super effective
-    effectivenessChart[{"Grass", "Fire"}] = 0.5;      // Grass vs Fire: Not very effective
-    effectivenessChart[{"Grass", "Grass"}] = 0.5;     // Grass vs Grass: Not very effective
-    effectivenessChart[{"Grass", "Flying"}] = 0.5;    // Grass vs Flying: Not very effective
-    effectivenessChart[{"Grass", "Bug"}] = 0.5;       // Grass vs Bug: Not very effective
+    SET(GRASS, WATER, 2.0);         // Grass vs Water: Super effective
+    SET(GRASS, GROUND, 2.0);        // Grass vs Ground: Super effective
+    SET(GRASS, ROCK, 2.0);          // Grass vs Rock: Super effective
+    SET(GRASS, FIRE, 0.5);          // Grass vs Fire: Not very effective
+    SET(GRASS, GRASS, 0.5);         // Grass vs Grass: Not very effective
+    SET(GRASS, FLYING, 0.5);        // Grass vs Flying: Not very effective
+    SET(GRASS, BUG, 0.5);           // Grass vs Bug: Not very effective
     
     // Electric type effectiveness
-    effectivenessChart[{"Electric", "Water"}] = 2.0;  // Electric vs Water: Super effective
-    effectivenessChart[{"Electric", "Flying"}] = 2.0; // Electric vs Flying: Super effective
-    effectivenessChart[{"Electric", "Electric"}] = 0.5; // Electric vs Electric: Not very effective
-    effectivenessChart[{"Electric", "Grass"}] = 0.5;  // Electric vs Grass: Not very effective
-    effectivenessChart[{"Electric", "Ground"}] = 0.0; // Electric vs Ground: No effect
+    SET(ELECTRIC, WATER, 2.0);      // Electric vs Water: Super effective
+    SET(ELECTRIC, FLYING, 2.0);     // Electric vs Flying: Super effective
+    SET(ELECTRIC, ELECTRIC, 0.5);   // Electric vs Electric: Not very effective
+    SET(ELECTRIC, GRASS, 0.5);      // Electric vs Grass: Not very effective
+    SET(ELECTRIC, GROUND, 0.0);     // Electric vs Ground: No effect
     
     // Ice type effectiveness
-    effectivenessChart[{"Ice", "Grass"}] = 2.0;       // Ice vs Grass: Super effective
-    effectivenessChart[{"Ice", "Ground"}] = 2.0;      // Ice vs Ground: Super effective
-    effectivenessChart[{"Ice", "Flying"}] = 2.0;      // Ice vs Flying: Super effective
-    effectivenessChart[{"Ice", "Dragon"}] = 2.0;      // Ice vs Dragon: Super effective
-    effectivenessChart[{"Ice", "Fire"}] = 0.5;        // Ice vs Fire: Not very effective
-    effectivenessChart[{"Ice", "Water"}] = 0.5;       // Ice vs Water: Not very effective
-    effectivenessChart[{"Ice", "Ice"}] = 0.5;         // Ice vs Ice: Not very effective
+    SET(ICE, GRASS, 2.0);           // Ice vs Grass: Super effective
+    SET(ICE, GROUND, 2.0);          // Ice vs Ground: Super effective
+    SET(ICE, FLYING, 2.0);          // Ice vs Flying: Super effective
+    SET(ICE, DRAGON, 2.0);          // Ice vs Dragon: Super effective
+    SET(ICE, FIRE, 0.5);            // Ice vs Fire: Not very effective
+    SET(ICE, WATER, 0.5);           // Ice vs Water: Not very effective
+    SET(ICE, ICE, 0.5);             // Ice vs Ice: Not very effective
     
     // Fighting type effectiveness
-    effectivenessChart[{"Fighting", "Normal"}] = 2.0; // Fighting vs Normal: Super effective
-    effectivenessChart[{"Fighting", "Ice"}] = 2.0;    // Fighting vs Ice: Super effective
-    effectivenessChart[{"Fighting", "Rock"}] = 2.0;   // Fighting vs Rock: Super effective
-    effectivenessChart[{"Fighting", "Flying"}] = 0.5; // Fighting vs Flying: Not very effective
-    effectivenessChart[{"Fighting", "Psychic"}] = 0.5; // Fighting vs Psychic: Not very effective
+    SET(FIGHTING, NORMAL, 2.0);     // Fighting vs Normal: Super effective
+    SET(FIGHTING, ICE, 2.0);        // Fighting vs Ice: Super effective
+    SET(FIGHTING, ROCK, 2.0);       // Fighting vs Rock: Super effective
+    SET(FIGHTING, FLYING, 0.5);     // Fighting vs Flying: Not very effective
+    SET(FIGHTING, PSYCHIC, 0.5);    // Fighting vs Psychic: Not very effective
     
     // Ground type effectiveness
-    effectivenessChart[{"Ground", "Fire"}] = 2.0;     // Ground vs Fire: Super effective
-    effectivenessChart[{"Ground", "Electric"}] = 2.0; // Ground vs Electric: Super effective
-    effectivenessChart[{"Ground", "Rock"}] = 2.0;     // Ground vs Rock: Super effective
-    effectivenessChart[{"Ground", "Grass"}] = 0.5;    // Ground vs Grass: Not very effective
-    effectivenessChart[{"Ground", "Bug"}] = 0.5;      // Ground vs Bug: Not very effective
-    effectivenessChart[{"Ground", "Flying"}] = 0.0;   // Ground vs Flying: No effect
+    SET(GROUND, FIRE, 2.0);         // Ground vs Fire: Super effective
+    SET(GROUND, ELECTRIC, 2.0);     // Ground vs Electric: Super effective
+    SET(GROUND, ROCK, 2.0);         // Ground vs Rock: Super effective
+    SET(GROUND, GRASS, 0.5);        // Ground vs Grass: Not very effective
+    SET(GROUND, BUG, 0.5);          // Ground vs Bug: Not very effective
+    SET(GROUND, FLYING, 0.0);       // Ground vs Flying: No effect
     
     // Flying type effectiveness
-    effectivenessChart[{"Flying", "Grass"}] = 2.0;    // Flying vs Grass: Super effective
-    effectivenessChart[{"Flying", "Fighting"}] = 2.0; // Flying vs Fighting: Super effective
-    effectivenessChart[{"Flying", "Bug"}] = 2.0;      // Flying vs Bug: Super effective
-    effectivenessChart[{"Flying", "Electric"}] = 0.5; // Flying vs Electric: Not very effective
-    effectivenessChart[{"Flying", "Rock"}] = 0.5;     // Flying vs Rock: Not very effective
+    SET(FLYING, GRASS, 2.0);        // Flying vs Grass: Super effective
+    SET(FLYING, FIGHTING, 2.0);     // Flying vs Fighting: Super effective
+    SET(FLYING, BUG, 2.0);          // Flying vs Bug: Super effective
+    SET(FLYING, ELECTRIC, 0.5);     // Flying vs Electric: Not very effective
+    SET(FLYING, ROCK, 0.5);         // Flying vs Rock: Not very effective
     
     // Rock type effectiveness
-    effectivenessChart[{"Rock", "Fire"}] = 2.0;       // Rock vs Fire: Super effective
-    effectivenessChart[{"Rock", "Ice"}] = 2.0;        // Rock vs Ice: Super effective
-    effectivenessChart[{"Rock", "Flying"}] = 2.0;     // Rock vs Flying: Super effective
-    effectivenessChart[{"Rock", "Bug"}] = 2.0;        // Rock vs Bug: Super effective
-    effectivenessChart[{"Rock", "Fighting"}] = 0.5;   // Rock vs Fighting: Not very effective
-    effectivenessChart[{"Rock", "Ground"}] = 0.5;     // Rock vs Ground: Not very effective
+    SET(ROCK, FIRE, 2.0);           // Rock vs Fire: Super effective
+    SET(ROCK, ICE, 2.0);            // Rock vs Ice: Super effective
+    SET(ROCK, FLYING, 2.0);         // Rock vs Flying: Super effective
+    SET(ROCK, BUG, 2.0);            // Rock vs Bug: Super effective
+    SET(ROCK, FIGHTING, 0.5);       // Rock vs Fighting: Not very effective
+    SET(ROCK, GROUND, 0.5);         // Rock vs Ground: Not very effective
     
     // Bug type effectiveness
-    effectivenessChart[{"Bug", "Grass"}] = 2.0;       // Bug vs Grass: Super effective
-    effectivenessChart[{"Bug", "Psychic"}] = 2.0;     // Bug vs Psychic: Super effective
-    effectivenessChart[{"Bug", "Fire"}] = 0.5;        // Bug vs Fire: Not very effective
-    effectivenessChart[{"Bug", "Fighting"}] = 0.5;    // Bug vs Fighting: Not very effective
-    effectivenessChart[{"Bug", "Flying"}] = 0.5;      // Bug vs Flying: Not very effective
+    SET(BUG, GRASS, 2.0);           // Bug vs Grass: Super effective
+    SET(BUG, PSYCHIC, 2.0);         // Bug vs Psychic: Super effective
+    SET(BUG, FIRE, 0.5);            // Bug vs Fire: Not very effective
+    SET(BUG, FIGHTING, 0.5);        // Bug vs Fighting: Not very effective
+    SET(BUG, FLYING, 0.5);          // Bug vs Flying: Not very effective
     
     // Psychic type effectiveness
-    effectivenessChart[{"Psychic", "Fighting"}] = 2.0; // Psychic vs Fighting: Super effective
-    effectivenessChart[{"Psychic", "Psychic"}] = 0.5;  // Psychic vs Psychic: Not very effective
+    SET(PSYCHIC, FIGHTING, 2.0);    // Psychic vs Fighting: Super effective
+    SET(PSYCHIC, PSYCHIC, 0.5);     // Psychic vs Psychic: Not very effective
     
     // Dragon type effectiveness
-    effectivenessChart[{"Dragon", "Dragon"}] = 2.0;    // Dragon vs Dragon: Super effective
+    SET(DRAGON, DRAGON, 2.0);       // Dragon vs Dragon: Super effective
+    
+    // Normal type attacks are always neutral (1.0x) against all types
     
-    // Mark as initialized
-    initialized = true;
+#undef SET
+    return c;
 }
 
+// Static member initialization (constant-initialized at compile time)
+constexpr TypeEffectiveness::Chart TypeEffectiveness::chart = TypeEffectiveness::buildChart();
+
 /**
- * Get the type effectiveness multiplier for an attack
+ * Get the type effectiveness multiplier for an attack by type name
  * 
  * @param attackType Type of the attacking move
  * @param defenseType Type of the defending Pokemon
  * @return Effectiveness multiplier (2.0, 1.0, 0.5, or 0.0)
  */
 double TypeEffectiveness::getEffectiveness(const std::string& attackType, const std::string& defenseType) {
-    // Ensure chart is initialized
-    initializeChart();
-    
-    // Normal type attacks are always neutral (1.0x) against all types
-    if (attackType == "Normal") return 1.0;
-    
-    // Look up the matchup in the chart
-    auto key = std::make_pair(attackType, defenseType);
-    auto it = effectivenessChart.find(key);
+    PokemonType attack;
+    PokemonType defense;
     
-    if (it != effectivenessChart.end()) {
-        // Found a specific matchup
-        return it->second;
+    // Default to normal effectiveness (1.0x) for unknown types
+    if (!tryParseType(attackType, attack) || !tryParseType(defenseType, defense)) {
+        return 1.0;
     }
     
-    // Default to normal effectiveness (1.0x) if no specific matchup exists
-    return 1.0;
+    return getEffectiveness(attack, defense);
+}
+
+bool TypeEffectiveness::tryParseType(const std::string& name, PokemonType& type) {
+    for (int i = 0; i < kTypeCount; ++i) {
+        if (name == kTypeNames[i]) {
+            type = static_cast<PokemonType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+PokemonType TypeEffectiveness::parseType(const std::string& name) {
+    PokemonType type;
+    if (!tryParseType(name, type)) {
+        throw std::invalid_argument("Unknown Pokemon type: " + name);
+    }
+    return type;
+}
+
+const char* TypeEffectiveness::typeName(PokemonType type) {
+    int index = static_cast<int>(type);
+    return (index >= 0 && index < kTypeCount) ? kTypeNames[index] : "???";
 }
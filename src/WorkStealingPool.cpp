@@ -0,0 +1,88 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+// Constructor: one queue per worker
+WorkStealingPool::WorkStealingPool(unsigned threads)
+    : threadCount(threads) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.emplace_back(new WorkerQueue());
+    }
+}
+
+// Own queue is used LIFO, victims are robbed FIFO to reduce contention
+bool WorkStealingPool::takeTask(unsigned worker, std::function<void()>& task) {
+    {
+        WorkerQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    
+    for (unsigned offset = 1; offset < threadCount; ++offset) {
+        WorkerQueue& victim = *queues[(worker + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned worker) {
+    std::function<void()> task;
+    while (takeTask(worker, task)) {
+        task();
+    }
+}
+
+void WorkStealingPool::run(std::vector<std::function<void()>> tasks) {
+    // All tasks are known up front, so a worker that finds every queue
+    // empty can exit: no new work will appear later
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        queues[i % threadCount]->tasks.push_back(std::move(tasks[i]));
+    }
+    
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+    auto guardedLoop = [&](unsigned worker) {
+        try {
+            if (workerScope) {
+                workerScope([this, worker]() { workerLoop(worker); });
+            } else {
+                workerLoop(worker);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!firstError) firstError = std::current_exception();
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (unsigned worker = 1; worker < threadCount; ++worker) {
+        threads.emplace_back(guardedLoop, worker);
+    }
+    guardedLoop(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    // Workers that threw stop early; if all of them did, drop leftover tasks
+    for (auto& queue : queues) {
+        queue->tasks.clear();
+    }
+    
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
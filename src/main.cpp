@@ -1,29 +1,692 @@
 #include "Pokemon.h"
 #include "Move.h"
+#include "NativeSkill.h"
 #include "Battle.h"
+#include "BattleArena.h"
+#include "BattleSimulator.h"
+#include "DamageTable.h"
+#include "ExpectimaxPolicy.h"
+#include "GameData.h"
+#include "Instrumentation.h"
+#include "MatchupSolver.h"
+#include "MoveRegistry.h"
 #include "PythonSkillLoader.h"
+#include "ReplayLog.h"
+#include "TeamBattle.h"
+#include "TextEventSink.h"
+#include "Tournament.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <iomanip>
+#include <map>
 #include <memory>
 #include <cstdlib>
 #include <ctime>
+#include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
-void loadPythonSkill(std::shared_ptr<Move> move, const std::string& scriptName) {
-    try {
-        auto skillFunc = PythonSkillLoader::loadSkill(scriptName, "calculate_damage");
-        move->setEffectFunction(skillFunc);
-        std::cout << "✓ Loaded " << move->getName() << " skill from Python script." << std::endl;
-    } catch (const std::exception& e) {
-        std::cout << "✓ Using default effect for " << move->getName() << "." << std::endl;
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--simulate N | --tournament N | --teams N | --solve] [--threads T] [--seed S] [--record FILE]"
+              << " [--ai D [--ai-time MS]] [--native-only] [--timings]"
+              << " [--precompile] [--instrument table|json]" << std::endl;
+    std::cerr << "       " << program << " --replay FILE [--battle B] [--turn K] [--rerun]" << std::endl;
+    std::cerr << "  --simulate N     Run N silent battles of every matchup and print statistics" << std::endl;
+    std::cerr << "  --solve          Compute the exact win probabilities of every matchup (random moves)" << std::endl;
+    std::cerr << "  --tournament N   Round-robin of all Pokemon, N battles per pairing, win-rate matrix" << std::endl;
+    std::cerr << "  --teams N        Run N silent team battles of the whole roster (switching allowed)" << std::endl;
+    std::cerr << "  --threads T      Worker threads for --tournament (default: all cores)" << std::endl;
+    std::cerr << "  --seed S         Base seed (default: current time)" << std::endl;
+    std::cerr << "  --record FILE    Append the battle (or every --simulate battle) to a replay log" << std::endl;
+    std::cerr << "  --replay FILE    Stream a battle back from a replay log" << std::endl;
+    std::cerr << "  --battle B       Battle number in the log (default: 0)" << std::endl;
+    std::cerr << "  --turn K         Start streaming at turn K (default: 1)" << std::endl;
+    std::cerr << "  --rerun          Re-execute the battle from its seed and check it against the log" << std::endl;
+    std::cerr << "  --verify-native N  Check native skills against their Python scripts, N draws per matchup" << std::endl;
+    std::cerr << "  --precompile     Draw damage of PRECOMPILE scripts from tables built for the roster" << std::endl;
+    std::cerr << "  --verify-tables N  Check precompiled damage tables against their Python scripts, N draws per matchup" << std::endl;
+    std::cerr << "  --ai D           Pick moves by expectimax search D actions deep instead of at random" << std::endl;
+    std::cerr << "  --ai-time MS     Stop each search after MS milliseconds (results then depend on timing)" << std::endl;
+    std::cerr << "  --native-only    Never start Python: scripted moves use their native skill or the built-in formula" << std::endl;
+    std::cerr << "  --timings        Print how long each startup phase took (on stderr)" << std::endl;
+    std::cerr << "  --instrument F   Print hot-path counters as a table or JSON (on stderr; needs -DPOKEMON_INSTRUMENT=ON)" << std::endl;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+// Move choice for --ai: an expectimax search, or nullptr for random moves
+std::unique_ptr<DecisionPolicy> makePolicy(int aiDepth, double aiTime) {
+    if (aiDepth <= 0) return nullptr;
+    return std::unique_ptr<DecisionPolicy>(new ExpectimaxPolicy(aiDepth, 4, aiTime / 1000.0));
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Startup report for --timings, on stderr so it never mixes with battle output.
+// Python is started on demand, so its initialization is part of the phase
+// that first needed it.
+void printTimings(const std::vector<std::pair<std::string, double>>& phases, double total) {
+    std::cerr << "\nStartup timings:" << std::endl;
+    std::cerr << std::fixed << std::setprecision(2);
+    for (const auto& phase : phases) {
+        std::cerr << "  " << std::left << std::setw(20) << phase.first << std::right
+                  << std::setw(10) << phase.second * 1000 << " ms" << std::endl;
+    }
+    std::cerr << "  " << std::left << std::setw(20) << "Python init" << std::right;
+    if (!PythonSkillLoader::isPythonEnabled()) {
+        std::cerr << std::setw(13) << "-" << "  (disabled)" << std::endl;
+    } else if (PythonSkillLoader::getInitializationTime() == 0.0) {
+        std::cerr << std::setw(13) << "-" << "  (not needed)" << std::endl;
+    } else {
+        std::cerr << std::setw(10) << PythonSkillLoader::getInitializationTime() * 1000
+                  << " ms  (on first use, included above)" << std::endl;
+    }
+    std::cerr << "  " << std::left << std::setw(20) << "Total" << std::right
+              << std::setw(10) << total * 1000 << " ms" << std::endl;
+    std::cerr.unsetf(std::ios::floatfield);
+}
+
+// Run N headless battles of each matchup and print aggregate statistics
+void runSimulations(const std::vector<std::pair<Pokemon*, Pokemon*>>& battles,
+                    int battleCount, uint64_t seed, ReplayLogWriter* log, int aiDepth, double aiTime) {
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    
+    std::cout << "Simulating " << battleCount << " battles per matchup..." << std::endl;
+    
+    for (const auto& matchup : battles) {
+        BattleSimulator simulator(*matchup.first, *matchup.second);
+        std::unique_ptr<DecisionPolicy> policy1 = makePolicy(aiDepth, aiTime);
+        std::unique_ptr<DecisionPolicy> policy2 = makePolicy(aiDepth, aiTime);
+        simulator.setPolicies(policy1.get(), policy2.get());
+        SimulationResult result = simulator.run(battleCount, seed, log);
+        
+        std::cout << "\n" << matchup.first->getName() << " vs " << matchup.second->getName() << std::endl;
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "  Win rate:     " << matchup.first->getName() << " " << result.winRate(0) * 100 << "%, "
+                  << matchup.second->getName() << " " << result.winRate(1) * 100 << "%" << std::endl;
+        std::cout << "  Avg turns:    " << std::setprecision(2) << result.averageTurns() << std::endl;
+        std::cout << "  Avg HP left:  " << std::setprecision(1)
+                  << matchup.first->getName() << " " << result.averageRemainingHP[0] << "/" << matchup.first->getMaxHP() << ", "
+                  << matchup.second->getName() << " " << result.averageRemainingHP[1] << "/" << matchup.second->getMaxHP() << std::endl;
+        std::cout << "  Turn histogram:" << std::endl;
+        for (size_t turns = 0; turns < result.turnHistogram.size(); ++turns) {
+            if (result.turnHistogram[turns] == 0) continue;
+            std::cout << "    " << std::setw(3) << turns << " turns: " << result.turnHistogram[turns] << std::endl;
+        }
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    
+    PythonSkillLoader::setScriptOutputEnabled(true);
+}
+
+// Solve each matchup exactly and print its win probabilities
+int runSolver(const std::vector<std::pair<Pokemon*, Pokemon*>>& battles) {
+    std::cout << "Solving every matchup exactly (random moves)..." << std::endl;
+    
+    int status = 0;
+    for (const auto& matchup : battles) {
+        std::cout << "\n" << matchup.first->getName() << " vs " << matchup.second->getName() << std::endl;
+        try {
+            MatchupSolver solver(*matchup.first, *matchup.second);
+            SolverResult result = solver.solve();
+            std::cout << std::fixed << std::setprecision(2);
+            std::cout << "  Win probability: " << matchup.first->getName() << " " << result.winRate(0) * 100 << "%, "
+                      << matchup.second->getName() << " " << result.winRate(1) * 100 << "%" << std::endl;
+            std::cout << "  Expected turns:  " << result.expectedTurns << std::endl;
+            std::cout << "  States:          " << result.states << " (largest cycle " << result.largestCycle << ")" << std::endl;
+            std::cout.unsetf(std::ios::floatfield);
+        } catch (const std::exception& e) {
+            std::cout << "  Cannot solve: " << e.what() << std::endl;
+            status = 1;
+        }
+    }
+    return status;
+}
+
+// Play a multi-threaded round-robin and print the win-rate matrix
+void runTournament(const std::vector<Pokemon>& roster, int repetitions,
+                   unsigned threads, uint64_t seed, int aiDepth, double aiTime) {
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    
+    Tournament tournament(roster, repetitions, seed);
+    if (aiDepth > 0) {
+        tournament.setPolicyFactory([aiDepth, aiTime]() { return makePolicy(aiDepth, aiTime); });
+    }
+    TournamentResult result = tournament.run(threads);
+    
+    std::cout << "Round-robin: " << repetitions << " battles per pairing (seed " << seed << ")" << std::endl;
+    std::cout << "Win rate of row Pokemon (moving first in the pairing) vs column Pokemon:\n" << std::endl;
+    
+    std::cout << std::setw(12) << "";
+    for (const auto& name : result.names) {
+        std::cout << std::setw(12) << name;
+    }
+    std::cout << std::endl;
+    
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < result.names.size(); ++i) {
+        std::cout << std::setw(12) << result.names[i];
+        for (size_t j = 0; j < result.names.size(); ++j) {
+            if (i == j) {
+                std::cout << std::setw(12) << "-";
+            } else {
+                std::cout << std::setw(11) << result.winRate(i, j) * 100 << "%";
+            }
+        }
+        std::cout << std::endl;
     }
+    std::cout.unsetf(std::ios::floatfield);
+    
+    PythonSkillLoader::setScriptOutputEnabled(true);
 }
 
-int main() {
-    // Seed random number generator
-    srand(static_cast<unsigned int>(time(nullptr)));
+// Play N headless team battles: the whole roster against itself in reverse
+// order, switching at random 10% of the time (without --ai)
+void runTeamBattles(const std::vector<Pokemon>& roster, int battleCount,
+                    uint64_t seed, int aiDepth, double aiTime) {
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    
+    BattleArena arena(2 * roster.size());
+    Team teams[2];
+    for (size_t i = 0; i < roster.size() && i < Team::kMaxSize; ++i) {
+        teams[0].add(arena.add(roster[i]));
+    }
+    for (size_t i = 0; i < teams[0].size(); ++i) {
+        teams[1].add(arena.add(teams[0].get(teams[0].size() - 1 - i)));
+    }
+    
+    std::unique_ptr<DecisionPolicy> policy1 = makePolicy(aiDepth, aiTime);
+    std::unique_ptr<DecisionPolicy> policy2 = makePolicy(aiDepth, aiTime);
+    NullEventSink events;
+    long long wins[2] = {0, 0};
+    long long turns = 0;
+    long long switches = 0;
+    for (int i = 0; i < battleCount; ++i) {
+        arena.restore();
+        TeamBattle battle(teams[0], teams[1], BattleRng::deriveSeed(seed, static_cast<uint64_t>(i)), events);
+        battle.setPolicies(policy1.get(), policy2.get());
+        battle.setSwitchChance(10);
+        wins[battle.start()]++;
+        turns += battle.getTurnCount();
+        switches += battle.getSwitchCount();
+    }
     
-    // Initialize Python interpreter
-    PythonSkillLoader::initialize();
+    std::cout << "Team battles: " << battleCount << " battles, " << teams[0].size() << "v" << teams[1].size()
+              << " (seed " << seed << ")" << std::endl;
+    for (int side = 0; side < 2; ++side) {
+        std::cout << "  Team " << side + 1 << ":";
+        for (size_t slot = 0; slot < teams[side].size(); ++slot) {
+            std::cout << (slot == 0 ? " " : ", ") << teams[side].get(slot).getName();
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Win rate:       Team 1 " << 100.0 * wins[0] / battleCount << "%, Team 2 "
+              << 100.0 * wins[1] / battleCount << "%" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "  Avg turns:      " << static_cast<double>(turns) / battleCount << std::endl;
+    std::cout << "  Avg switches:   " << static_cast<double>(switches) / battleCount << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    
+    PythonSkillLoader::setScriptOutputEnabled(true);
+}
+
+// Two-sample chi-square over the union of observed damage values, with the
+// Wilson-Hilferty approximation of its 99.9% quantile (z = 3.09)
+struct ChiSquareTest {
+    double value = 0.0;
+    int degrees = 1;
+    double limit = 0.0;
+};
+
+ChiSquareTest compareHistograms(const std::map<int, long long>& first, const std::map<int, long long>& second) {
+    std::map<int, long long> bins = first;
+    for (const auto& bin : second) bins[bin.first] += 0;
+    ChiSquareTest test;
+    for (const auto& bin : bins) {
+        auto a = first.find(bin.first);
+        auto b = second.find(bin.first);
+        double r = a != first.end() ? static_cast<double>(a->second) : 0.0;
+        double n = b != second.end() ? static_cast<double>(b->second) : 0.0;
+        test.value += (r - n) * (r - n) / (r + n);
+    }
+    test.degrees = std::max(1, static_cast<int>(bins.size()) - 1);
+    double h = 2.0 / (9.0 * test.degrees);
+    test.limit = test.degrees * std::pow(1.0 - h + 3.09 * std::sqrt(h), 3);
+    return test;
+}
+
+// Compare every native skill with its Python script over all roster matchups.
+// Same seed: both paths must return the same damage and consume the same
+// draws. Independent seeds: a two-sample chi-square test on the damage
+// histograms must not reject equal distributions at p = 0.001.
+int runNativeVerification(const std::vector<Pokemon>& roster, int draws, uint64_t seed) {
+    const char* scripts[] = {"thunderbolt", "water_gun", "flamethrower", "slash", "eruption", "electro_ball"};
+    
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    std::cout << "Verifying native skills against Python (" << draws << " draws per matchup, seed " << seed << ")" << std::endl;
+    
+    bool allPassed = true;
+    for (const char* script : scripts) {
+        NativeSkillSpec spec;
+        if (!PythonSkillLoader::findNativeSkill(script, spec)) {
+            std::cout << "  " << std::left << std::setw(14) << script << std::right << "no native implementation" << std::endl;
+            continue;
+        }
+        
+        long long exact = 0;
+        long long total = 0;
+        std::map<int, long long> pythonHistogram;
+        std::map<int, long long> nativeHistogram;
+        uint64_t matchup = 0;
+        
+        for (const auto& attackerProto : roster) {
+            for (const auto& defender : roster) {
+                if (&attackerProto == &defender) continue;
+                // Full and half HP, so HP-dependent power curves are covered
+                for (int halfHP = 0; halfHP < 2; ++halfHP) {
+                    Pokemon attacker(attackerProto);
+                    Pokemon target(defender);
+                    attacker.takeDamage(halfHP * attacker.getMaxHP() / 2);
+                    uint64_t matchupSeed = BattleRng::deriveSeed(seed, matchup++);
+                    
+                    for (int i = 0; i < draws; ++i) {
+                        // Same stream for both paths
+                        BattleRng pythonRng(BattleRng::deriveSeed(matchupSeed, 2 * i));
+                        BattleRng nativeRng(BattleRng::deriveSeed(matchupSeed, 2 * i));
+                        int pythonDamage = PythonSkillLoader::executeSkill(script, "calculate_damage",
+                                                                           attacker, target, pythonRng);
+                        int nativeDamage = NativeSkill::calculateDamage(spec, attacker, target, nativeRng);
+                        BattleRng::State pythonState = pythonRng.getState();
+                        BattleRng::State nativeState = nativeRng.getState();
+                        if (pythonDamage == nativeDamage &&
+                            std::equal(pythonState.s, pythonState.s + 4, nativeState.s)) {
+                            exact++;
+                        }
+                        total++;
+                        
+                        // Independent stream for the native histogram
+                        BattleRng independentRng(BattleRng::deriveSeed(matchupSeed, 2 * i + 1));
+                        pythonHistogram[pythonDamage]++;
+                        nativeHistogram[NativeSkill::calculateDamage(spec, attacker, target, independentRng)]++;
+                    }
+                }
+            }
+        }
+        
+        ChiSquareTest test = compareHistograms(pythonHistogram, nativeHistogram);
+        bool passed = (exact == total) && (test.value <= test.limit);
+        allPassed = allPassed && passed;
+        std::cout << "  " << std::left << std::setw(14) << script << std::right
+                  << "exact " << exact << "/" << total << ", chi-square " << std::fixed << std::setprecision(1)
+                  << test.value << " (df " << test.degrees << ", limit " << test.limit << ")  "
+                  << (passed ? "✓" : "✗") << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    
+    PythonSkillLoader::setScriptOutputEnabled(true);
+    return allPassed ? 0 : 1;
+}
+
+// Build the roster's damage tables, then check each against live script
+// calls: every live result must be a table outcome, and the two damage
+// histograms must agree. Half-HP attackers catch scripts that wrongly
+// declare PRECOMPILE while depending on current HP.
+int runTableVerification(const std::vector<Pokemon>& roster, int draws, uint64_t seed) {
+    PythonSkillLoader::setScriptOutputEnabled(false);
+    
+    // A sampled table has its own sampling error; with many more samples
+    // than draws the chi-square test measures the table, not that error
+    int samples = std::max(4096, 16 * draws);
+    size_t tabulated = DamageTable::precompile(roster, samples, seed);
+    std::cout << "Verifying " << tabulated << " damage table(s) against Python (" << draws
+              << " draws per matchup, seed " << seed << ")" << std::endl;
+    
+    std::vector<MoveId> moves;
+    for (const auto& pokemon : roster) {
+        for (MoveId id : pokemon.getMoveIds()) {
+            if (MoveRegistry::get(id).getEffect() == MoveEffect::TABLE &&
+                std::find(moves.begin(), moves.end(), id) == moves.end()) {
+                moves.push_back(id);
+            }
+        }
+    }
+    
+    bool allPassed = true;
+    for (MoveId id : moves) {
+        const Move& move = MoveRegistry::get(id);
+        const DamageTable& table = *move.getDamageTable();
+        long long covered = 0;
+        long long total = 0;
+        std::map<int, long long> pythonHistogram;
+        std::map<int, long long> tableHistogram;
+        uint64_t matchup = 0;
+        
+        for (const auto& attackerProto : roster) {
+            for (const auto& defender : roster) {
+                if (&attackerProto == &defender) continue;
+                for (int halfHP = 0; halfHP < 2; ++halfHP) {
+                    Pokemon attacker(attackerProto);
+                    Pokemon target(defender);
+                    attacker.takeDamage(halfHP * attacker.getMaxHP() / 2);
+                    uint64_t matchupSeed = BattleRng::deriveSeed(seed, matchup++);
+                    DamageDistribution outcomes;
+                    table.distribution(attacker, target, outcomes);
+                    
+                    for (int i = 0; i < draws; ++i) {
+                        BattleRng pythonRng(BattleRng::deriveSeed(matchupSeed, 2 * i));
+                        BattleRng tableRng(BattleRng::deriveSeed(matchupSeed, 2 * i + 1));
+                        int pythonDamage = PythonSkillLoader::callScriptSkill(move.getScriptSkill(), attacker, target, pythonRng);
+                        int tableDamage = 0;
+                        table.draw(attacker, target, tableRng, tableDamage);
+                        
+                        bool inTable = std::any_of(outcomes.begin(), outcomes.end(),
+                            [pythonDamage](const std::pair<int, double>& outcome) { return outcome.first == pythonDamage; });
+                        if (inTable) covered++;
+                        total++;
+                        pythonHistogram[pythonDamage]++;
+                        tableHistogram[tableDamage]++;
+                    }
+                }
+            }
+        }
+        
+        ChiSquareTest test = compareHistograms(pythonHistogram, tableHistogram);
+        bool passed = (covered == total) && (test.value <= test.limit);
+        allPassed = allPassed && passed;
+        std::cout << "  " << std::left << std::setw(14) << move.getName() << std::right
+                  << "in table " << covered << "/" << total << ", chi-square " << std::fixed << std::setprecision(1)
+                  << test.value << " (df " << test.degrees << ", limit " << test.limit << "), "
+                  << table.getProfileCount() << " profiles, " << table.getOutcomeCount() << " outcomes"
+                  << (table.getSampledPairs() > 0 ? " (sampled)" : "") << "  "
+                  << (passed ? "✓" : "✗") << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    
+    PythonSkillLoader::setScriptOutputEnabled(true);
+    return allPassed ? 0 : 1;
+}
+
+// One line per recorded action, e.g. "Pikachu: Thunderbolt, 38 damage (2x)"
+void printReplayAction(const BattleReplay& replay, const ReplayAction& action) {
+    const ReplayPokemon& actor = replay.pokemon[action.actor];
+    std::cout << "  " << actor.name << ": ";
+    switch (action.outcome) {
+        case ReplayAction::NO_MOVES:
+            std::cout << "no moves";
+            break;
+        case ReplayAction::TURN_LOST:
+            std::cout << "lost the turn";
+            if (action.damage > 0) std::cout << ", " << action.damage << " self-damage";
+            break;
+        default:
+            std::cout << actor.moves[action.move];
+            if (action.outcome == ReplayAction::MISSED) {
+                std::cout << " missed";
+            } else if (action.damage > 0) {
+                std::cout << ", " << action.damage << " damage";
+                if (action.effectiveness != 4) std::cout << " (" << action.getEffectiveness() << "x)";
+            } else if (action.damage < 0) {
+                std::cout << ", restored " << -action.damage << " HP";
+            }
+            break;
+    }
+    std::cout << "  ->";
+    for (int side = 0; side < 2; ++side) {
+        std::cout << " " << replay.pokemon[side].name << " " << action.hp[side] << "/" << replay.pokemon[side].maxHP;
+        StatusEffect status = static_cast<StatusEffect>(action.status[side]);
+        if (status != StatusEffect::NONE) std::cout << " [" << StatusRules::name(status) << "]";
+    }
+    std::cout << std::endl;
+}
+
+// Stream a recorded battle from a turn, optionally re-executing it from its seed
+int runReplay(const std::string& path, size_t battleIndex, int fromTurn, bool rerun,
+              const std::vector<Pokemon>& roster, int aiDepth, double aiTime) {
+    ReplayLogReader log(path);
+    BattleReplay replay = log.readBattle(battleIndex);
+    
+    std::cout << "Replay log " << path << ": " << log.getBattleCount() << " battle(s)" << std::endl;
+    std::cout << "Battle " << battleIndex << ": " << replay.pokemon[0].name << " vs " << replay.pokemon[1].name
+              << " (seed " << replay.seed << "), " << replay.pokemon[replay.winner].name << " won in "
+              << replay.getTurnCount() << " turns" << std::endl;
+    
+    replay.seekTurn(fromTurn);  // Throws if the battle is shorter
+    for (int turn = fromTurn; turn <= replay.getTurnCount(); ++turn) {
+        size_t first = replay.seekTurn(turn);
+        size_t last = (turn < replay.getTurnCount()) ? replay.seekTurn(turn + 1) : replay.actions.size();
+        std::cout << "\n--- Turn " << turn << " --- (" << replay.pokemon[0].name << " " << replay.getHPAtTurn(turn, 0)
+                  << " HP, " << replay.pokemon[1].name << " " << replay.getHPAtTurn(turn, 1) << " HP)" << std::endl;
+        for (size_t i = first; i < last; ++i) {
+            printReplayAction(replay, replay.actions[i]);
+        }
+    }
+    
+    if (!rerun) return 0;
+    
+    // Re-execute with the current roster and compare action by action
+    const Pokemon* recorded[2] = {nullptr, nullptr};
+    for (int side = 0; side < 2; ++side) {
+        for (const auto& pokemon : roster) {
+            if (replay.pokemon[side].matches(pokemon)) {
+                recorded[side] = &pokemon;
+            }
+        }
+        if (!recorded[side]) {
+            std::cerr << "Cannot re-execute: " << replay.pokemon[side].name
+                      << " is not in the roster with the recorded stats and moves" << std::endl;
+            return 1;
+        }
+    }
+    
+    std::cout << "\nRe-executing from seed " << replay.seed << "..." << std::endl;
+    TextEventSink text(std::cout);
+    ReplayRecorder recorder(&text);
+    recorder.setSeed(replay.seed);
+    BattleArena sides(2);
+    Pokemon& side0 = sides.add(*recorded[0]);
+    Pokemon& side1 = sides.add(*recorded[1]);
+    std::unique_ptr<DecisionPolicy> policy1 = makePolicy(aiDepth, aiTime);
+    std::unique_ptr<DecisionPolicy> policy2 = makePolicy(aiDepth, aiTime);
+    Battle battle(side0, side1, replay.seed, recorder);
+    battle.setPolicies(policy1.get(), policy2.get());
+    battle.start();
+    
+    const BattleReplay& rerunReplay = recorder.getReplay();
+    size_t common = std::min(rerunReplay.actions.size(), replay.actions.size());
+    size_t divergence = common;
+    for (size_t i = 0; i < common; ++i) {
+        if (rerunReplay.actions[i] != replay.actions[i]) {
+            divergence = i;
+            break;
+        }
+    }
+    if (divergence == common && rerunReplay.actions.size() == replay.actions.size()) {
+        std::cout << "✓ Re-execution matches the log (" << replay.actions.size() << " actions)" << std::endl;
+        return 0;
+    }
+    std::cout << "✗ Re-execution diverges from the log at action " << divergence << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    Clock::time_point startTime = Clock::now();
+    
+    // Parse command line options
+    int simulateBattles = 0;
+    int tournamentBattles = 0;
+    int teamBattles = 0;
+    unsigned threads = 0;
+    uint64_t seed = static_cast<uint64_t>(time(nullptr));
+    std::string recordPath;
+    std::string replayPath;
+    size_t replayBattle = 0;
+    int replayTurn = 1;
+    bool rerun = false;
+    int verifyDraws = 0;
+    int verifyTableDraws = 0;
+    bool precompile = false;
+    int aiDepth = 0;
+    double aiTime = 0.0;
+    bool nativeOnly = false;
+    bool timings = false;
+    std::string instrument;
+    bool solve = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--simulate" && i + 1 < argc) {
+            simulateBattles = std::atoi(argv[++i]);
+            if (simulateBattles <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--solve") {
+            solve = true;
+        } else if (arg == "--tournament" && i + 1 < argc) {
+            tournamentBattles = std::atoi(argv[++i]);
+            if (tournamentBattles <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--teams" && i + 1 < argc) {
+            teamBattles = std::atoi(argv[++i]);
+            if (teamBattles <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--battle" && i + 1 < argc) {
+            replayBattle = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--turn" && i + 1 < argc) {
+            replayTurn = std::atoi(argv[++i]);
+            if (replayTurn <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--rerun") {
+            rerun = true;
+        } else if (arg == "--verify-native" && i + 1 < argc) {
+            verifyDraws = std::atoi(argv[++i]);
+            if (verifyDraws <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--verify-tables" && i + 1 < argc) {
+            verifyTableDraws = std::atoi(argv[++i]);
+            if (verifyTableDraws <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--precompile") {
+            precompile = true;
+        } else if (arg == "--ai" && i + 1 < argc) {
+            aiDepth = std::atoi(argv[++i]);
+            if (aiDepth <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--ai-time" && i + 1 < argc) {
+            aiTime = std::atof(argv[++i]);
+            if (aiTime <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--native-only") {
+            nativeOnly = true;
+        } else if (arg == "--timings") {
+            timings = true;
+        } else if (arg == "--instrument" && i + 1 < argc) {
+            instrument = argv[++i];
+            if (instrument != "table" && instrument != "json") {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (nativeOnly && (verifyDraws > 0 || verifyTableDraws > 0)) {
+        std::cerr << (verifyDraws > 0 ? "--verify-native" : "--verify-tables") << " needs Python" << std::endl;
+        return 1;
+    }
+    if (!instrument.empty() && !Instrumentation::enabled()) {
+        std::cerr << "--instrument needs a build configured with -DPOKEMON_INSTRUMENT=ON" << std::endl;
+        return 1;
+    }
+    if (solve && aiDepth > 0) {
+        std::cerr << "--solve assumes random moves and cannot be combined with --ai" << std::endl;
+        return 1;
+    }
+    
+    // Random generator for demo choices outside of battles
+    std::mt19937_64 demoRng(seed);
+    
+    // Re-execute in the mode the log was recorded in: without Python,
+    // scripts that have no native skill use the built-in formula, table
+    // draws and AI choices consume the random stream differently
+    if (rerun && !replayPath.empty()) {
+        try {
+            ReplayLogReader recorded(replayPath);
+            bool recordedNativeOnly = (recorded.getFlags() & ReplayLogWriter::kNativeOnly) != 0;
+            if (recordedNativeOnly != nativeOnly) {
+                std::cerr << "Replay log was recorded " << (recordedNativeOnly ? "with" : "without")
+                          << " --native-only; re-executing the same way" << std::endl;
+                nativeOnly = recordedNativeOnly;
+            }
+            bool recordedPrecompile = (recorded.getFlags() & ReplayLogWriter::kPrecompiled) != 0;
+            if (recordedPrecompile != precompile) {
+                std::cerr << "Replay log was recorded " << (recordedPrecompile ? "with" : "without")
+                          << " --precompile; re-executing the same way" << std::endl;
+                precompile = recordedPrecompile;
+            }
+            if (recorded.getAiDepth() != aiDepth) {
+                std::cerr << "Replay log was recorded with "
+                          << (recorded.getAiDepth() > 0 ? "--ai " + std::to_string(recorded.getAiDepth()) : "random moves")
+                          << "; re-executing the same way" << std::endl;
+                aiDepth = recorded.getAiDepth();
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Python starts with the first scripted move that needs it (or never)
+    if (nativeOnly) {
+        PythonSkillLoader::setPythonEnabled(false);
+    } else {
+        PythonSkillLoader::initializeOnDemand();
+    }
+    
+    // Wall-clock phases for --timings
+    std::vector<std::pair<std::string, double>> phases;
+    Clock::time_point phaseStart = Clock::now();
+    auto finish = [&](const char* phase, int status) {
+        if (timings) {
+            if (phase != nullptr) phases.emplace_back(phase, secondsSince(phaseStart));
+            printTimings(phases, secondsSince(startTime));
+        }
+        if (instrument == "table") {
+            Instrumentation::report(std::cerr);
+        } else if (instrument == "json") {
+            Instrumentation::writeJson(std::cerr);
+        }
+        PythonSkillLoader::finalize();
+        return status;
+    };
     
     std::cout << "╔════════════════════════════════════════╗" << std::endl;
     std::cout << "║    Pokemon Battle Game - Enhanced!     ║" << std::endl;
@@ -34,81 +697,103 @@ int main() {
     try {
         std::cout << "Creating Pokemon..." << std::endl;
         
-        // Create diverse Pokemon with different types
-        auto pikachu = std::make_shared<Pokemon>("Pikachu", "Electric", 100, 55, 40, 50, 90);
-        auto squirtle = std::make_shared<Pokemon>("Squirtle", "Water", 120, 48, 65, 64, 43);
-        auto bulbasaur = std::make_shared<Pokemon>("Bulbasaur", "Grass", 115, 49, 49, 65, 45);
-        auto charmander = std::make_shared<Pokemon>("Charmander", "Fire", 110, 52, 43, 50, 65);
-        
-        std::cout << "\nLoading moves..." << std::endl;
-        
-        // Create electric moves for Pikachu
-        auto thunderbolt = std::make_shared<Move>("Thunderbolt", "thunderbolt.py", 90, 100, "Electric", MoveCategory::SPECIAL);
-        auto thunderWave = std::make_shared<Move>("Thunder Wave", "thunder_wave.py", 0, 100, "Electric", MoveCategory::STATUS, "Paralyzed", 4);
-        auto quickAttack = std::make_shared<Move>("Quick Attack", "", 40, 100, "Normal", MoveCategory::PHYSICAL);
+        // Species and moves come from the data files (through their binary
+        // cache); move scripts are imported when a move is first used
+        GameData data("data/species.csv", "data/moves.csv", "data/gamedata.cache");
         
-        loadPythonSkill(thunderbolt, "thunderbolt");
-        loadPythonSkill(thunderWave, "thunder_wave");
+        // Diverse Pokemon with different types, side by side in one arena
+        BattleArena roster(4);
+        Pokemon& pikachu = roster.add(data.createPokemon("Pikachu"));
+        Pokemon& squirtle = roster.add(data.createPokemon("Squirtle"));
+        Pokemon& bulbasaur = roster.add(data.createPokemon("Bulbasaur"));
+        Pokemon& charmander = roster.add(data.createPokemon("Charmander"));
         
-        // Create water moves for Squirtle
-        auto waterGun = std::make_shared<Move>("Water Gun", "water_gun.py", 40, 100, "Water", MoveCategory::SPECIAL);
-        auto bubble = std::make_shared<Move>("Bubble", "", 40, 100, "Water", MoveCategory::SPECIAL);
-        auto withdraw = std::make_shared<Move>("Withdraw", "", 0, 100, "Water", MoveCategory::STATUS);
-        
-        loadPythonSkill(waterGun, "water_gun");
-        
-        // Create grass moves for Bulbasaur
-        auto vineWhip = std::make_shared<Move>("Vine Whip", "", 45, 100, "Grass", MoveCategory::PHYSICAL);
-        auto razorLeaf = std::make_shared<Move>("Razor Leaf", "", 55, 95, "Grass", MoveCategory::PHYSICAL);
-        auto toxic = std::make_shared<Move>("Toxic", "toxic.py", 0, 90, "Poison", MoveCategory::STATUS, "Poisoned", 5);
+        std::cout << "\n✓ All Pokemon and moves created successfully!\n" << std::endl;
+        phases.emplace_back(data.isCacheHit() ? "Data load (cached)" : "Data load (parsed)", secondsSince(phaseStart));
+        phaseStart = Clock::now();
         
-        loadPythonSkill(toxic, "toxic");
+        // Let user choose battle matchup (for demo, we'll do multiple battles)
+        std::vector<std::pair<Pokemon*, Pokemon*>> battles = {
+            {&pikachu, &squirtle},   // Electric vs Water - type advantage for Pikachu
+            {&squirtle, &charmander},  // Water vs Fire - type advantage for Squirtle
+            {&charmander, &bulbasaur}  // Fire vs Grass - type advantage for Charmander
+        };
         
-        // Create fire moves for Charmander
-        auto flamethrower = std::make_shared<Move>("Flamethrower", "flamethrower.py", 90, 100, "Fire", MoveCategory::SPECIAL);
-        auto ember = std::make_shared<Move>("Ember", "", 40, 100, "Fire", MoveCategory::SPECIAL);
-        auto scratch = std::make_shared<Move>("Scratch", "", 40, 100, "Normal", MoveCategory::PHYSICAL);
+        // Verification mode: native skills against their Python scripts
+        if (verifyDraws > 0) {
+            return finish("Verification", runNativeVerification(roster.getPokemon(), verifyDraws, seed));
+        }
+        if (verifyTableDraws > 0) {
+            return finish("Verification", runTableVerification(roster.getPokemon(), verifyTableDraws, seed));
+        }
         
-        loadPythonSkill(flamethrower, "flamethrower");
+        // Precompiled damage: PRECOMPILE scripts become table lookups. The
+        // table seed is fixed, so --rerun rebuilds the tables a log drew from
+        if (precompile) {
+            size_t tabulated = DamageTable::precompile(roster.getPokemon());
+            std::cout << "Precompiled damage tables for " << tabulated << " move(s)\n" << std::endl;
+            phases.emplace_back("Precompile", secondsSince(phaseStart));
+            phaseStart = Clock::now();
+        }
         
-        // Assign moves to Pokemon
-        pikachu->addMove(thunderbolt);
-        pikachu->addMove(quickAttack);
-        pikachu->addMove(thunderWave);
+        // Replay mode: stream (and optionally re-execute) a recorded battle
+        if (!replayPath.empty()) {
+            return finish("Replay", runReplay(replayPath, replayBattle, replayTurn, rerun, roster.getPokemon(), aiDepth, aiTime));
+        }
         
-        squirtle->addMove(waterGun);
-        squirtle->addMove(bubble);
-        squirtle->addMove(withdraw);
+        std::unique_ptr<ReplayLogWriter> replayLog;
+        if (!recordPath.empty()) {
+            uint16_t flags = (nativeOnly ? ReplayLogWriter::kNativeOnly : 0) |
+                             (precompile ? ReplayLogWriter::kPrecompiled : 0) | ReplayLogWriter::aiDepthFlags(aiDepth);
+            replayLog.reset(new ReplayLogWriter(recordPath, flags));
+        }
         
-        bulbasaur->addMove(vineWhip);
-        bulbasaur->addMove(razorLeaf);
-        bulbasaur->addMove(toxic);
+        // Exact mode: the Markov chain of every matchup instead of samples
+        if (solve) {
+            return finish("Solve", runSolver(battles));
+        }
         
-        charmander->addMove(flamethrower);
-        charmander->addMove(ember);
-        charmander->addMove(scratch);
+        // Headless mode: batch every matchup instead of playing one battle
+        if (simulateBattles > 0) {
+            runSimulations(battles, simulateBattles, seed, replayLog.get(), aiDepth, aiTime);
+            return finish("Simulation", 0);
+        }
         
-        std::cout << "\n✓ All Pokemon and moves created successfully!\n" << std::endl;
+        // Tournament mode: every Pokemon against every other, in parallel
+        if (tournamentBattles > 0) {
+            runTournament(roster.getPokemon(), tournamentBattles, threads, seed, aiDepth, aiTime);
+            return finish("Tournament", 0);
+        }
         
-        // Let user choose battle matchup (for demo, we'll do multiple battles)
-        std::vector<std::pair<std::shared_ptr<Pokemon>, std::shared_ptr<Pokemon>>> battles = {
-            {pikachu, squirtle},   // Electric vs Water - type advantage for Pikachu
-            {squirtle, charmander},  // Water vs Fire - type advantage for Squirtle
-            {charmander, bulbasaur}  // Fire vs Grass - type advantage for Charmander
-        };
+        // Team mode: the whole roster as a party, with switching
+        if (teamBattles > 0) {
+            runTeamBattles(roster.getPokemon(), teamBattles, seed, aiDepth, aiTime);
+            return finish("Team battles", 0);
+        }
         
         // Pick a random battle
-        int battleChoice = rand() % battles.size();
+        int battleChoice = static_cast<int>(demoRng() % battles.size());
         auto battlePair = battles[battleChoice];
-        auto pokemon1 = battlePair.first;
-        auto pokemon2 = battlePair.second;
+        Pokemon& pokemon1 = *battlePair.first;
+        Pokemon& pokemon2 = *battlePair.second;
         
-        std::cout << "Battle Selection: " << pokemon1->getName() << " vs " << pokemon2->getName() << "!" << std::endl;
-        std::cout << "Type Matchup: " << pokemon1->getType() << " vs " << pokemon2->getType() << std::endl;
+        std::cout << "Battle Selection: " << pokemon1.getName() << " vs " << pokemon2.getName() << "!" << std::endl;
+        std::cout << "Type Matchup: " << pokemon1.getType() << " vs " << pokemon2.getType() << std::endl;
         
-        // Create and start battle
-        Battle battle(pokemon1, pokemon2);
+        // Create and start battle, recording it if requested
+        uint64_t battleSeed = BattleRng::deriveSeed(seed, 0);
+        TextEventSink transcript(std::cout);
+        ReplayRecorder recorder(&transcript);
+        recorder.setSeed(battleSeed);
+        Battle battle(pokemon1, pokemon2, battleSeed, recorder);
+        std::unique_ptr<DecisionPolicy> policy1 = makePolicy(aiDepth, aiTime);
+        std::unique_ptr<DecisionPolicy> policy2 = makePolicy(aiDepth, aiTime);
+        battle.setPolicies(policy1.get(), policy2.get());
         auto winner = battle.start();
+        phases.emplace_back("First battle", secondsSince(phaseStart));
+        if (replayLog) {
+            replayLog->append(recorder.getReplay());
+        }
         
         std::cout << "\n╔════════════════════════════════════════╗" << std::endl;
         std::cout << "║         Battle Summary                 ║" << std::endl;
@@ -124,7 +809,5 @@ int main() {
     }
     
     // Finalize Python interpreter
-    PythonSkillLoader::finalize();
-    
-    return 0;
+    return finish(nullptr, 0);
 }